@@ -339,7 +339,12 @@ def WriteGenericNinja(path, static_libraries, executables,
     return '%s%s' % (library, library_ext)
 
   ninja_lines = []
+  built_sources = set()
   def build_source(src_file, settings):
+    # Sources shared by several executables are only compiled once.
+    if src_file in built_sources:
+      return
+    built_sources.add(src_file)
     ninja_lines.extend([
         'build %s: cxx %s' % (src_to_obj(src_file),
                               escape_path_ninja(
@@ -662,17 +667,21 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/compile_commands_writer.cc',
         'src/gn/rust_project_writer.cc',
         'src/gn/config.cc',
+        'src/gn/config_value_list.cc',
         'src/gn/config_values.cc',
         'src/gn/config_values_extractors.cc',
         'src/gn/config_values_generator.cc',
         'src/gn/copy_target_generator.cc',
         'src/gn/create_bundle_target_generator.cc',
+        'src/gn/dependency_graph.cc',
         'src/gn/deps_iterator.cc',
         'src/gn/desc_builder.cc',
+        'src/gn/dry_run.cc',
         'src/gn/eclipse_writer.cc',
         'src/gn/err.cc',
         'src/gn/escape.cc',
         'src/gn/exec_process.cc',
+        'src/gn/exec_script_cache.cc',
         'src/gn/filesystem_utils.cc',
         'src/gn/file_writer.cc',
         'src/gn/frameworks_utils.cc',
@@ -707,10 +716,14 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/item.cc',
         'src/gn/json_project_writer.cc',
         'src/gn/label.cc',
+        'src/gn/label_id.cc',
         'src/gn/label_pattern.cc',
+        'src/gn/label_pattern_set.cc',
         'src/gn/lib_file.cc',
+        'src/gn/load_timings.cc',
         'src/gn/loader.cc',
         'src/gn/location.cc',
+        'src/gn/memory_stats.cc',
         'src/gn/metadata.cc',
         'src/gn/metadata_walk.cc',
         'src/gn/ninja_action_target_writer.cc',
@@ -720,11 +733,13 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/ninja_c_binary_target_writer.cc',
         'src/gn/ninja_copy_target_writer.cc',
         'src/gn/ninja_create_bundle_target_writer.cc',
+        'src/gn/ninja_flags_cache.cc',
         'src/gn/ninja_generated_file_target_writer.cc',
         'src/gn/ninja_group_target_writer.cc',
         'src/gn/ninja_outputs_writer.cc',
         'src/gn/ninja_rust_binary_target_writer.cc',
         'src/gn/ninja_target_command_util.cc',
+        'src/gn/ninja_target_rules.cc',
         'src/gn/ninja_target_writer.cc',
         'src/gn/ninja_toolchain_writer.cc',
         'src/gn/ninja_tools.cc',
@@ -739,6 +754,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/path_output.cc',
         'src/gn/pattern.cc',
         'src/gn/pool.cc',
+        'src/gn/profiler.cc',
         'src/gn/qt_creator_writer.cc',
         'src/gn/resolved_target_data.cc',
         'src/gn/runtime_deps.cc',
@@ -758,6 +774,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/string_atom.cc',
         'src/gn/string_output_buffer.cc',
         'src/gn/string_utils.cc',
+        'src/gn/substitution_evaluator.cc',
         'src/gn/substitution_list.cc',
         'src/gn/substitution_pattern.cc',
         'src/gn/substitution_type.cc',
@@ -809,9 +826,13 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/commands_unittest.cc',
         'src/gn/compile_commands_writer_unittest.cc',
         'src/gn/config_unittest.cc',
+        'src/gn/config_value_list_unittest.cc',
         'src/gn/config_values_extractors_unittest.cc',
+        'src/gn/dependency_graph_unittest.cc',
+        'src/gn/dry_run_unittest.cc',
         'src/gn/escape_unittest.cc',
         'src/gn/exec_process_unittest.cc',
+        'src/gn/exec_script_cache_unittest.cc',
         'src/gn/filesystem_utils_unittest.cc',
         'src/gn/file_writer_unittest.cc',
         'src/gn/frameworks_utils_unittest.cc',
@@ -837,9 +858,13 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/json_project_writer_unittest.cc',
         'src/gn/rust_project_writer_unittest.cc',
         'src/gn/rust_project_writer_helpers_unittest.cc',
+        'src/gn/label_id_unittest.cc',
         'src/gn/label_pattern_unittest.cc',
+        'src/gn/label_pattern_set_unittest.cc',
         'src/gn/label_unittest.cc',
+        'src/gn/load_timings_unittest.cc',
         'src/gn/loader_unittest.cc',
+        'src/gn/memory_stats_unittest.cc',
         'src/gn/metadata_unittest.cc',
         'src/gn/metadata_walk_unittest.cc',
         'src/gn/ninja_action_target_writer_unittest.cc',
@@ -863,6 +888,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/path_output_unittest.cc',
         'src/gn/pattern_unittest.cc',
         'src/gn/pointer_set_unittest.cc',
+        'src/gn/profiler_unittest.cc',
         'src/gn/resolved_target_data_unittest.cc',
         'src/gn/resolved_target_deps_unittest.cc',
         'src/gn/runtime_deps_unittest.cc',
@@ -874,14 +900,18 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/string_atom_unittest.cc',
         'src/gn/string_output_buffer_unittest.cc',
         'src/gn/string_utils_unittest.cc',
+        'src/gn/substitution_evaluator_unittest.cc',
         'src/gn/substitution_pattern_unittest.cc',
         'src/gn/substitution_writer_unittest.cc',
+        'src/gn/synthetic_build.cc',
+        'src/gn/synthetic_build_unittest.cc',
         'src/gn/target_public_pair_unittest.cc',
         'src/gn/target_unittest.cc',
         'src/gn/template_unittest.cc',
         'src/gn/test_with_scheduler.cc',
         'src/gn/test_with_scope.cc',
         'src/gn/tokenizer_unittest.cc',
+        'src/gn/trace_unittest.cc',
         'src/gn/unique_vector_unittest.cc',
         'src/gn/value_unittest.cc',
         'src/gn/vector_utils_unittest.cc',
@@ -892,8 +922,25 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/xcode_object_unittest.cc',
         'src/gn/xml_element_writer_unittest.cc',
         'src/util/atomic_write_unittest.cc',
+        'src/util/msg_loop_unittest.cc',
         'src/util/test/gn_test.cc',
       ], 'libs': []},
+      'gn_microbenchmarks': { 'sources': [
+        'src/gn/builder_record_map_benchmark.cc',
+        'src/gn/label_benchmark.cc',
+        'src/gn/ninja_flags_cache_benchmark.cc',
+        'src/gn/path_output_benchmark.cc',
+        'src/gn/pattern_benchmark.cc',
+        'src/gn/pointer_set_benchmark.cc',
+        'src/gn/source_file_benchmark.cc',
+        'src/gn/string_atom_benchmark.cc',
+        'src/gn/unique_vector_benchmark.cc',
+        'src/util/test/gn_benchmark.cc',
+      ], 'libs': []},
+      'gn_benchmarks': { 'sources': [
+        'src/gn/gen_benchmark_main.cc',
+        'src/gn/synthetic_build.cc',
+      ], 'libs': []},
   }
 
   if platform.is_posix() or platform.is_zos():
@@ -953,6 +1000,8 @@ def WriteGNNinja(path, platform, host, options, args_list):
   # we just build static libraries that GN needs
   executables['gn']['libs'].extend(static_libraries.keys())
   executables['gn_unittests']['libs'].extend(static_libraries.keys())
+  executables['gn_microbenchmarks']['libs'].extend(static_libraries.keys())
+  executables['gn_benchmarks']['libs'].extend(static_libraries.keys())
 
   WriteGenericNinja(path, static_libraries, executables, cxx, ar, ld,
                     platform, host, options, args_list,
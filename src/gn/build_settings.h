@@ -5,6 +5,8 @@
 #ifndef TOOLS_GN_BUILD_SETTINGS_H_
 #define TOOLS_GN_BUILD_SETTINGS_H_
 
+#include <stddef.h>
+
 #include <functional>
 #include <map>
 #include <memory>
@@ -15,6 +17,7 @@
 #include "gn/args.h"
 #include "gn/label.h"
 #include "gn/label_pattern.h"
+#include "gn/label_pattern_set.h"
 #include "gn/scope.h"
 #include "gn/source_dir.h"
 #include "gn/source_file.h"
@@ -37,7 +40,7 @@ class BuildSettings {
   void SetRootTargetLabel(const Label& r);
 
   // Root target label patterns.
-  const std::vector<LabelPattern>& root_patterns() const {
+  const LabelPatternSet& root_patterns() const {
     return root_patterns_;
   }
   void SetRootPatterns(std::vector<LabelPattern>&& root_patterns);
@@ -77,6 +80,22 @@ class BuildSettings {
     no_stamp_files_ = no_stamp_files;
   }
 
+  // The 'ninja_shared_flags' boolean flag can be set to write the compiler
+  // flags shared by many targets once, as variables of the toolchain's Ninja
+  // file, instead of in each target's Ninja file. See NinjaFlagsCache.
+  bool ninja_shared_flags() const { return ninja_shared_flags_; }
+  void set_ninja_shared_flags(bool ninja_shared_flags) {
+    ninja_shared_flags_ = ninja_shared_flags;
+  }
+
+  // The 'ninja_target_shards' integer can be set to write the rules of the
+  // binary targets of each toolchain to that many shared Ninja files instead
+  // of one file per target. 0 (the default) keeps one file per target.
+  size_t ninja_target_shards() const { return ninja_target_shards_; }
+  void set_ninja_target_shards(size_t ninja_target_shards) {
+    ninja_target_shards_ = ninja_target_shards;
+  }
+
   const SourceFile& build_config_file() const { return build_config_file_; }
   void set_build_config_file(const SourceFile& f) { build_config_file_ = f; }
 
@@ -143,7 +162,7 @@ class BuildSettings {
 
  private:
   Label root_target_label_;
-  std::vector<LabelPattern> root_patterns_;
+  LabelPatternSet root_patterns_;
   base::FilePath dotfile_name_;
   base::FilePath root_path_;
   std::string root_path_utf8_;
@@ -153,6 +172,8 @@ class BuildSettings {
   // See 40045b9 for the reason behind using 1.7.2 as the default version.
   Version ninja_required_version_{1, 7, 2};
   bool no_stamp_files_ = true;
+  bool ninja_shared_flags_ = false;
+  size_t ninja_target_shards_ = 0;
 
   SourceFile build_config_file_;
   SourceFile arg_file_template_path_;
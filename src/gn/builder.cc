@@ -67,7 +67,8 @@ void Builder::ItemDefined(std::unique_ptr<Item> item) {
 
   Err err;
   BuilderRecord* record =
-      GetOrCreateRecordOfType(item->label(), item->defined_from(), type, &err);
+      GetOrCreateRecordOfType(LabelId(item->label()), item->defined_from(),
+                              type, &err);
   if (!record) {
     g_scheduler->FailWithError(err);
     return;
@@ -180,7 +181,7 @@ const BuilderRecord* Builder::GetRecord(const Label& label) const {
 }
 
 BuilderRecord* Builder::GetRecord(const Label& label) {
-  return records_.find(label);
+  return records_.find(LabelId(label));
 }
 
 bool Builder::CheckForBadItems(Err* err) const {
@@ -283,7 +284,7 @@ bool Builder::ConfigDefined(BuilderRecord* record, Err* err) {
   // relevant and means extra book keeping. Just force load any deps of this
   // config.
   for (auto it = record->all_deps().begin(); it.valid(); ++it) {
-    ScheduleItemLoadIfNecessary(*it);
+    ScheduleItemLoadIfNecessary(*it, record);
   }
 
   return true;
@@ -319,11 +320,11 @@ bool Builder::ToolchainDefined(BuilderRecord* record, Err* err) {
 
 BuilderRecord* Builder::GetOrCreateRecordForTesting(const Label& label) {
   Err err;
-  return GetOrCreateRecordOfType(label, nullptr, BuilderRecord::ITEM_UNKNOWN,
-                                 &err);
+  return GetOrCreateRecordOfType(LabelId(label), nullptr,
+                                 BuilderRecord::ITEM_UNKNOWN, &err);
 }
 
-BuilderRecord* Builder::GetOrCreateRecordOfType(const Label& label,
+BuilderRecord* Builder::GetOrCreateRecordOfType(LabelId label,
                                                 const ParseNode* request_from,
                                                 BuilderRecord::ItemType type,
                                                 Err* err) {
@@ -333,7 +334,7 @@ BuilderRecord* Builder::GetOrCreateRecordOfType(const Label& label,
   // Check types, if the record was not just created.
   if (!pair.first && record->type() != type) {
     std::string msg =
-        "The type of " + label.GetUserVisibleName(true) + "\nhere is a " +
+        "The type of " + label->GetUserVisibleName(true) + "\nhere is a " +
         BuilderRecord::GetNameForType(type) + " but was previously seen as a " +
         BuilderRecord::GetNameForType(record->type()) +
         ".\n\n"
@@ -350,14 +351,14 @@ BuilderRecord* Builder::GetOrCreateRecordOfType(const Label& label,
   return record;
 }
 
-BuilderRecord* Builder::GetResolvedRecordOfType(const Label& label,
+BuilderRecord* Builder::GetResolvedRecordOfType(LabelId label,
                                                 const ParseNode* origin,
                                                 BuilderRecord::ItemType type,
                                                 Err* err) {
-  BuilderRecord* record = GetRecord(label);
+  BuilderRecord* record = records_.find(label);
   if (!record) {
     *err = Err(origin, "Item not found",
-               "\"" + label.GetUserVisibleName(true) +
+               "\"" + label->GetUserVisibleName(true) +
                    "\" doesn't\n"
                    "refer to an existent thing.");
     return nullptr;
@@ -367,7 +368,7 @@ BuilderRecord* Builder::GetResolvedRecordOfType(const Label& label,
   if (!item) {
     *err = Err(
         origin, "Item not resolved.",
-        "\"" + label.GetUserVisibleName(true) + "\" hasn't been resolved.\n");
+        "\"" + label->GetUserVisibleName(true) + "\" hasn't been resolved.\n");
     return nullptr;
   }
 
@@ -375,7 +376,7 @@ BuilderRecord* Builder::GetResolvedRecordOfType(const Label& label,
     *err =
         Err(origin,
             std::string("This is not a ") + BuilderRecord::GetNameForType(type),
-            "\"" + label.GetUserVisibleName(true) + "\" refers to a " +
+            "\"" + label->GetUserVisibleName(true) + "\" refers to a " +
                 item->GetItemTypeName() + " instead of a " +
                 BuilderRecord::GetNameForType(type) + ".");
     return nullptr;
@@ -455,7 +456,7 @@ bool Builder::AddToolchainDep(BuilderRecord* record,
                               const Target* target,
                               Err* err) {
   BuilderRecord* toolchain_record = GetOrCreateRecordOfType(
-      target->settings()->toolchain_label(), target->defined_from(),
+      LabelId(target->settings()->toolchain_label()), target->defined_from(),
       BuilderRecord::ITEM_TOOLCHAIN, err);
   if (!toolchain_record)
     return false;
@@ -481,15 +482,19 @@ void Builder::RecursiveSetShouldGenerate(BuilderRecord* record, bool force) {
   for (auto it = record->all_deps().begin(); it.valid(); ++it) {
     BuilderRecord* cur = *it;
     if (!cur->should_generate()) {
-      ScheduleItemLoadIfNecessary(cur);
+      ScheduleItemLoadIfNecessary(cur, record);
       RecursiveSetShouldGenerate(cur, false);
     }
   }
 }
 
-void Builder::ScheduleItemLoadIfNecessary(BuilderRecord* record) {
+void Builder::ScheduleItemLoadIfNecessary(BuilderRecord* record,
+                                          const BuilderRecord* from) {
+  // The dependency may be declared from a template in an imported file, but
+  // the load was caused by running the build file defining |from|.
   const ParseNode* origin = record->originally_referenced_from();
-  loader_->Load(record->label(), origin ? origin->GetRange() : LocationRange());
+  loader_->Load(record->label(), origin ? origin->GetRange() : LocationRange(),
+                loader_->BuildFileForLabel(from->label()));
 }
 
 bool Builder::ResolveItem(BuilderRecord* record, Err* err) {
@@ -517,10 +522,41 @@ bool Builder::ResolveItem(BuilderRecord* record, Err* err) {
       return false;
   }
 
-  record->set_resolved(true);
+  // Configs, toolchains and pools are cheap to resolve, and other items are
+  // often waiting on them, so only targets are worth a trip to the pool.
+  if (resolve_in_parallel_ && record->type() == BuilderRecord::ITEM_TARGET) {
+    ScheduleOnResolved(record);
+    return true;
+  }
 
+  record->set_resolved(true);
   if (!record->item()->OnResolved(err))
     return false;
+  return ItemResolved(record, err);
+}
+
+void Builder::ScheduleOnResolved(BuilderRecord* record) {
+  g_scheduler->ScheduleWork([this, record]() {
+    Err err;
+    if (!record->item()->OnResolved(&err)) {
+      g_scheduler->FailWithError(err);
+      return;
+    }
+
+    // Keep the scheduler from finishing before the main thread has run this.
+    g_scheduler->IncrementWorkCount();
+    g_scheduler->task_runner()->PostTask([this, record]() {
+      record->set_resolved(true);
+      Err err;
+      if (!ItemResolved(record, &err))
+        g_scheduler->FailWithError(err);
+      g_scheduler->DecrementWorkCount();
+    });
+  });
+}
+
+bool Builder::ItemResolved(BuilderRecord* record, Err* err) {
+  DCHECK(record->resolved());
   if (record->should_generate() && resolved_and_generated_callback_)
     resolved_and_generated_callback_(record);
 
@@ -565,7 +601,7 @@ bool Builder::ResolveConfigs(UniqueVector<LabelConfigPair>* configs, Err* err) {
 
 bool Builder::ResolveToolchain(Target* target, Err* err) {
   BuilderRecord* record = GetResolvedRecordOfType(
-      target->settings()->toolchain_label(), target->defined_from(),
+      LabelId(target->settings()->toolchain_label()), target->defined_from(),
       BuilderRecord::ITEM_TOOLCHAIN, err);
   if (!record) {
     *err = Err(
@@ -606,7 +642,7 @@ bool Builder::ResolvePools(Toolchain* toolchain, Err* err) {
     if (!record) {
       *err = Err(tool.second->pool().origin, "Pool for tool not defined.",
                  "I was hoping to find a pool " +
-                     tool.second->pool().label.GetUserVisibleName(false));
+                     tool.second->pool().label->GetUserVisibleName(false));
       return false;
     }
 
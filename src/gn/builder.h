@@ -21,7 +21,8 @@ class Loader;
 class ParseNode;
 
 // The builder assembles the dependency tree. It is not threadsafe and runs on
-// the main thread only. See also BuilderRecord.
+// the main thread only, except for resolving targets when
+// set_resolve_in_parallel() is used. See also BuilderRecord.
 class Builder {
  public:
   using ResolvedGeneratedCallback = std::function<void(const BuilderRecord*)>;
@@ -38,6 +39,14 @@ class Builder {
 
   Loader* loader() const { return loader_; }
 
+  // When set, the Item::OnResolved() of targets, which does most of the work
+  // of resolving them, runs on the scheduler's worker pool. The records are
+  // still only updated on the main thread, once it completes, so the main
+  // message loop must be running for resolution to finish.
+  void set_resolve_in_parallel(bool parallel) {
+    resolve_in_parallel_ = parallel;
+  }
+
   void ItemDefined(std::unique_ptr<Item> item);
 
   // Returns NULL if there is not a thing with the corresponding label.
@@ -74,7 +83,7 @@ class Builder {
   //
   // If any of the conditions fail, the return value will be null and the error
   // will be set. request_from is used as the source of the error.
-  BuilderRecord* GetOrCreateRecordOfType(const Label& label,
+  BuilderRecord* GetOrCreateRecordOfType(LabelId label,
                                          const ParseNode* request_from,
                                          BuilderRecord::ItemType type,
                                          Err* err);
@@ -84,7 +93,7 @@ class Builder {
   //
   // If any of the conditions fail, the return value will be null and the error
   // will be set. request_from is used as the source of the error.
-  BuilderRecord* GetResolvedRecordOfType(const Label& label,
+  BuilderRecord* GetResolvedRecordOfType(LabelId label,
                                          const ParseNode* request_from,
                                          BuilderRecord::ItemType type,
                                          Err* err);
@@ -116,12 +125,23 @@ class Builder {
   // to the item's dependencies.
   void RecursiveSetShouldGenerate(BuilderRecord* record, bool force);
 
-  void ScheduleItemLoadIfNecessary(BuilderRecord* record);
+  // Schedules the load of the file defining |record|, which is a dependency
+  // of |from|.
+  void ScheduleItemLoadIfNecessary(BuilderRecord* record,
+                                   const BuilderRecord* from);
 
   // This takes a BuilderRecord with resolved dependencies, and fills in the
   // target's Label*Vectors with the resolved pointers.
   bool ResolveItem(BuilderRecord* record, Err* err);
 
+  // Runs the OnResolved() of the item of |record| on the worker pool, then
+  // calls ItemResolved() on the main thread.
+  void ScheduleOnResolved(BuilderRecord* record);
+
+  // Called once the item of |record| has been resolved. Marks the record as
+  // resolved and resolves the records that were only waiting on it.
+  bool ItemResolved(BuilderRecord* record, Err* err);
+
   // Fills in the pointers in the given vector based on the labels. We assume
   // that everything should be resolved by this point, so will return an error
   // if anything isn't found or if the type doesn't match.
@@ -144,6 +164,8 @@ class Builder {
 
   ResolvedGeneratedCallback resolved_and_generated_callback_;
 
+  bool resolve_in_parallel_ = false;
+
   Builder(const Builder&) = delete;
   Builder& operator=(const Builder&) = delete;
 };
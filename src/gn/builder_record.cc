@@ -7,7 +7,7 @@
 #include "gn/item.h"
 
 BuilderRecord::BuilderRecord(ItemType type,
-                             const Label& label,
+                             LabelId label,
                              const ParseNode* originally_referenced_from)
     : type_(type),
       label_(label),
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "gn/item.h"
+#include "gn/label_id.h"
 #include "gn/location.h"
 #include "gn/pointer_set.h"
 
@@ -39,11 +40,12 @@ class BuilderRecord {
   };
 
   BuilderRecord(ItemType type,
-                const Label& label,
+                LabelId label,
                 const ParseNode* originally_referenced_from);
 
   ItemType type() const { return type_; }
-  const Label& label() const { return label_; }
+  const Label& label() const { return label_.get(); }
+  LabelId label_id() const { return label_; }
 
   // Returns a user-ready name for the given type. e.g. "target".
   static const char* GetNameForType(ItemType type);
@@ -106,7 +108,7 @@ class BuilderRecord {
   ItemType type_;
   bool should_generate_ = false;
   bool resolved_ = false;
-  Label label_;
+  LabelId label_;
   std::unique_ptr<Item> item_;
   const ParseNode* originally_referenced_from_ = nullptr;
 
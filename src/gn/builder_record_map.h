@@ -23,7 +23,7 @@ struct BuilderRecordNode {
   bool is_null() const { return !record; }
   static constexpr bool is_tombstone() { return false; }
   bool is_valid() const { return !is_null() && !is_tombstone(); }
-  size_t hash_value() const { return record->label().hash(); }
+  size_t hash_value() const { return record->label_id().hash(); }
 };
 
 class BuilderRecordMap : public HashTableBase<BuilderRecordNode> {
@@ -37,14 +37,14 @@ class BuilderRecordMap : public HashTableBase<BuilderRecordNode> {
   }
 
   // Find BuilderRecord matching |label| or return nullptr.
-  BuilderRecord* find(const Label& label) const {
+  BuilderRecord* find(LabelId label) const {
     return Lookup(label)->record;
   }
 
   // Try to find BuilderRecord matching |label|, and create one if
   // none is found. result.first will be true to indicate that a new
   // record was created.
-  std::pair<bool, BuilderRecord*> try_emplace(const Label& label,
+  std::pair<bool, BuilderRecord*> try_emplace(LabelId label,
                                               const ParseNode* request_from,
                                               BuilderRecord::ItemType type) {
     NodeType* node = Lookup(label);
@@ -70,9 +70,9 @@ class BuilderRecordMap : public HashTableBase<BuilderRecordNode> {
   const_iterator end() const { return {NodeEnd()}; }
 
  private:
-  NodeType* Lookup(const Label& label) const {
-    return NodeLookup(label.hash(), [&label](const NodeType* node) {
-      return node->record->label() == label;
+  NodeType* Lookup(LabelId label) const {
+    return NodeLookup(label.hash(), [label](const NodeType* node) {
+      return node->record->label_id() == label;
     });
   }
 };
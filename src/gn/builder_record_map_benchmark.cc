@@ -0,0 +1,89 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "gn/builder_record_map.h"
+#include "gn/label.h"
+#include "gn/label_id.h"
+#include "gn/source_dir.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+// Interned labels of |count| targets spread over directories of ten, in the
+// default toolchain. The builder gets them interned from the dependency pairs.
+std::vector<LabelId> MakeLabels(size_t count) {
+  SourceDir toolchain_dir("//build/toolchain/");
+  std::vector<LabelId> labels;
+  for (size_t i = 0; i < count; i++) {
+    labels.emplace_back(Label(
+        SourceDir("//components/module" + std::to_string(i / 10) + "/"),
+        "target" + std::to_string(i % 10), toolchain_dir, "default"));
+  }
+  return labels;
+}
+
+void RunInsert(benchmark::State& state, size_t count) {
+  std::vector<LabelId> labels = MakeLabels(count);
+  while (state.KeepRunning()) {
+    BuilderRecordMap map;
+    for (LabelId label : labels)
+      map.try_emplace(label, nullptr, BuilderRecord::ITEM_TARGET);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Looks up every record of a map and as many labels which aren't in it. The
+// builder does both while items are defined.
+void RunFind(benchmark::State& state, size_t count) {
+  std::vector<LabelId> labels = MakeLabels(count * 2);
+  BuilderRecordMap map;
+  for (size_t i = 0; i < count; i++)
+    map.try_emplace(labels[i], nullptr, BuilderRecord::ITEM_TARGET);
+  while (state.KeepRunning()) {
+    size_t found = 0;
+    for (LabelId label : labels)
+      found += map.find(label) != nullptr;
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+
+void RunIterate(benchmark::State& state, size_t count) {
+  BuilderRecordMap map;
+  for (LabelId label : MakeLabels(count))
+    map.try_emplace(label, nullptr, BuilderRecord::ITEM_TARGET);
+  while (state.KeepRunning()) {
+    size_t resolved = 0;
+    for (const BuilderRecord& record : map)
+      resolved += record.resolved();
+    benchmark::DoNotOptimize(resolved);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+}  // namespace
+
+BENCHMARK(BuilderRecordMap_Insert_1000) {
+  RunInsert(state, 1000);
+}
+
+BENCHMARK(BuilderRecordMap_Insert_100000) {
+  RunInsert(state, 100000);
+}
+
+BENCHMARK(BuilderRecordMap_Find_1000) {
+  RunFind(state, 1000);
+}
+
+BENCHMARK(BuilderRecordMap_Find_100000) {
+  RunFind(state, 100000);
+}
+
+BENCHMARK(BuilderRecordMap_Iterate_100000) {
+  RunIterate(state, 100000);
+}
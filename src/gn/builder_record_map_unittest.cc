@@ -4,11 +4,12 @@
 #include "gn/builder_record_map.h"
 #include "gn/builder_record.h"
 #include "gn/label.h"
+#include "gn/label_id.h"
 #include "gn/source_dir.h"
 #include "util/test/test.h"
 
 TEST(BuilderRecordMap, Construction) {
-  const Label kLabel1(SourceDir("//src"), "foo");
+  const LabelId kLabel1(Label(SourceDir("//src"), "foo"));
   BuilderRecordMap map;
   EXPECT_TRUE(map.empty());
   EXPECT_EQ(0u, map.size());
@@ -16,9 +17,9 @@ TEST(BuilderRecordMap, Construction) {
 }
 
 TEST(BuilderRecordMap, TryEmplace) {
-  const Label kLabel1(SourceDir("//src"), "foo");
-  const Label kLabel2(SourceDir("//src"), "bar");
-  const Label kLabel3(SourceDir("//third_party/src"), "zoo");
+  const LabelId kLabel1(Label(SourceDir("//src"), "foo"));
+  const LabelId kLabel2(Label(SourceDir("//src"), "bar"));
+  const LabelId kLabel3(Label(SourceDir("//third_party/src"), "zoo"));
 
   BuilderRecordMap map;
 
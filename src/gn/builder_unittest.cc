@@ -22,7 +22,8 @@ class MockLoader : public Loader {
   // Loader implementation:
   void Load(const SourceFile& file,
             const LocationRange& origin,
-            const Label& toolchain_name) override {
+            const Label& toolchain_name,
+            const SourceFile& parent) override {
     files_.push_back(file);
   }
   void ToolchainLoaded(const Toolchain* toolchain) override {}
@@ -369,4 +370,62 @@ TEST_F(BuilderTest, ConfigLoad) {
   EXPECT_TRUE(loader_->HasLoadedOne(SourceFile("//b/BUILD.gn")));
 }
 
+// Tests that targets resolved on the worker pool are marked resolved on the
+// main thread, in dependency order.
+TEST_F(BuilderTest, ResolveInParallel) {
+  SourceDir toolchain_dir = settings_.toolchain_label().dir();
+  std::string toolchain_name = settings_.toolchain_label().name();
+
+  Label a_label(SourceDir("//a/"), "a", toolchain_dir, toolchain_name);
+  Label b_label(SourceDir("//b/"), "b", toolchain_dir, toolchain_name);
+  Label c_label(SourceDir("//c/"), "c", toolchain_dir, toolchain_name);
+
+  std::vector<Label> resolved;
+  builder_.set_resolve_in_parallel(true);
+  builder_.set_resolved_and_generated_callback(
+      [&resolved](const BuilderRecord* record) {
+        if (record->type() == BuilderRecord::ITEM_TARGET)
+          resolved.push_back(record->label());
+      });
+
+  // Keep the scheduler running until everything below is done.
+  scheduler().IncrementWorkCount();
+
+  // A -> B -> C, all defined before the toolchain so they all wait on it.
+  Target* a = new Target(&settings_, a_label);
+  a->public_deps().push_back(LabelTargetPair(b_label));
+  a->set_output_type(Target::EXECUTABLE);
+  builder_.ItemDefined(std::unique_ptr<Item>(a));
+
+  Target* b = new Target(&settings_, b_label);
+  b->public_deps().push_back(LabelTargetPair(c_label));
+  b->set_output_type(Target::STATIC_LIBRARY);
+  b->visibility().SetPublic();
+  builder_.ItemDefined(std::unique_ptr<Item>(b));
+
+  Target* c = new Target(&settings_, c_label);
+  c->set_output_type(Target::STATIC_LIBRARY);
+  c->visibility().SetPublic();
+  builder_.ItemDefined(std::unique_ptr<Item>(c));
+
+  DefineToolchain();
+
+  // Nothing is resolved until the main thread handles the results.
+  EXPECT_FALSE(builder_.GetRecord(c_label)->resolved());
+
+  scheduler().DecrementWorkCount();
+  EXPECT_TRUE(scheduler().Run());
+
+  EXPECT_TRUE(builder_.GetRecord(a_label)->resolved());
+  EXPECT_TRUE(builder_.GetRecord(b_label)->resolved());
+  EXPECT_TRUE(builder_.GetRecord(c_label)->resolved());
+  ASSERT_EQ(3u, resolved.size());
+  EXPECT_EQ(c_label, resolved[0]);
+  EXPECT_EQ(b_label, resolved[1]);
+  EXPECT_EQ(a_label, resolved[2]);
+
+  Err err;
+  EXPECT_TRUE(builder_.CheckForBadItems(&err));
+}
+
 }  // namespace gn_builder_unittest
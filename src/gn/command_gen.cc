@@ -4,10 +4,6 @@
 
 #include <inttypes.h>
 
-#include <mutex>
-#include <thread>
-#include <unordered_map>
-
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
@@ -15,14 +11,15 @@
 #include "gn/build_settings.h"
 #include "gn/commands.h"
 #include "gn/compile_commands_writer.h"
+#include "gn/dry_run.h"
 #include "gn/eclipse_writer.h"
 #include "gn/filesystem_utils.h"
 #include "gn/json_project_writer.h"
 #include "gn/label_pattern.h"
+#include "gn/memory_stats.h"
 #include "gn/ninja_outputs_writer.h"
-#include "gn/ninja_target_writer.h"
+#include "gn/ninja_target_rules.h"
 #include "gn/ninja_tools.h"
-#include "gn/ninja_writer.h"
 #include "gn/qt_creator_writer.h"
 #include "gn/runtime_deps.h"
 #include "gn/rust_project_writer.h"
@@ -76,61 +73,14 @@ const char kSwitchJsonIdeScriptArgs[] = "json-ide-script-args";
 const char kSwitchExportCompileCommands[] = "export-compile-commands";
 const char kSwitchExportRustProject[] = "export-rust-project";
 
-// A map type used to implement --ide=ninja_outputs
-using NinjaOutputsMap = NinjaOutputsWriter::MapType;
-
-// Collects Ninja rules for each toolchain. The lock protects the rules
-struct TargetWriteInfo {
-  // Set this to true to populate |ninja_outputs_map| below.
-  bool want_ninja_outputs = false;
-
-  std::mutex lock;
-  NinjaWriter::PerToolchainRules rules;
-
-  NinjaOutputsMap ninja_outputs_map;
-
-  using ResolvedMap = std::unordered_map<std::thread::id, ResolvedTargetData>;
-  std::unique_ptr<ResolvedMap> resolved_map = std::make_unique<ResolvedMap>();
-
-  void LeakOnPurpose() { (void)resolved_map.release(); }
-};
-
-// Called on worker thread to write the ninja file.
-void BackgroundDoWrite(TargetWriteInfo* write_info, const Target* target) {
-  ResolvedTargetData* resolved;
-  std::vector<OutputFile> target_ninja_outputs;
-  std::vector<OutputFile>* ninja_outputs =
-      write_info->want_ninja_outputs ? &target_ninja_outputs : nullptr;
-
-  {
-    std::lock_guard<std::mutex> lock(write_info->lock);
-    resolved = &((*write_info->resolved_map)[std::this_thread::get_id()]);
-  }
-  std::string rule =
-      NinjaTargetWriter::RunAndWriteFile(target, resolved, ninja_outputs);
-
-  DCHECK(!rule.empty());
-
-  {
-    std::lock_guard<std::mutex> lock(write_info->lock);
-    write_info->rules[target->toolchain()].emplace_back(target,
-                                                        std::move(rule));
-
-    if (write_info->want_ninja_outputs) {
-      write_info->ninja_outputs_map.emplace(target,
-                                            std::move(target_ninja_outputs));
-    }
-  }
-}
-
 // Called on the main thread.
-void ItemResolvedAndGeneratedCallback(TargetWriteInfo* write_info,
+void ItemResolvedAndGeneratedCallback(NinjaTargetRules* target_rules,
                                       const BuilderRecord* record) {
   const Item* item = record->item();
   const Target* target = item->AsTarget();
   if (target) {
     g_scheduler->ScheduleWork(
-        [write_info, target]() { BackgroundDoWrite(write_info, target); });
+        [target_rules, target]() { target_rules->WriteTarget(target); });
   }
 }
 
@@ -524,6 +474,18 @@ General options
       option requires a ninja executable of at least version 1.10.0. It can be
       provided by the --ninja-executable switch. Also see "gn help clean_stale".
 
+  --dry-run
+      Do everything except writing files: the build files are loaded and all
+      the requested ninja, IDE and compile_commands files are generated in
+      memory, but nothing is written to the output directory and no ninja tools
+      or output scripts are run. Prints how many files were generated, how many
+      of them would have changed, and their total size. This is mostly useful
+      for measuring the performance of GN itself. Files written by write_file()
+      are counted like the others. Scripts run by exec_script() still run, in
+      the build directory, and may write files; since a dry run doesn't create
+      the build directory, it fails if they need to run and no previous gen
+      created it.
+
 IDE options
 
   GN optionally generates files for IDE. Files won't be overwritten if their
@@ -737,17 +699,22 @@ int RunGen(const std::vector<std::string>& args) {
     return 1;
   }
 
+  const base::CommandLine* command_line =
+      base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch(kDryRunSwitch))
+    EnableDryRun();
+
   // Deliberately leaked to avoid expensive process teardown.
   Setup* setup = new Setup();
   // Generate an empty args.gn file if it does not exists
-  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(switches::kArgs)) {
+  if (!command_line->HasSwitch(switches::kArgs)) {
     setup->set_gen_empty_args(true);
   }
   if (!setup->DoSetup(args[0], true))
     return 1;
+  RecordMemoryPhase("setup", setup->scheduler().input_file_manager(),
+                    &setup->builder());
 
-  const base::CommandLine* command_line =
-      base::CommandLine::ForCurrentProcess();
   if (command_line->HasSwitch(kSwitchCheck)) {
     setup->set_check_public_headers(true);
     if (command_line->GetSwitchValueString(kSwitchCheck) == "system")
@@ -758,50 +725,52 @@ int RunGen(const std::vector<std::string>& args) {
   // with just enough for ninja to call GN and regenerate ninja files. This
   // removes any potential soon-to-be-dangling references and ensures that
   // regeneration can be restarted if interrupted.
-  if (command_line->HasSwitch(switches::kRegeneration)) {
+  if (command_line->HasSwitch(switches::kRegeneration) && !DryRunEnabled()) {
     if (!commands::PrepareForRegeneration(&setup->build_settings())) {
       return 1;
     }
   }
 
   // Cause the load to also generate the ninja files for each target.
-  TargetWriteInfo write_info;
-  write_info.want_ninja_outputs =
-      command_line->HasSwitch(kSwitchNinjaOutputsFile);
+  NinjaTargetRules target_rules(
+      command_line->HasSwitch(kSwitchNinjaOutputsFile));
 
   setup->builder().set_resolved_and_generated_callback(
-      [&write_info](const BuilderRecord* record) {
-        ItemResolvedAndGeneratedCallback(&write_info, record);
+      [&target_rules](const BuilderRecord* record) {
+        ItemResolvedAndGeneratedCallback(&target_rules, record);
       });
 
   // Do the actual load. This will also write out the target ninja files.
   if (!setup->Run())
     return 1;
+  RecordMemoryPhase("load", setup->scheduler().input_file_manager(),
+                    &setup->builder());
 
   if (command_line->HasSwitch(switches::kVerbose))
     OutputString("Build graph constructed in " +
                  base::Int64ToString(timer.Elapsed().InMilliseconds()) +
                  "ms\n");
 
-  // Sort the targets in each toolchain according to their label. This makes
-  // the ninja files have deterministic content.
-  for (auto& cur_toolchain : write_info.rules) {
-    std::sort(cur_toolchain.second.begin(), cur_toolchain.second.end(),
-              [](const NinjaWriter::TargetRulePair& a,
-                 const NinjaWriter::TargetRulePair& b) {
-                return a.first->label() < b.first->label();
-              });
+  // Save how long each build file took to load so the next run can schedule
+  // the slowest chains first. This is only an optimization, so failing to
+  // write the file isn't an error.
+  if (!DryRunEnabled()) {
+    const BuildSettings& build_settings = setup->build_settings();
+    setup->scheduler().load_timings()->Write(
+        build_settings.GetFullPath(SourceFile(
+            build_settings.build_dir().value() + LoadTimings::kFileName)));
   }
 
   Err err;
   // Write the root ninja files.
-  if (!NinjaWriter::RunAndWriteFiles(&setup->build_settings(), setup->builder(),
-                                     write_info.rules, &err)) {
+  if (!target_rules.WriteRootFiles(&setup->build_settings(), setup->builder(),
+                                   &err)) {
     err.PrintToStdout();
     return 1;
   }
 
-  if (!RunNinjaPostProcessTools(
+  if (!DryRunEnabled() &&
+      !RunNinjaPostProcessTools(
           &setup->build_settings(),
           command_line->GetSwitchValuePath(switches::kNinjaExecutable),
           command_line->HasSwitch(switches::kRegeneration),
@@ -810,7 +779,7 @@ int RunGen(const std::vector<std::string>& args) {
     return 1;
   }
 
-  if (write_info.want_ninja_outputs) {
+  if (target_rules.want_ninja_outputs()) {
     ElapsedTimer outputs_timer;
     std::string file_name =
         command_line->GetSwitchValueString(kSwitchNinjaOutputsFile);
@@ -829,7 +798,7 @@ int RunGen(const std::vector<std::string>& args) {
         command_line->GetSwitchValueString(kSwitchNinjaOutputsScriptArgs);
 
     bool res = NinjaOutputsWriter::RunAndWriteFiles(
-        write_info.ninja_outputs_map, &setup->build_settings(), file_name,
+        target_rules.ninja_outputs_map(), &setup->build_settings(), file_name,
         exec_script, exec_script_extra_args, quiet, &err);
     if (!res) {
       err.PrintToStdout();
@@ -870,16 +839,15 @@ int RunGen(const std::vector<std::string>& args) {
   }
 
   TickDelta elapsed_time = timer.Elapsed();
+  RecordMemoryPhase("write", setup->scheduler().input_file_manager(),
+                    &setup->builder());
 
   if (!command_line->HasSwitch(switches::kQuiet)) {
     OutputString("Done. ", DECORATION_GREEN);
 
-    size_t targets_collected = 0;
-    for (const auto& rules : write_info.rules)
-      targets_collected += rules.second.size();
-
     std::string stats =
-        "Made " + base::NumberToString(targets_collected) + " targets from " +
+        "Made " + base::NumberToString(target_rules.GetTargetCount()) +
+        " targets from " +
         base::IntToString(
             setup->scheduler().input_file_manager()->GetInputFileCount()) +
         " files in " + base::Int64ToString(elapsed_time.InMilliseconds()) +
@@ -887,9 +855,14 @@ int RunGen(const std::vector<std::string>& args) {
     OutputString(stats);
   }
 
+  if (DryRunEnabled())
+    OutputString(SummarizeDryRun());
+  if (command_line->HasSwitch(switches::kMemstats))
+    OutputString(SummarizeMemoryStats());
+
   // Just like the build graph, leak the resolved data to avoid expensive
   // process teardown here too.
-  write_info.LeakOnPurpose();
+  target_rules.LeakOnPurpose();
 
   return 0;
 }
@@ -9,6 +9,7 @@
 #include "base/command_line.h"
 #include "base/strings/stringprintf.h"
 #include "gn/commands.h"
+#include "gn/dependency_graph.h"
 #include "gn/setup.h"
 #include "gn/standard_out.h"
 
@@ -18,13 +19,14 @@ namespace {
 
 enum class DepType { NONE, PUBLIC, PRIVATE, DATA };
 
-// The dependency paths are stored in a vector. Assuming the chain:
+// The dependency paths are stored in a vector of nodes of the dependency
+// graph. Assuming the chain:
 //    A --[public]--> B --[private]--> C
 // The stack will look like:
 //    [0] = A, NONE (this has no dep type since nobody depends on it)
 //    [1] = B, PUBLIC
 //    [2] = C, PRIVATE
-using TargetDep = std::pair<const Target*, DepType>;
+using TargetDep = std::pair<DependencyGraph::Node, DepType>;
 using PathVector = std::vector<TargetDep>;
 
 // How to search.
@@ -44,16 +46,19 @@ struct Options {
 using WorkQueue = std::list<PathVector>;
 
 struct Stats {
-  Stats() : public_paths(0), other_paths(0) {}
+  explicit Stats(const DependencyGraph& graph)
+      : public_paths(0),
+        other_paths(0),
+        found_paths(graph.size(), DepType::NONE) {}
 
   int total_paths() const { return public_paths + other_paths; }
 
   int public_paths;
   int other_paths;
 
-  // Stores targets that have a path to the destination, and whether that
-  // path is public, private, or data.
-  std::map<const Target*, DepType> found_paths;
+  // Stores, for each node of the graph, whether it has a public, private, or
+  // data path to the destination, or NONE if it isn't known to have one.
+  std::vector<DepType> found_paths;
 };
 
 // If the implicit_last_dep is not "none", this type indicates the
@@ -96,15 +101,20 @@ const char* StringForDepType(DepType type) {
 
 // Prints the given path. If the implicit_last_dep is not "none", the last
 // dependency will show an elided dependency with the given annotation.
-void PrintPath(const PathVector& path, DepType implicit_last_dep) {
+void PrintPath(const DependencyGraph& graph,
+               const PathVector& path,
+               DepType implicit_last_dep) {
   if (path.empty())
     return;
 
   // Don't print toolchains unless they differ from the first target.
-  const Label& default_toolchain = path[0].first->label().GetToolchainLabel();
+  const Label& default_toolchain =
+      graph.target(path[0].first)->label().GetToolchainLabel();
 
   for (size_t i = 0; i < path.size(); i++) {
-    OutputString(path[i].first->label().GetUserVisibleName(default_toolchain));
+    OutputString(graph.target(path[i].first)
+                     ->label()
+                     .GetUserVisibleName(default_toolchain));
 
     // Output dependency type.
     if (i == path.size() - 1) {
@@ -151,8 +161,8 @@ void InsertTargetsIntoFoundPaths(const PathVector& path,
     // Don't overwrite an existing one. The algorithm works by first doing
     // public, then private, then data, so anything already there is guaranteed
     // at least as good as our addition.
-    if (stats->found_paths.find(pair.first) == stats->found_paths.end()) {
-      stats->found_paths.insert(std::make_pair(pair.first, type));
+    if (stats->found_paths[pair.first] == DepType::NONE) {
+      stats->found_paths[pair.first] = type;
       inserted = true;
     }
   }
@@ -166,8 +176,9 @@ void InsertTargetsIntoFoundPaths(const PathVector& path,
   }
 }
 
-void BreadthFirstSearch(const Target* from,
-                        const Target* to,
+void BreadthFirstSearch(const DependencyGraph& graph,
+                        DependencyGraph::Node from,
+                        DependencyGraph::Node to,
                         PrivateDeps private_deps,
                         DataDeps data_deps,
                         PrintWhat print_what,
@@ -179,18 +190,18 @@ void BreadthFirstSearch(const Target* from,
   work_queue.push_back(initial_stack);
 
   // Track checked targets to avoid checking the same once more than once.
-  TargetSet visited;
+  std::vector<bool> visited(graph.size());
 
   while (!work_queue.empty()) {
     PathVector current_path = work_queue.front();
     work_queue.pop_front();
 
-    const Target* current_target = current_path.back().first;
+    DependencyGraph::Node current_target = current_path.back().first;
 
     if (current_target == to) {
       // Found a new path.
       if (stats->total_paths() == 0 || print_what == PrintWhat::ALL)
-        PrintPath(current_path, DepType::NONE);
+        PrintPath(graph, current_path, DepType::NONE);
 
       // Insert all nodes on the path into the found paths list. Since we're
       // doing search breadth first, we know that the current path is the best
@@ -203,16 +214,14 @@ void BreadthFirstSearch(const Target* from,
       // Doing this here will mean that the output is sorted by length of items
       // printed (with the redundant parts of the path omitted) rather than
       // complete path length.
-      const auto& found_current_target =
-          stats->found_paths.find(current_target);
-      if (found_current_target != stats->found_paths.end()) {
+      DepType found_current_target = stats->found_paths[current_target];
+      if (found_current_target != DepType::NONE) {
         if (stats->total_paths() == 0 || print_what == PrintWhat::ALL)
-          PrintPath(current_path, found_current_target->second);
+          PrintPath(graph, current_path, found_current_target);
 
         // Insert all nodes on the path into the found paths list since we know
         // everything along this path also leads to the destination.
-        InsertTargetsIntoFoundPaths(current_path, found_current_target->second,
-                                    stats);
+        InsertTargetsIntoFoundPaths(current_path, found_current_target, stats);
         continue;
       }
     }
@@ -220,47 +229,51 @@ void BreadthFirstSearch(const Target* from,
     // If we've already checked this one, stop. This should be after the above
     // check for a known-good check, because known-good ones will always have
     // been previously visited.
-    if (!visited.add(current_target))
+    if (visited[current_target])
       continue;
+    visited[current_target] = true;
 
     // Add public deps for this target to the queue.
-    for (const auto& pair : current_target->public_deps()) {
+    for (DependencyGraph::Node dep : graph.public_deps(current_target)) {
       work_queue.push_back(current_path);
-      work_queue.back().push_back(TargetDep(pair.ptr, DepType::PUBLIC));
+      work_queue.back().push_back(TargetDep(dep, DepType::PUBLIC));
     }
 
     if (private_deps == PrivateDeps::INCLUDE) {
       // Add private deps.
-      for (const auto& pair : current_target->private_deps()) {
+      for (DependencyGraph::Node dep : graph.private_deps(current_target)) {
         work_queue.push_back(current_path);
-        work_queue.back().push_back(TargetDep(pair.ptr, DepType::PRIVATE));
+        work_queue.back().push_back(TargetDep(dep, DepType::PRIVATE));
       }
     }
 
     if (data_deps == DataDeps::INCLUDE) {
       // Add data deps.
-      for (const auto& pair : current_target->data_deps()) {
+      for (DependencyGraph::Node dep : graph.data_deps(current_target)) {
         work_queue.push_back(current_path);
-        work_queue.back().push_back(TargetDep(pair.ptr, DepType::DATA));
+        work_queue.back().push_back(TargetDep(dep, DepType::DATA));
       }
     }
   }
 }
 
-void DoSearch(const Target* from,
+void DoSearch(const DependencyGraph& graph,
+              const Target* from,
               const Target* to,
               const Options& options,
               Stats* stats) {
-  BreadthFirstSearch(from, to, PrivateDeps::EXCLUDE, DataDeps::EXCLUDE,
-                     options.print_what, stats);
+  DependencyGraph::Node from_node = graph.GetNode(from);
+  DependencyGraph::Node to_node = graph.GetNode(to);
+  BreadthFirstSearch(graph, from_node, to_node, PrivateDeps::EXCLUDE,
+                     DataDeps::EXCLUDE, options.print_what, stats);
   if (!options.public_only) {
     // Check private deps.
-    BreadthFirstSearch(from, to, PrivateDeps::INCLUDE, DataDeps::EXCLUDE,
-                       options.print_what, stats);
+    BreadthFirstSearch(graph, from_node, to_node, PrivateDeps::INCLUDE,
+                       DataDeps::EXCLUDE, options.print_what, stats);
     if (options.with_data) {
       // Check data deps.
-      BreadthFirstSearch(from, to, PrivateDeps::INCLUDE, DataDeps::INCLUDE,
-                         options.print_what, stats);
+      BreadthFirstSearch(graph, from_node, to_node, PrivateDeps::INCLUDE,
+                         DataDeps::INCLUDE, options.print_what, stats);
     }
   }
 }
@@ -347,13 +360,15 @@ int RunPath(const std::vector<std::string>& args) {
     return 1;
   }
 
-  Stats stats;
-  DoSearch(target1, target2, options, &stats);
+  // Both targets are in the graph since they're given.
+  DependencyGraph graph({target1, target2});
+  Stats stats(graph);
+  DoSearch(graph, target1, target2, options, &stats);
   if (stats.total_paths() == 0) {
     // If we don't find a path going "forwards", try the reverse direction.
     // Deps can only go in one direction without having a cycle, which will
     // have caused a run failure above.
-    DoSearch(target2, target1, options, &stats);
+    DoSearch(graph, target2, target1, options, &stats);
   }
 
   // This string is inserted in the results to annotate whether the result
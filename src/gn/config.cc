@@ -45,6 +45,7 @@ bool Config::OnResolved(Err* err) {
     composite_values_ = own_values_;
     for (const auto& pair : configs_)
       composite_values_.AppendValues(pair.ptr->resolved_values());
+    composite_values_.Intern();
   }
   return true;
 }
@@ -0,0 +1,141 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/config_value_list.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "gn/source_dir.h"
+
+namespace {
+
+template <typename T>
+size_t HashList(const std::vector<T>& list) {
+  size_t hash = list.size();
+  for (const T& value : list)
+    hash = hash * 31 + std::hash<T>()(value);
+  return hash;
+}
+
+size_t ValueBytes(const std::string& value) {
+  // Strings short enough for the inline buffer don't allocate, and an empty
+  // string has the capacity of that buffer.
+  static const size_t inline_capacity = std::string().capacity();
+  return value.capacity() > inline_capacity ? value.capacity() + 1 : 0;
+}
+
+size_t ValueBytes(const SourceDir&) {
+  return 0;  // The string is a StringAtom, counted with those.
+}
+
+// The interned lists of one type. Lists are interned from the threads
+// running build files, so the table is split into independently locked
+// shards to keep them from contending.
+template <typename T>
+class ListTable {
+ public:
+  const std::vector<T>* Intern(std::vector<T>&& list) {
+    size_t hash = HashList(list);
+    Shard& shard = shards_[hash % kNumShards];
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto found = shard.lists.find(&list);
+    if (found != shard.lists.end())
+      return *found;
+
+    // Owned by the table until the program exits.
+    const std::vector<T>* interned = new std::vector<T>(std::move(list));
+    shard.lists.insert(interned);
+    return interned;
+  }
+
+  void GetStats(size_t* count, size_t* bytes) {
+    *count = 0;
+    *bytes = 0;
+    for (Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      *count += shard.lists.size();
+      for (const std::vector<T>* list : shard.lists) {
+        *bytes += sizeof(*list) + list->capacity() * sizeof(T);
+        for (const T& value : *list)
+          *bytes += ValueBytes(value);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct ListHash {
+    size_t operator()(const std::vector<T>* list) const {
+      return HashList(*list);
+    }
+  };
+  struct ListEqual {
+    bool operator()(const std::vector<T>* a, const std::vector<T>* b) const {
+      return *a == *b;
+    }
+  };
+
+  struct Shard {
+    std::mutex lock;
+    std::unordered_set<const std::vector<T>*, ListHash, ListEqual> lists;
+  };
+  Shard shards_[kNumShards];
+};
+
+template <typename T>
+ListTable<T>& GetListTable() {
+  // Leaked, so lists stay valid during static destruction.
+  static ListTable<T>* table = new ListTable<T>;
+  return *table;
+}
+
+}  // namespace
+
+template <typename T>
+ConfigValueList<T>::ConfigValueList(const ConfigValueList& other)
+    : interned_(other.interned_) {
+  if (other.own_)
+    own_ = std::make_unique<std::vector<T>>(*other.own_);
+}
+
+template <typename T>
+ConfigValueList<T>& ConfigValueList<T>::operator=(
+    const ConfigValueList& other) {
+  if (this != &other) {
+    interned_ = other.interned_;
+    own_.reset();
+    if (other.own_)
+      own_ = std::make_unique<std::vector<T>>(*other.own_);
+  }
+  return *this;
+}
+
+template <typename T>
+void ConfigValueList<T>::Intern() {
+  if (interned_ || !own_ || own_->empty())
+    return;
+  interned_ = GetListTable<T>().Intern(std::move(*own_));
+  own_.reset();
+}
+
+// static
+template <typename T>
+const std::vector<T>& ConfigValueList<T>::GetEmpty() {
+  static const std::vector<T> empty;
+  return empty;
+}
+
+// static
+template <typename T>
+void ConfigValueList<T>::GetTableStats(size_t* count, size_t* bytes) {
+  GetListTable<T>().GetStats(count, bytes);
+}
+
+template class ConfigValueList<std::string>;
+template class ConfigValueList<SourceDir>;
@@ -0,0 +1,72 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_CONFIG_VALUE_LIST_H_
+#define TOOLS_GN_CONFIG_VALUE_LIST_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+// A list of values (flags, defines, directories...) of a ConfigValues.
+//
+// The same lists, coming from the configs set up by the build config, end up
+// in a large number of configs and targets. Once a list is complete, Intern()
+// replaces it with a pointer to an immutable copy shared by every equal
+// interned list, so each distinct list is only stored once, and equal interned
+// lists can be recognized by the address of get().
+//
+// A list can still be modified after being interned: GetMutable() turns it
+// back into a list of its own. The interned copies live until the program
+// exits, like StringAtom strings.
+//
+// Instantiated for std::string and SourceDir only.
+template <typename T>
+class ConfigValueList {
+ public:
+  ConfigValueList() = default;
+  ConfigValueList(const ConfigValueList& other);
+  ConfigValueList(ConfigValueList&&) = default;
+  ~ConfigValueList() = default;
+
+  ConfigValueList& operator=(const ConfigValueList& other);
+  ConfigValueList& operator=(ConfigValueList&&) = default;
+
+  const std::vector<T>& get() const {
+    if (interned_)
+      return *interned_;
+    return own_ ? *own_ : GetEmpty();
+  }
+
+  std::vector<T>& GetMutable() {
+    if (interned_) {
+      own_ = std::make_unique<std::vector<T>>(*interned_);
+      interned_ = nullptr;
+    } else if (!own_) {
+      own_ = std::make_unique<std::vector<T>>();
+    }
+    return *own_;
+  }
+
+  // Shares this list with all equal interned lists. Empty lists aren't worth
+  // sharing so are left alone. Thread-safe for different lists.
+  void Intern();
+
+  bool is_interned() const { return interned_ != nullptr; }
+
+  // Returns the number of interned lists and an estimate of the bytes they
+  // use, for memory stats.
+  static void GetTableStats(size_t* count, size_t* bytes);
+
+ private:
+  static const std::vector<T>& GetEmpty();
+
+  // Most lists of most targets are empty or interned, so the vector of a
+  // list of its own is only allocated when it's modified.
+  const std::vector<T>* interned_ = nullptr;
+  std::unique_ptr<std::vector<T>> own_;  // Only used when not interned.
+};
+
+#endif  // TOOLS_GN_CONFIG_VALUE_LIST_H_
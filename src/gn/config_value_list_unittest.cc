@@ -0,0 +1,60 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "gn/config_value_list.h"
+#include "gn/config_values.h"
+#include "util/test/test.h"
+
+TEST(ConfigValueList, Intern) {
+  ConfigValueList<std::string> a;
+  a.GetMutable() = {"-Wall", "-O2"};
+  ConfigValueList<std::string> b;
+  b.GetMutable() = {"-Wall", "-O2"};
+  ConfigValueList<std::string> c;
+  c.GetMutable() = {"-Wall"};
+
+  a.Intern();
+  b.Intern();
+  c.Intern();
+  EXPECT_TRUE(a.is_interned());
+  EXPECT_EQ(&a.get(), &b.get());
+  EXPECT_NE(&a.get(), &c.get());
+  EXPECT_EQ(2u, a.get().size());
+
+  // Modifying an interned list must not affect the lists it's shared with.
+  b.GetMutable().push_back("-g");
+  EXPECT_FALSE(b.is_interned());
+  EXPECT_EQ(3u, b.get().size());
+  EXPECT_EQ(2u, a.get().size());
+
+  // Empty lists aren't interned.
+  ConfigValueList<std::string> empty;
+  empty.Intern();
+  EXPECT_FALSE(empty.is_interned());
+}
+
+TEST(ConfigValueList, ConfigValues) {
+  ConfigValues first;
+  first.cflags().push_back("-fno-exceptions");
+  first.include_dirs().push_back(SourceDir("//include/"));
+  first.Intern();
+
+  ConfigValues second;
+  second.cflags().push_back("-fno-exceptions");
+  second.include_dirs().push_back(SourceDir("//include/"));
+  second.Intern();
+
+  const ConfigValues& const_first = first;
+  const ConfigValues& const_second = second;
+  EXPECT_EQ(&const_first.cflags(), &const_second.cflags());
+  EXPECT_EQ(&const_first.include_dirs(), &const_second.include_dirs());
+
+  // Appending to an empty list shares the appended list.
+  ConfigValues combined;
+  combined.AppendValues(first);
+  const ConfigValues& const_combined = combined;
+  EXPECT_EQ(&const_first.cflags(), &const_combined.cflags());
+}
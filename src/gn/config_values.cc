@@ -14,6 +14,19 @@ void VectorAppend(std::vector<T>* append_to,
   append_to->insert(append_to->end(), append_this.begin(), append_this.end());
 }
 
+template <typename T>
+void VectorAppend(ConfigValueList<T>* append_to,
+                  const ConfigValueList<T>& append_this) {
+  if (append_this.get().empty())
+    return;
+  // An empty list can share the appended one instead of copying it.
+  if (append_to->get().empty()) {
+    *append_to = append_this;
+    return;
+  }
+  VectorAppend(&append_to->GetMutable(), append_this.get());
+}
+
 }  // namespace
 
 ConfigValues::ConfigValues() = default;
@@ -21,6 +34,7 @@ ConfigValues::ConfigValues() = default;
 ConfigValues::~ConfigValues() = default;
 
 void ConfigValues::AppendValues(const ConfigValues& append) {
+  interned_ = false;
   VectorAppend(&asmflags_, append.asmflags_);
   VectorAppend(&arflags_, append.arflags_);
   VectorAppend(&cflags_, append.cflags_);
@@ -50,3 +64,24 @@ void ConfigValues::AppendValues(const ConfigValues& append) {
   if (!append.precompiled_source_.is_null() && !precompiled_source_.is_null())
     precompiled_source_ = append.precompiled_source_;
 }
+
+void ConfigValues::Intern() {
+  asmflags_.Intern();
+  arflags_.Intern();
+  cflags_.Intern();
+  cflags_c_.Intern();
+  cflags_cc_.Intern();
+  cflags_objc_.Intern();
+  cflags_objcc_.Intern();
+  defines_.Intern();
+  frameworks_.Intern();
+  weak_frameworks_.Intern();
+  framework_dirs_.Intern();
+  include_dirs_.Intern();
+  ldflags_.Intern();
+  lib_dirs_.Intern();
+  rustflags_.Intern();
+  rustenv_.Intern();
+  swiftflags_.Intern();
+  interned_ = true;
+}
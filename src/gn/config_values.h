@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "gn/config_value_list.h"
 #include "gn/lib_file.h"
 #include "gn/source_dir.h"
 #include "gn/source_file.h"
@@ -22,16 +23,30 @@ class ConfigValues {
   // Appends the values from the given config to this one.
   void AppendValues(const ConfigValues& append);
 
-#define STRING_VALUES_ACCESSOR(name)                               \
-  const std::vector<std::string>& name() const { return name##_; } \
-  std::vector<std::string>& name() { return name##_; }
-#define DIR_VALUES_ACCESSOR(name)                                \
-  const std::vector<SourceDir>& name() const { return name##_; } \
-  std::vector<SourceDir>& name() { return name##_; }
+  // Interns the string and directory lists, see ConfigValueList. Call once
+  // the values are complete.
+  void Intern();
+
+  // Returns true if all non-empty lists are interned: Intern() was called and
+  // no list was modified since.
+  bool is_interned() const { return interned_; }
+
+#define STRING_VALUES_ACCESSOR(name)                                     \
+  const std::vector<std::string>& name() const { return name##_.get(); } \
+  std::vector<std::string>& name() {                                     \
+    interned_ = false;                                                   \
+    return name##_.GetMutable();                                         \
+  }
+#define DIR_VALUES_ACCESSOR(name)                                      \
+  const std::vector<SourceDir>& name() const { return name##_.get(); } \
+  std::vector<SourceDir>& name() {                                     \
+    interned_ = false;                                                 \
+    return name##_.GetMutable();                                       \
+  }
 
   // =================================================================
-  // IMPORTANT: If you add a new one, be sure to update AppendValues()
-  //            and command_desc.cc.
+  // IMPORTANT: If you add a new one, be sure to update AppendValues(),
+  //            Intern() and command_desc.cc.
   // =================================================================
   STRING_VALUES_ACCESSOR(arflags)
   STRING_VALUES_ACCESSOR(asmflags)
@@ -51,8 +66,8 @@ class ConfigValues {
   STRING_VALUES_ACCESSOR(rustenv)
   STRING_VALUES_ACCESSOR(swiftflags)
   // =================================================================
-  // IMPORTANT: If you add a new one, be sure to update AppendValues()
-  //            and command_desc.cc.
+  // IMPORTANT: If you add a new one, be sure to update AppendValues(),
+  //            Intern() and command_desc.cc.
   // =================================================================
 
 #undef STRING_VALUES_ACCESSOR
@@ -78,30 +93,32 @@ class ConfigValues {
   void set_precompiled_source(const SourceFile& f) { precompiled_source_ = f; }
 
  private:
-  std::vector<std::string> arflags_;
-  std::vector<std::string> asmflags_;
-  std::vector<std::string> cflags_;
-  std::vector<std::string> cflags_c_;
-  std::vector<std::string> cflags_cc_;
-  std::vector<std::string> cflags_objc_;
-  std::vector<std::string> cflags_objcc_;
-  std::vector<std::string> defines_;
-  std::vector<SourceDir> include_dirs_;
-  std::vector<SourceDir> framework_dirs_;
-  std::vector<std::string> frameworks_;
-  std::vector<std::string> weak_frameworks_;
+  ConfigValueList<std::string> arflags_;
+  ConfigValueList<std::string> asmflags_;
+  ConfigValueList<std::string> cflags_;
+  ConfigValueList<std::string> cflags_c_;
+  ConfigValueList<std::string> cflags_cc_;
+  ConfigValueList<std::string> cflags_objc_;
+  ConfigValueList<std::string> cflags_objcc_;
+  ConfigValueList<std::string> defines_;
+  ConfigValueList<SourceDir> include_dirs_;
+  ConfigValueList<SourceDir> framework_dirs_;
+  ConfigValueList<std::string> frameworks_;
+  ConfigValueList<std::string> weak_frameworks_;
   std::vector<SourceFile> inputs_;
-  std::vector<std::string> ldflags_;
-  std::vector<SourceDir> lib_dirs_;
+  ConfigValueList<std::string> ldflags_;
+  ConfigValueList<SourceDir> lib_dirs_;
   std::vector<LibFile> libs_;
-  std::vector<std::string> rustflags_;
-  std::vector<std::string> rustenv_;
-  std::vector<std::string> swiftflags_;
+  ConfigValueList<std::string> rustflags_;
+  ConfigValueList<std::string> rustenv_;
+  ConfigValueList<std::string> swiftflags_;
   std::vector<std::pair<std::string, LibFile>> externs_;
-  // If you add a new one, be sure to update AppendValues().
+  // If you add a new one, be sure to update AppendValues() and Intern().
 
   std::string precompiled_header_;
   SourceFile precompiled_source_;
+
+  bool interned_ = false;
 };
 
 #endif  // TOOLS_GN_CONFIG_VALUES_H_
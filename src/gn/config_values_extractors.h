@@ -8,6 +8,7 @@
 #include <stddef.h>
 
 #include <ostream>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -89,8 +90,15 @@ inline void RecursiveTargetConfigToStream(
     const Writer& writer,
     std::ostream& out) {
   std::set<T> seen;
+  std::set<const std::vector<T>*> seen_lists;
   for (ConfigValuesIterator iter(target); !iter.done(); iter.Next()) {
     const std::vector<T>& values = ((iter.cur()).*getter)();
+    if (config == kRecursiveWriterSkipDuplicates && !values.empty()) {
+      // Interned lists are shared by all equal lists, so a list seen before
+      // can only contain duplicates.
+      if (!seen_lists.insert(&values).second)
+        continue;
+    }
     for (size_t i = 0; i < values.size(); i++) {
       switch (config) {
         case kRecursiveWriterKeepDuplicates:
@@ -167,4 +167,7 @@ void ConfigValuesGenerator::Run() {
     if (err_->has_error())
       return;
   }
+
+  // Identical lists are common, so share them.
+  config_values_->Intern();
 }
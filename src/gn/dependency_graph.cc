@@ -0,0 +1,50 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/dependency_graph.h"
+
+#include "base/logging.h"
+#include "gn/target.h"
+
+DependencyGraph::DependencyGraph(const std::vector<const Target*>& targets) {
+  targets_.reserve(targets.size());
+  nodes_.reserve(targets.size());
+  for (const Target* target : targets)
+    AddNode(target);
+
+  // AddNode() appends the deps that weren't given, so this also visits them.
+  edge_offsets_.reserve(targets_.size() * EDGE_KIND_COUNT + 1);
+  for (size_t i = 0; i < targets_.size(); i++) {
+    const Target* target = targets_[i];
+    for (const LabelTargetVector* deps :
+         {&target->public_deps(), &target->private_deps(),
+          &target->data_deps()}) {
+      edge_offsets_.push_back(static_cast<uint32_t>(edges_.size()));
+      for (const auto& pair : *deps) {
+        DCHECK(pair.ptr) << "Unresolved dependency.";
+        edges_.push_back(AddNode(pair.ptr));
+      }
+    }
+  }
+  edge_offsets_.push_back(static_cast<uint32_t>(edges_.size()));
+}
+
+DependencyGraph::~DependencyGraph() = default;
+
+DependencyGraph::Node DependencyGraph::GetNode(const Target* target) const {
+  auto found = nodes_.find(target);
+  if (found == nodes_.end())
+    return kNoNode;
+  return found->second;
+}
+
+DependencyGraph::Node DependencyGraph::AddNode(const Target* target) {
+  auto [it, inserted] =
+      nodes_.try_emplace(target, static_cast<Node>(targets_.size()));
+  if (inserted) {
+    CHECK(targets_.size() < kNoNode) << "Too many targets.";
+    targets_.push_back(target);
+  }
+  return it->second;
+}
@@ -0,0 +1,109 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_DEPENDENCY_GRAPH_H_
+#define TOOLS_GN_DEPENDENCY_GRAPH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "base/containers/span.h"
+
+class Target;
+
+// A frozen, compact copy of the dependency graph of resolved targets, for the
+// passes that walk the graph once everything is resolved.
+//
+// Walking the LabelTargetVectors of the targets means loading each Target
+// (hundreds of bytes, spread over the heap) and skipping over the labels of
+// the pairs to get to the pointers. Here each target instead gets a dense
+// index, a Node, and the dependencies of all the targets are stored in one
+// array of nodes: the public, private and data deps of a node are adjacent
+// and are found with an offsets array (the "compressed sparse row" layout).
+// Since the nodes are dense, per-target state of a traversal can live in a
+// vector indexed by node, like a std::vector<bool> of visited nodes, instead
+// of a set of pointers.
+//
+// The nodes are numbered in the order the targets are given, then the
+// dependencies that weren't given are added in the order they're found, so
+// the graph is closed over dependencies and its order is deterministic.
+//
+// The targets must be resolved and their deps must not change while the
+// graph is in use. Thread-safe once built.
+class DependencyGraph {
+ public:
+  using Node = uint32_t;
+
+  // Returned by GetNode() for targets that aren't in the graph.
+  static constexpr Node kNoNode = std::numeric_limits<Node>::max();
+
+  // Builds the graph of the given targets and their transitive dependencies.
+  explicit DependencyGraph(const std::vector<const Target*>& targets);
+  ~DependencyGraph();
+
+  size_t size() const { return targets_.size(); }
+
+  const Target* target(Node node) const { return targets_[node]; }
+  Node GetNode(const Target* target) const;
+
+  base::span<const Node> public_deps(Node node) const {
+    return GetEdges(node, EDGE_PUBLIC, EDGE_PRIVATE);
+  }
+  base::span<const Node> private_deps(Node node) const {
+    return GetEdges(node, EDGE_PRIVATE, EDGE_DATA);
+  }
+  base::span<const Node> data_deps(Node node) const {
+    return GetEdges(node, EDGE_DATA, EDGE_KIND_COUNT);
+  }
+
+  // Public and private deps, like Target::DEPS_LINKED.
+  base::span<const Node> linked_deps(Node node) const {
+    return GetEdges(node, EDGE_PUBLIC, EDGE_DATA);
+  }
+
+  // All deps, like Target::DEPS_ALL.
+  base::span<const Node> all_deps(Node node) const {
+    return GetEdges(node, EDGE_PUBLIC, EDGE_KIND_COUNT);
+  }
+
+ private:
+  enum EdgeKind {
+    EDGE_PUBLIC,
+    EDGE_PRIVATE,
+    EDGE_DATA,
+
+    EDGE_KIND_COUNT,
+  };
+
+  // Returns the node of the target, adding it to the graph if needed.
+  Node AddNode(const Target* target);
+
+  // Returns the edges of the node from the first of the |begin| kind to the
+  // last of the kind before |end|.
+  base::span<const Node> GetEdges(Node node,
+                                  EdgeKind begin,
+                                  EdgeKind end) const {
+    // The edges of the next kind (or node) begin where these end.
+    uint32_t first = edge_offsets_[node * EDGE_KIND_COUNT + begin];
+    uint32_t last = edge_offsets_[node * EDGE_KIND_COUNT + end];
+    return base::span<const Node>(edges_.data() + first, last - first);
+  }
+
+  std::vector<const Target*> targets_;
+  std::unordered_map<const Target*, Node> nodes_;
+
+  // For each node, the offsets in edges_ of its edges of each kind, followed
+  // by a final offset for the end of the last node.
+  std::vector<uint32_t> edge_offsets_;
+  std::vector<Node> edges_;
+
+  DependencyGraph(const DependencyGraph&) = delete;
+  DependencyGraph& operator=(const DependencyGraph&) = delete;
+};
+
+#endif  // TOOLS_GN_DEPENDENCY_GRAPH_H_
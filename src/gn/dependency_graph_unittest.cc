@@ -0,0 +1,81 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/dependency_graph.h"
+
+#include <vector>
+
+#include "gn/target.h"
+#include "gn/test_with_scope.h"
+#include "util/test/test.h"
+
+namespace {
+
+std::vector<const Target*> TargetsOf(
+    const DependencyGraph& graph,
+    base::span<const DependencyGraph::Node> nodes) {
+  std::vector<const Target*> result;
+  for (DependencyGraph::Node node : nodes)
+    result.push_back(graph.target(node));
+  return result;
+}
+
+}  // namespace
+
+TEST(DependencyGraph, Edges) {
+  TestWithScope setup;
+
+  // a -> (public) b, (private) c, (data) d
+  // b -> (public) c
+  TestTarget a(setup, "//foo:a", Target::SOURCE_SET);
+  TestTarget b(setup, "//foo:b", Target::SOURCE_SET);
+  TestTarget c(setup, "//foo:c", Target::SOURCE_SET);
+  TestTarget d(setup, "//foo:d", Target::SOURCE_SET);
+  a.public_deps().push_back(LabelTargetPair(&b));
+  a.private_deps().push_back(LabelTargetPair(&c));
+  a.data_deps().push_back(LabelTargetPair(&d));
+  b.public_deps().push_back(LabelTargetPair(&c));
+
+  // Only a is given, the others are added as they are found.
+  DependencyGraph graph({&a});
+  ASSERT_EQ(4u, graph.size());
+  EXPECT_EQ(0u, graph.GetNode(&a));
+  EXPECT_EQ(&a, graph.target(0));
+  EXPECT_EQ(&b, graph.target(1));
+  EXPECT_EQ(&c, graph.target(2));
+  EXPECT_EQ(&d, graph.target(3));
+
+  using Targets = std::vector<const Target*>;
+  DependencyGraph::Node node_a = graph.GetNode(&a);
+  EXPECT_EQ(Targets({&b}), TargetsOf(graph, graph.public_deps(node_a)));
+  EXPECT_EQ(Targets({&c}), TargetsOf(graph, graph.private_deps(node_a)));
+  EXPECT_EQ(Targets({&d}), TargetsOf(graph, graph.data_deps(node_a)));
+  EXPECT_EQ(Targets({&b, &c}), TargetsOf(graph, graph.linked_deps(node_a)));
+  EXPECT_EQ(Targets({&b, &c, &d}), TargetsOf(graph, graph.all_deps(node_a)));
+
+  DependencyGraph::Node node_b = graph.GetNode(&b);
+  EXPECT_EQ(Targets({&c}), TargetsOf(graph, graph.public_deps(node_b)));
+  EXPECT_TRUE(graph.private_deps(node_b).empty());
+  EXPECT_TRUE(graph.data_deps(node_b).empty());
+  EXPECT_TRUE(graph.all_deps(graph.GetNode(&d)).empty());
+
+  TestTarget unrelated(setup, "//foo:unrelated", Target::SOURCE_SET);
+  EXPECT_EQ(DependencyGraph::kNoNode, graph.GetNode(&unrelated));
+}
+
+// The given targets come first, in order, even if they depend on each other.
+TEST(DependencyGraph, Order) {
+  TestWithScope setup;
+
+  TestTarget a(setup, "//foo:a", Target::SOURCE_SET);
+  TestTarget b(setup, "//foo:b", Target::SOURCE_SET);
+  a.public_deps().push_back(LabelTargetPair(&b));
+
+  DependencyGraph graph({&b, &a, &b});
+  ASSERT_EQ(2u, graph.size());
+  EXPECT_EQ(&b, graph.target(0));
+  EXPECT_EQ(&a, graph.target(1));
+  ASSERT_EQ(1u, graph.public_deps(1).size());
+  EXPECT_EQ(0u, graph.public_deps(1)[0]);
+}
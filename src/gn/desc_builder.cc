@@ -205,7 +205,7 @@ class BaseDescBuilder {
                           int indent = 0) {
     for (const auto& config : configs) {
       std::string name(indent * 2, ' ');
-      name.append(config.label.GetUserVisibleName(GetToolchainLabel()));
+      name.append(config.label->GetUserVisibleName(GetToolchainLabel()));
       out->AppendString(name);
       if (tree_)
         FillInConfigVector(out, config.ptr->configs(), indent + 1);
@@ -724,7 +724,7 @@ class TargetDescBuilder : public BaseDescBuilder {
     Label default_tc = target_->settings()->default_toolchain_label();
     std::vector<std::string> gen_deps;
     for (const auto& pair : target_->gen_deps())
-      gen_deps.push_back(pair.label.GetUserVisibleName(default_tc));
+      gen_deps.push_back(pair.label->GetUserVisibleName(default_tc));
     std::sort(gen_deps.begin(), gen_deps.end());
     for (const auto& dep : gen_deps)
       res->AppendString(dep);
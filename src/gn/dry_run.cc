@@ -0,0 +1,71 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/dry_run.h"
+
+#include <atomic>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/stringprintf.h"
+
+namespace {
+
+bool dry_run_enabled = false;
+
+std::atomic<int64_t> dry_run_files{0};
+std::atomic<int64_t> dry_run_changed_files{0};
+std::atomic<int64_t> dry_run_bytes{0};
+
+}  // namespace
+
+const char kDryRunSwitch[] = "dry-run";
+
+void EnableDryRun() {
+  dry_run_enabled = true;
+}
+
+bool DryRunEnabled() {
+  return dry_run_enabled;
+}
+
+void RecordDryRunWrite(size_t size, bool changed) {
+  dry_run_files.fetch_add(1, std::memory_order_relaxed);
+  if (changed)
+    dry_run_changed_files.fetch_add(1, std::memory_order_relaxed);
+  dry_run_bytes.fetch_add(static_cast<int64_t>(size),
+                          std::memory_order_relaxed);
+}
+
+void RecordDryRunWrite(const base::FilePath& file_path,
+                       std::string_view contents) {
+  std::string existing;
+  bool changed =
+      !base::ReadFileToString(file_path, &existing) || existing != contents;
+  RecordDryRunWrite(contents.size(), changed);
+}
+
+DryRunStats GetDryRunStats() {
+  DryRunStats stats;
+  stats.files = dry_run_files.load(std::memory_order_relaxed);
+  stats.changed_files = dry_run_changed_files.load(std::memory_order_relaxed);
+  stats.bytes = dry_run_bytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+std::string SummarizeDryRun() {
+  DryRunStats stats = GetDryRunStats();
+  return base::StringPrintf(
+      "Dry run: generated %lld files (%lld would change), %.2f MB\n",
+      static_cast<long long>(stats.files),
+      static_cast<long long>(stats.changed_files),
+      stats.bytes / (1024.0 * 1024.0));
+}
+
+void ResetDryRunForTesting() {
+  dry_run_enabled = false;
+  dry_run_files = 0;
+  dry_run_changed_files = 0;
+  dry_run_bytes = 0;
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_DRY_RUN_H_
+#define TOOLS_GN_DRY_RUN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+// Dry runs for "gn gen --dry-run".
+//
+// In a dry run, generated files are rendered in memory as usual but never
+// written to disk. Code that writes generated files checks DryRunEnabled()
+// and calls RecordDryRunWrite() instead, so the amount of output can be
+// reported at the end.
+
+// The "gn gen" switch that turns dry runs on.
+extern const char kDryRunSwitch[];
+
+// Call to turn dry runs on, before setup.
+void EnableDryRun();
+
+// Returns whether this is a dry run.
+bool DryRunEnabled();
+
+// Records that a file of |size| bytes was generated, and whether writing it
+// would have changed the file on disk. Thread-safe.
+void RecordDryRunWrite(size_t size, bool changed);
+
+// Records that |contents| were generated for |file_path|, comparing them
+// with the current contents of the file.
+void RecordDryRunWrite(const base::FilePath& file_path,
+                       std::string_view contents);
+
+struct DryRunStats {
+  int64_t files = 0;
+  int64_t changed_files = 0;
+  int64_t bytes = 0;
+};
+
+DryRunStats GetDryRunStats();
+
+// Returns a one-line summary of the recorded writes.
+std::string SummarizeDryRun();
+
+// Turns dry runs off and clears the recorded writes.
+void ResetDryRunForTesting();
+
+#endif  // TOOLS_GN_DRY_RUN_H_
@@ -0,0 +1,45 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/dry_run.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "gn/string_output_buffer.h"
+#include "util/test/test.h"
+
+TEST(DryRun, RecordsWritesWithoutTouchingDisk) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+
+  const std::string kContents = "build foo: stamp\n";
+  base::FilePath existing_path = temp_dir.GetPath().AppendASCII("existing");
+  ASSERT_EQ(static_cast<int>(kContents.size()),
+            base::WriteFile(existing_path, kContents.data(),
+                            static_cast<int>(kContents.size())));
+  base::FilePath new_path =
+      temp_dir.GetPath().AppendASCII("dir").AppendASCII("new");
+
+  ResetDryRunForTesting();
+  EnableDryRun();
+  EXPECT_TRUE(DryRunEnabled());
+
+  StringOutputBuffer buffer;
+  buffer.Append(kContents);
+  EXPECT_TRUE(buffer.WriteToFileIfChanged(existing_path, nullptr));
+  EXPECT_TRUE(buffer.WriteToFileIfChanged(new_path, nullptr));
+  RecordDryRunWrite(existing_path, "changed");
+
+  DryRunStats stats = GetDryRunStats();
+  ResetDryRunForTesting();
+
+  EXPECT_FALSE(base::PathExists(new_path.DirName()));
+  EXPECT_EQ(3, stats.files);
+  EXPECT_EQ(2, stats.changed_files);
+  EXPECT_EQ(static_cast<int64_t>(kContents.size() * 2 + 7), stats.bytes);
+  EXPECT_FALSE(DryRunEnabled());
+}
@@ -6,10 +6,12 @@
 
 #include <fstream>
 #include <memory>
+#include <sstream>
 
 #include "base/files/file_path.h"
 #include "gn/builder.h"
 #include "gn/config_values_extractors.h"
+#include "gn/dry_run.h"
 #include "gn/filesystem_utils.h"
 #include "gn/loader.h"
 #include "gn/xml_element_writer.h"
@@ -55,6 +57,14 @@ bool EclipseWriter::RunAndWriteFile(const BuildSettings* build_settings,
                                     Err* err) {
   base::FilePath file = build_settings->GetFullPath(build_settings->build_dir())
                             .AppendASCII("eclipse-cdt-settings.xml");
+  if (DryRunEnabled()) {
+    std::stringstream file_out;
+    EclipseWriter gen(build_settings, builder, file_out);
+    gen.Run();
+    RecordDryRunWrite(file, file_out.str());
+    return true;
+  }
+
   std::ofstream file_out;
   file_out.open(FilePathToUTF8(file).c_str(),
                 std::ios_base::out | std::ios_base::binary);
@@ -0,0 +1,110 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/exec_script_cache.h"
+
+#include <algorithm>
+
+#include "base/command_line.h"
+#include "base/strings/string_number_conversions.h"
+#include "gn/exec_process.h"
+#include "gn/filesystem_utils.h"
+#include "gn/switches.h"
+#include "util/sys_info.h"
+
+namespace {
+
+int GetDefaultMaxJobs() {
+  std::string jobs =
+      base::CommandLine::ForCurrentProcess()->GetSwitchValueString(
+          switches::kScriptJobs);
+
+  int result;
+  if (!jobs.empty() && base::StringToInt(jobs, &result) && result >= 1)
+    return result;
+
+  // Scripts are typically single-threaded, so one per core keeps the machine
+  // busy without oversubscribing it.
+  return std::max(NumberOfProcessors(), 1);
+}
+
+std::string MakeKey(const base::CommandLine& cmdline,
+                    const base::FilePath& startup_dir) {
+  return FilePathToUTF8(startup_dir) + '\n' +
+         FilePathToUTF8(cmdline.GetCommandLineString());
+}
+
+}  // namespace
+
+ExecScriptCache::ExecScriptCache(int max_jobs)
+    : max_jobs_(max_jobs > 0 ? max_jobs : GetDefaultMaxJobs()) {}
+
+ExecScriptCache::~ExecScriptCache() = default;
+
+ExecScriptCache::Result ExecScriptCache::Exec(
+    const base::CommandLine& cmdline,
+    const base::FilePath& startup_dir,
+    bool* reused) {
+  std::string key = MakeKey(cmdline, startup_dir);
+
+  Entry* entry = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    auto found = entries_.find(key);
+    if (found != entries_.end()) {
+      // Another thread has run or is running the same invocation.
+      entry = found->second.get();
+      cv_.wait(lock, [entry]() { return entry->done; });
+      *reused = true;
+      return entry->result;
+    }
+    auto new_entry = std::make_unique<Entry>();
+    entry = new_entry.get();
+    entries_[key] = std::move(new_entry);
+  }
+
+  // Entries are never removed, so the pointer stays valid outside the lock.
+  Result result;
+  RunProcess(cmdline, startup_dir, &result);
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    entry->result = result;
+    entry->done = true;
+  }
+  cv_.notify_all();
+
+  *reused = false;
+  return result;
+}
+
+int ExecScriptCache::exec_count() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return exec_count_;
+}
+
+void ExecScriptCache::RunProcess(const base::CommandLine& cmdline,
+                                 const base::FilePath& startup_dir,
+                                 Result* result) {
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    cv_.wait(lock, [this]() { return running_jobs_ < max_jobs_; });
+    running_jobs_++;
+    exec_count_++;
+  }
+
+  if (exec_callback_) {
+    result->launched = exec_callback_(cmdline, startup_dir, result);
+  } else {
+    result->launched =
+        internal::ExecProcess(cmdline, startup_dir, &result->std_out,
+                              &result->std_err, &result->exit_code);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    running_jobs_--;
+  }
+  cv_.notify_all();
+}
@@ -0,0 +1,103 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_EXEC_SCRIPT_CACHE_H_
+#define TOOLS_GN_EXEC_SCRIPT_CACHE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "base/files/file_path.h"
+
+namespace base {
+class CommandLine;
+}
+
+// Runs the child processes for exec_script() calls.
+//
+// The same .gni file is commonly evaluated once per toolchain, so identical
+// exec_script() invocations (same command line and working directory) are
+// frequently issued from several worker threads at once. The first caller
+// runs the process; other callers for the same invocation block until that
+// result is available and then share it. Completed results are kept for the
+// rest of the run so later identical invocations don't run the script again.
+//
+// Independently of deduplication, the number of child processes running at
+// the same time is bounded so that script-heavy builds don't oversubscribe the
+// machine (see "gn help --script-jobs").
+//
+// This class is threadsafe.
+class ExecScriptCache {
+ public:
+  struct Result {
+    // False if the process could not be started at all.
+    bool launched = false;
+    int exit_code = 0;
+    std::string std_out;
+    std::string std_err;
+  };
+
+  // Callback to emulate process execution in tests.
+  using ExecCallback = std::function<bool(const base::CommandLine& cmdline,
+                                          const base::FilePath& startup_dir,
+                                          Result* result)>;
+
+  // A |max_jobs| value of 0 means to use the default, which can be overridden
+  // by the --script-jobs command-line switch.
+  explicit ExecScriptCache(int max_jobs = 0);
+  ~ExecScriptCache();
+
+  // Runs the given command line in the given directory, or waits for and
+  // returns the result of an identical invocation. |*reused| is set to true
+  // if the result came from another invocation.
+  Result Exec(const base::CommandLine& cmdline,
+              const base::FilePath& startup_dir,
+              bool* reused);
+
+  // Number of child processes actually started. For testing.
+  int exec_count() const;
+
+  int max_jobs() const { return max_jobs_; }
+
+  void set_exec_callback(ExecCallback callback) {
+    exec_callback_ = std::move(callback);
+  }
+
+ private:
+  struct Entry {
+    bool done = false;
+    Result result;
+  };
+
+  // Runs the process, waiting for a free job slot first.
+  void RunProcess(const base::CommandLine& cmdline,
+                  const base::FilePath& startup_dir,
+                  Result* result);
+
+  const int max_jobs_;
+
+  mutable std::mutex lock_;
+
+  // Signaled when an entry completes or a job slot becomes free.
+  std::condition_variable cv_;
+
+  int running_jobs_ = 0;
+  int exec_count_ = 0;
+
+  // Maps the invocation key (working directory and command line) to its
+  // pending or completed result.
+  std::unordered_map<std::string, std::unique_ptr<Entry>> entries_;
+
+  // Used by unit tests to mock out process execution.
+  ExecCallback exec_callback_;
+
+  ExecScriptCache(const ExecScriptCache&) = delete;
+  ExecScriptCache& operator=(const ExecScriptCache&) = delete;
+};
+
+#endif  // TOOLS_GN_EXEC_SCRIPT_CACHE_H_
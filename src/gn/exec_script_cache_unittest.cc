@@ -0,0 +1,115 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/exec_script_cache.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "base/command_line.h"
+#include "util/test/test.h"
+
+namespace {
+
+base::CommandLine MakeCommandLine(const std::string& arg) {
+  base::CommandLine cmdline(base::CommandLine::NO_PROGRAM);
+  cmdline.SetParseSwitches(false);
+  cmdline.SetProgram(base::FilePath(FILE_PATH_LITERAL("script.py")));
+  cmdline.AppendArg(arg);
+  return cmdline;
+}
+
+}  // namespace
+
+TEST(ExecScriptCache, ReusesIdenticalInvocations) {
+  ExecScriptCache cache(4);
+  cache.set_exec_callback([](const base::CommandLine& cmdline,
+                             const base::FilePath& startup_dir,
+                             ExecScriptCache::Result* result) {
+    result->std_out = "out " + cmdline.GetArgs()[0];
+    return true;
+  });
+
+  base::FilePath dir(FILE_PATH_LITERAL("out"));
+  bool reused = true;
+  ExecScriptCache::Result result = cache.Exec(MakeCommandLine("a"), dir,
+                                              &reused);
+  EXPECT_TRUE(result.launched);
+  EXPECT_FALSE(reused);
+  EXPECT_EQ("out a", result.std_out);
+
+  result = cache.Exec(MakeCommandLine("a"), dir, &reused);
+  EXPECT_TRUE(reused);
+  EXPECT_EQ("out a", result.std_out);
+  EXPECT_EQ(1, cache.exec_count());
+
+  // Different arguments or working directory run again.
+  result = cache.Exec(MakeCommandLine("b"), dir, &reused);
+  EXPECT_FALSE(reused);
+  EXPECT_EQ("out b", result.std_out);
+  cache.Exec(MakeCommandLine("a"), base::FilePath(FILE_PATH_LITERAL("other")),
+             &reused);
+  EXPECT_FALSE(reused);
+  EXPECT_EQ(3, cache.exec_count());
+}
+
+TEST(ExecScriptCache, ConcurrentCallersShareResult) {
+  ExecScriptCache cache(4);
+  std::atomic<int> calls(0);
+  cache.set_exec_callback([&calls](const base::CommandLine& cmdline,
+                                   const base::FilePath& startup_dir,
+                                   ExecScriptCache::Result* result) {
+    calls++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    result->exit_code = 3;
+    return true;
+  });
+
+  base::FilePath dir(FILE_PATH_LITERAL("out"));
+  std::vector<std::thread> threads;
+  std::atomic<int> exit_code_sum(0);
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&]() {
+      bool reused;
+      exit_code_sum += cache.Exec(MakeCommandLine("x"), dir, &reused).exit_code;
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(1, calls.load());
+  EXPECT_EQ(24, exit_code_sum.load());
+}
+
+TEST(ExecScriptCache, LimitsConcurrentJobs) {
+  ExecScriptCache cache(2);
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+  cache.set_exec_callback([&](const base::CommandLine& cmdline,
+                              const base::FilePath& startup_dir,
+                              ExecScriptCache::Result* result) {
+    int now = ++running;
+    int prev = max_running.load();
+    while (now > prev && !max_running.compare_exchange_weak(prev, now)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    running--;
+    return true;
+  });
+
+  base::FilePath dir(FILE_PATH_LITERAL("out"));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&cache, &dir, i]() {
+      bool reused;
+      cache.Exec(MakeCommandLine(std::to_string(i)), dir, &reused);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(8, cache.exec_count());
+  EXPECT_LE(max_running.load(), 2);
+}
@@ -7,8 +7,9 @@
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "gn/dry_run.h"
 #include "gn/err.h"
-#include "gn/exec_process.h"
+#include "gn/exec_script_cache.h"
 #include "gn/filesystem_utils.h"
 #include "gn/functions.h"
 #include "gn/input_conversion.h"
@@ -79,6 +80,12 @@ const char kExecScript_Help[] =
   rebase_path() function to make file names relative to this path (see "gn help
   rebase_path").
 
+  Identical calls (same script, arguments and working directory) are only run
+  once per GN invocation, even when made from different toolchains; later
+  callers get the output of the first. Scripts should therefore not rely on
+  being invoked once per call site. The number of scripts running at the same
+  time is limited by --script-jobs.
+
   The default script interpreter is Python ("python" on POSIX, "python.exe" or
   "python.bat" on Windows). This can be configured by the script_executable
   variable, see "gn help dotfile".
@@ -227,26 +234,40 @@ Value RunExecScript(Scope* scope,
   //
   // If this shows up on benchmarks, we can cache whether we've done this
   // or not and skip creating the directory.
-  base::CreateDirectory(startup_dir);
-
-  // Execute the process.
-  // TODO(brettw) set the environment block.
-  std::string output;
-  std::string stderr_output;
-  int exit_code = 0;
-  {
-    if (!internal::ExecProcess(cmdline, startup_dir, &output, &stderr_output,
-                               &exit_code)) {
-      *err = Err(function->function(), "Could not execute interpreter.",
-                 "I was trying to execute \"" +
-                     FilePathToUTF8(interpreter_path) + "\".");
+  //
+  // Dry runs don't create the build directory, so scripts can only run if a
+  // previous gen did.
+  if (DryRunEnabled()) {
+    if (!base::DirectoryExists(startup_dir)) {
+      *err = Err(function->function(), "Build directory doesn't exist.",
+                 "exec_script() runs scripts in the build directory, which a "
+                 "dry run doesn't create.\nRun \"gn gen\" without "
+                 "--dry-run first.");
       return Value();
     }
+  } else {
+    base::CreateDirectory(startup_dir);
+  }
+
+  // Execute the process, or pick up the result of an identical invocation
+  // from another toolchain.
+  // TODO(brettw) set the environment block.
+  bool reused = false;
+  ExecScriptCache::Result result =
+      g_scheduler->exec_script_cache()->Exec(cmdline, startup_dir, &reused);
+  if (!result.launched) {
+    *err = Err(function->function(), "Could not execute interpreter.",
+               "I was trying to execute \"" +
+                   FilePathToUTF8(interpreter_path) + "\".");
+    return Value();
   }
+  const std::string& output = result.std_out;
+  const std::string& stderr_output = result.std_err;
+  int exit_code = result.exit_code;
   if (g_scheduler->verbose_logging()) {
     g_scheduler->Log(
         "Executing",
-        script_source_path + " took " +
+        script_source_path + (reused ? " reused result, waited " : " took ") +
             base::Int64ToString(
                 TicksDelta(TicksNow(), begin_exec).InMilliseconds()) +
             "ms");
@@ -8,6 +8,7 @@
 #include "gn/err.h"
 #include "gn/functions.h"
 #include "gn/label_pattern.h"
+#include "gn/label_pattern_set.h"
 #include "gn/parse_tree.h"
 #include "gn/scope.h"
 #include "gn/settings.h"
@@ -41,8 +42,7 @@ Value RunFilterLabels(Scope* scope,
   }
 
   // Extract "patterns"
-  std::vector<LabelPattern> patterns;
-  patterns.reserve(args[1].list_value().size());
+  LabelPatternSet patterns;
 
   for (const auto& value : args[1].list_value()) {
     if (value.type() != Value::STRING) {
@@ -55,7 +55,7 @@ Value RunFilterLabels(Scope* scope,
     if (err->has_error()) {
       return Value();
     }
-    patterns.push_back(std::move(pattern));
+    patterns.Add(pattern);
   }
 
   // Iterate over "labels", resolving and matching against the list of patterns.
@@ -72,7 +72,7 @@ Value RunFilterLabels(Scope* scope,
       return Value();
     }
 
-    const bool matches_pattern = LabelPattern::VectorMatches(patterns, label);
+    const bool matches_pattern = patterns.Matches(label);
     switch (selection) {
       case kIncludeFilter:
         if (matches_pattern)
@@ -7,6 +7,7 @@
 #include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "gn/dry_run.h"
 #include "gn/functions.h"
 #include "gn/scheduler.h"
 #include "gn/test_with_scheduler.h"
@@ -114,3 +115,26 @@ TEST_F(WriteFileTest, WithData) {
   foo_file.GetInfo(&new_info);
   EXPECT_EQ(original_info.last_modified, new_info.last_modified);
 }
+
+// A dry run counts the file without writing it.
+TEST_F(WriteFileTest, DryRun) {
+  TestWithScope setup;
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  setup.build_settings()->SetRootPath(temp_dir.GetPath());
+  setup.build_settings()->SetBuildDir(SourceDir("//out/"));
+
+  ResetDryRunForTesting();
+  EnableDryRun();
+  Value some_string(nullptr, "some string contents");
+  EXPECT_TRUE(CallWriteFile(setup.scope(), "//out/foo.txt", some_string));
+  DryRunStats stats = GetDryRunStats();
+  ResetDryRunForTesting();
+
+  EXPECT_FALSE(base::PathExists(temp_dir.GetPath().AppendASCII("out")));
+  EXPECT_EQ(1, stats.files);
+  EXPECT_EQ(1, stats.changed_files);
+  EXPECT_EQ(static_cast<int64_t>(some_string.string_value().size()),
+            stats.bytes);
+}
@@ -19,6 +19,7 @@
 #include "gn/parse_node_value_adapter.h"
 #include "gn/parse_tree.h"
 #include "gn/pool.h"
+#include "gn/profiler.h"
 #include "gn/scheduler.h"
 #include "gn/scope.h"
 #include "gn/settings.h"
@@ -1515,6 +1516,7 @@ Value RunFunction(Scope* scope,
     Value args = args_list->Execute(scope, err);
     if (err->has_error())
       return Value();
+    ScopedProfile profile(ScopedProfile::TEMPLATE, function, template_name);
     return templ->Invoke(scope, function, template_name, args.list_value(),
                          block, err);
   }
@@ -1536,6 +1538,7 @@ Value RunFunction(Scope* scope,
       if (!VerifyNoBlockForFunctionCall(function, block, err))
         return Value();
     }
+    ScopedProfile profile(ScopedProfile::FUNCTION, function, name.value());
     return found_function->second.self_evaluating_args_runner(scope, function,
                                                               args_list, err);
   }
@@ -1545,6 +1548,8 @@ Value RunFunction(Scope* scope,
   if (err->has_error())
     return Value();
 
+  ScopedProfile profile(ScopedProfile::FUNCTION, function, name.value());
+
   if (found_function->second.generic_block_runner) {
     if (!block) {
       FillNeedsBlockError(function, err);
@@ -0,0 +1,260 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures "gn gen" end to end on a synthetic build.
+//
+// A build is generated with WriteSyntheticBuild() and then loaded, resolved
+// and written in-process a number of times, reporting the time taken by each
+// phase. Run with --help for the options.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "gn/builder.h"
+#include "gn/err.h"
+#include "gn/filesystem_utils.h"
+#include "gn/memory_stats.h"
+#include "gn/ninja_target_rules.h"
+#include "gn/setup.h"
+#include "gn/switches.h"
+#include "gn/synthetic_build.h"
+#include "gn/target.h"
+#include "util/build_config.h"
+#include "util/msg_loop.h"
+#include "util/ticks.h"
+#include "util/worker_pool.h"
+
+namespace {
+
+const char kSwitchDirectories[] = "directories";
+const char kSwitchTargetsPerFile[] = "targets-per-file";
+const char kSwitchTemplateDepth[] = "template-depth";
+const char kSwitchToolchains[] = "toolchains";
+const char kSwitchSourcesPerTarget[] = "sources-per-target";
+const char kSwitchIterations[] = "iterations";
+const char kSwitchRoot[] = "root";
+
+const char kUsage[] =
+    R"(Usage: gn_benchmarks [options]
+
+  Generates a synthetic build and runs the setup, load (which includes
+  executing the build files and resolving targets) and write phases of
+  "gn gen" on it in-process, then prints the time taken by each phase.
+
+  --directories=<n>         Directories with a BUILD.gn file (default 100).
+  --targets-per-file=<n>    Library targets per BUILD.gn file (default 5).
+  --template-depth=<n>      Nested templates per library (default 2).
+  --toolchains=<n>          Toolchains the build is loaded in (default 1).
+  --sources-per-target=<n>  Sources listed in each library (default 10).
+  --iterations=<n>          Number of times to run gen (default 5).
+  --root=<dir>              Write the build to this existing directory and
+                            keep it, rather than to a temporary directory.
+  --memstats                Also print the memory stats and the target
+                            layout size of the first run.
+  --threads=<n>             Worker threads, as for gn.
+)";
+
+// Times of one run, in milliseconds.
+struct PhaseTimes {
+  double setup = 0;
+  double load = 0;
+  double write = 0;
+
+  double total() const { return setup + load + write; }
+};
+
+bool GetIntSwitch(const base::CommandLine& cmdline,
+                  const char* name,
+                  int minimum,
+                  int* value) {
+  if (!cmdline.HasSwitch(name))
+    return true;
+  std::string str = cmdline.GetSwitchValueString(name);
+  if (!base::StringToInt(str, value) || *value < minimum) {
+    fprintf(stderr, "Invalid value \"%s\" for --%s.\n", str.c_str(), name);
+    return false;
+  }
+  return true;
+}
+
+// Writes the ninja files of all targets and then the root ninja files, as
+// "gn gen" does. Returns false on error.
+bool WriteNinjaFiles(Setup* setup) {
+  NinjaTargetRules target_rules(false);
+  {
+    WorkerPool pool;
+    for (const Target* target : setup->builder().GetAllResolvedTargets()) {
+      pool.PostTask(
+          [&target_rules, target]() { target_rules.WriteTarget(target); });
+    }
+  }
+
+  Err err;
+  if (!target_rules.WriteRootFiles(&setup->build_settings(), setup->builder(),
+                                   &err)) {
+    err.PrintToStdout();
+    return false;
+  }
+  return true;
+}
+
+// Prints the average size of the targets and of the side structures they
+// allocated, see Target::GetLayoutSize().
+void PrintTargetLayout(const Builder& builder) {
+  size_t targets = 0;
+  size_t bytes = 0;
+  for (const Target* target : builder.GetAllResolvedTargets()) {
+    targets++;
+    bytes += target->GetLayoutSize();
+  }
+  if (targets) {
+    printf("Target layout: %zu targets, %zu bytes per target\n", targets,
+           bytes / targets);
+  }
+}
+
+// Runs gen on the build in |root| and fills in the time of each phase.
+// Memory stats are recorded if |record_memory| is set. Returns false on error.
+bool RunGen(const base::FilePath& root, bool record_memory, PhaseTimes* times) {
+  base::CommandLine cmdline(base::CommandLine::NO_PROGRAM);
+  cmdline.AppendSwitchPath(switches::kRoot, root);
+
+  auto setup = std::make_unique<Setup>();
+  setup->set_gen_empty_args(true);
+
+  ElapsedTimer timer;
+  if (!setup->DoSetup("//out/benchmark", true, cmdline))
+    return false;
+  times->setup = timer.Elapsed().InMillisecondsF();
+  if (record_memory) {
+    RecordMemoryPhase("setup", setup->scheduler().input_file_manager(),
+                      &setup->builder());
+  }
+
+  timer = ElapsedTimer();
+  if (!setup->Run(cmdline))
+    return false;
+  times->load = timer.Elapsed().InMillisecondsF();
+  if (record_memory) {
+    RecordMemoryPhase("load", setup->scheduler().input_file_manager(),
+                      &setup->builder());
+    PrintTargetLayout(setup->builder());
+  }
+
+  timer = ElapsedTimer();
+  if (!WriteNinjaFiles(setup.get()))
+    return false;
+  times->write = timer.Elapsed().InMillisecondsF();
+  if (record_memory) {
+    RecordMemoryPhase("write", setup->scheduler().input_file_manager(),
+                      &setup->builder());
+  }
+  return true;
+}
+
+void PrintPhase(const char* name,
+                const std::vector<PhaseTimes>& runs,
+                double (*get)(const PhaseTimes&)) {
+  double min = get(runs[0]);
+  double max = min;
+  double sum = 0;
+  for (const PhaseTimes& run : runs) {
+    double value = get(run);
+    min = std::min(min, value);
+    max = std::max(max, value);
+    sum += value;
+  }
+  printf("%-8s %10.1f %10.1f %10.1f\n", name, min, sum / runs.size(), max);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+#if defined(OS_WIN)
+  base::CommandLine::set_slash_is_not_a_switch();
+#endif
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& cmdline = *base::CommandLine::ForCurrentProcess();
+
+  if (cmdline.HasSwitch("help") || cmdline.HasSwitch("h")) {
+    printf("%s", kUsage);
+    return EXIT_SUCCESS;
+  }
+
+  SyntheticBuildOptions options;
+  int iterations = 5;
+  if (!GetIntSwitch(cmdline, kSwitchDirectories, 1, &options.directories) ||
+      !GetIntSwitch(cmdline, kSwitchTargetsPerFile, 1,
+                    &options.targets_per_file) ||
+      !GetIntSwitch(cmdline, kSwitchTemplateDepth, 0,
+                    &options.template_depth) ||
+      !GetIntSwitch(cmdline, kSwitchToolchains, 1, &options.toolchains) ||
+      !GetIntSwitch(cmdline, kSwitchSourcesPerTarget, 0,
+                    &options.sources_per_target) ||
+      !GetIntSwitch(cmdline, kSwitchIterations, 1, &iterations))
+    return EXIT_FAILURE;
+
+  bool memstats = cmdline.HasSwitch(switches::kMemstats);
+  if (memstats)
+    EnableMemoryStats();
+
+  base::ScopedTempDir temp_dir;
+  base::FilePath root;
+  if (cmdline.HasSwitch(kSwitchRoot)) {
+    root = base::MakeAbsoluteFilePath(cmdline.GetSwitchValuePath(kSwitchRoot));
+  } else {
+    if (!temp_dir.CreateUniqueTempDir()) {
+      fprintf(stderr, "Couldn't create a temporary directory.\n");
+      return EXIT_FAILURE;
+    }
+    root = temp_dir.GetPath();
+  }
+  if (root.empty() || !WriteSyntheticBuild(root, options)) {
+    fprintf(stderr, "Couldn't write the synthetic build.\n");
+    return EXIT_FAILURE;
+  }
+
+  setvbuf(stdout, NULL, _IOLBF, BUFSIZ);
+  printf(
+      "Synthetic build: %d directories, %d targets per file, template depth "
+      "%d, %d toolchains, %d sources per target\n",
+      options.directories, options.targets_per_file, options.template_depth,
+      options.toolchains, options.sources_per_target);
+
+  std::vector<PhaseTimes> runs;
+  base::FilePath out_dir = root.Append(FILE_PATH_LITERAL("out"));
+  for (int i = 0; i < iterations; i++) {
+    // Start from an empty build directory so every run writes all files.
+    base::DeleteFile(out_dir, true);
+
+    // A message loop can only be run once.
+    MsgLoop msg_loop;
+    PhaseTimes times;
+    if (!RunGen(root, memstats && i == 0, &times)) {
+      fprintf(stderr, "gen failed.\n");
+      return EXIT_FAILURE;
+    }
+    runs.push_back(times);
+  }
+
+  printf("%-8s %10s %10s %10s\n", "Phase", "min ms", "mean ms", "max ms");
+  PrintPhase("setup", runs, [](const PhaseTimes& t) { return t.setup; });
+  PrintPhase("load", runs, [](const PhaseTimes& t) { return t.load; });
+  PrintPhase("write", runs, [](const PhaseTimes& t) { return t.write; });
+  PrintPhase("total", runs, [](const PhaseTimes& t) { return t.total(); });
+
+  if (memstats)
+    printf("\n%s", SummarizeMemoryStats().c_str());
+  return EXIT_SUCCESS;
+}
@@ -10,6 +10,7 @@
 #include "gn/commands.h"
 #include "gn/err.h"
 #include "gn/location.h"
+#include "gn/memory_stats.h"
 #include "gn/standard_out.h"
 #include "gn/switches.h"
 #include "util/build_config.h"
@@ -66,6 +67,10 @@ int main(int argc, char** argv) {
   if (!commands::CommandSwitches::Init(cmdline))
     return 1;
 
+  // Before any of the objects it counts are created.
+  if (cmdline.HasSwitch(switches::kMemstats))
+    EnableMemoryStats();
+
   const commands::CommandInfoMap& command_map = commands::GetCommands();
   commands::CommandInfoMap::const_iterator found_command =
       command_map.find(command);
@@ -248,6 +248,9 @@ class HashTableBase {
   // Return the number of keys in the set.
   size_t size() const { return count_; }
 
+  // Return the number of nodes allocated for the set, for memory stats.
+  size_t bucket_count() const { return size_; }
+
  protected:
   // The following should only be called by derived classes that
   // extend this template class, and are not available to their
@@ -6,7 +6,6 @@
 
 #include <algorithm>
 
-#include "base/containers/queue.h"
 #include "base/files/file_util.h"
 #include "base/strings/string_util.h"
 #include "gn/build_settings.h"
@@ -123,6 +122,7 @@ HeaderChecker::HeaderChecker(const BuildSettings* build_settings,
     : build_settings_(build_settings),
       check_generated_(check_generated),
       check_system_(check_system),
+      graph_(targets),
       lock_(),
       task_count_cv_() {
   for (auto* target : targets)
@@ -547,54 +547,64 @@ bool HeaderChecker::IsDependencyOf(const Target* search_for,
   // This method conducts a breadth-first search through the dependency graph
   // to find a shortest chain from search_from to search_for.
   //
-  // work_queue maintains a queue of targets which need to be considered as
-  // part of this chain, in the order they were first traversed.
+  // visits holds the targets in the order they were first traversed, and
+  // doubles as the work queue: the targets after |i| still need to be
+  // considered as part of this chain.
   //
   // Each time a new transitive dependency of search_from is discovered for
-  // the first time, it is added to work_queue and a "breadcrumb" is added,
-  // indicating which target it was reached from when first discovered.
+  // the first time, it is appended to visits with a "breadcrumb", the index
+  // of the visit it was reached from.
   //
   // Once this search finds search_for, the breadcrumbs are used to reconstruct
   // a shortest dependency chain (in reverse order) from search_from to
   // search_for.
+  DependencyGraph::Node from = graph_.GetNode(search_from);
+  DependencyGraph::Node to = graph_.GetNode(search_for);
+  if (from == DependencyGraph::kNoNode || to == DependencyGraph::kNoNode)
+    return false;
 
-  std::map<const Target*, ChainLink> breadcrumbs;
-  base::queue<ChainLink> work_queue;
-  work_queue.push(ChainLink(search_from, true));
+  struct Visit {
+    DependencyGraph::Node node;
+    bool is_public;
+    size_t breadcrumb;
+  };
+  std::vector<Visit> visits;
+  std::vector<bool> visited(graph_.size());
+  visits.push_back({from, true, 0});
+  visited[from] = true;
 
-  bool first_time = true;
-  while (!work_queue.empty()) {
-    ChainLink cur_link = work_queue.front();
-    const Target* target = cur_link.target;
-    work_queue.pop();
+  for (size_t i = 0; i < visits.size(); i++) {
+    DependencyGraph::Node node = visits[i].node;
 
-    if (target == search_for) {
+    if (node == to) {
       // Found it! Reconstruct the chain.
       chain->clear();
-      while (target != search_from) {
-        chain->push_back(cur_link);
-        cur_link = breadcrumbs[target];
-        target = cur_link.target;
+      for (size_t cur = i; cur != 0; cur = visits[cur].breadcrumb) {
+        chain->push_back(
+            ChainLink(graph_.target(visits[cur].node), visits[cur].is_public));
       }
       chain->push_back(ChainLink(search_from, true));
       return true;
     }
 
     // Always consider public dependencies as possibilities.
-    for (const auto& dep : target->public_deps()) {
-      if (breadcrumbs.insert(std::make_pair(dep.ptr, cur_link)).second)
-        work_queue.push(ChainLink(dep.ptr, true));
+    for (DependencyGraph::Node dep : graph_.public_deps(node)) {
+      if (!visited[dep]) {
+        visited[dep] = true;
+        visits.push_back({dep, true, i});
+      }
     }
 
-    if (first_time || !require_permitted) {
+    if (i == 0 || !require_permitted) {
       // Consider all dependencies since all target paths are allowed, so add
       // in private ones. Also do this the first time through the loop, since
       // a target can include headers from its direct deps regardless of
       // public/private-ness.
-      first_time = false;
-      for (const auto& dep : target->private_deps()) {
-        if (breadcrumbs.insert(std::make_pair(dep.ptr, cur_link)).second)
-          work_queue.push(ChainLink(dep.ptr, false));
+      for (DependencyGraph::Node dep : graph_.private_deps(node)) {
+        if (!visited[dep]) {
+          visited[dep] = true;
+          visits.push_back({dep, false, i});
+        }
       }
     }
   }
@@ -17,6 +17,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "gn/c_include_iterator.h"
+#include "gn/dependency_graph.h"
 #include "gn/err.h"
 #include "gn/source_dir.h"
 
@@ -51,6 +52,9 @@ class HeaderChecker : public base::RefCountedThreadSafe<HeaderChecker> {
   // check_generated, if true, will also check generated
   // files. Something that can only be done after running a build that
   // has generated them.
+  //
+  // The dependencies of the targets are copied into a DependencyGraph, so
+  // they must not change while the checker is in use.
   HeaderChecker(const BuildSettings* build_settings,
                 const std::vector<const Target*>& targets,
                 bool check_generated,
@@ -187,6 +191,9 @@ class HeaderChecker : public base::RefCountedThreadSafe<HeaderChecker> {
   // Maps source files to targets it appears in (usually just one target).
   FileMap file_map_;
 
+  // The dependencies of the targets, searched by IsDependencyOf().
+  DependencyGraph graph_;
+
   // Number of tasks posted by RunCheckOverFiles() that haven't completed their
   // execution.
   base::AtomicRefCount task_count_;
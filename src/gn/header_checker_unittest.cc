@@ -80,8 +80,6 @@ void PrintTo(const SourceFile& source_file, ::std::ostream* os) {
 }
 
 TEST_F(HeaderCheckerTest, IsDependencyOf) {
-  auto checker = CreateChecker();
-
   // Add a target P ("private") that privately depends on C, and hook up the
   // chain so that A -> P -> C. A will depend on C via two different paths.
   Err err;
@@ -95,6 +93,8 @@ TEST_F(HeaderCheckerTest, IsDependencyOf) {
 
   a_.public_deps().push_back(LabelTargetPair(&p));
 
+  auto checker = CreateChecker();
+
   // A does not depend on itself.
   bool is_permitted = false;
   HeaderChecker::Chain chain;
@@ -132,6 +132,7 @@ TEST_F(HeaderCheckerTest, IsDependencyOf) {
   chain.clear();
   EXPECT_EQ(&c_, b_.public_deps()[0].ptr);  // Validate it's the right one.
   b_.public_deps().erase(b_.public_deps().begin());
+  checker = CreateChecker();
   EXPECT_TRUE(checker->IsDependencyOf(&c_, &a_, &chain, &is_permitted));
   EXPECT_EQ(3u, chain.size());
   EXPECT_EQ(HeaderChecker::ChainLink(&c_, false), chain[0]);
@@ -5,6 +5,7 @@
 #include "gn/import_manager.h"
 
 #include <memory>
+#include <thread>
 
 #include "gn/err.h"
 #include "gn/parse_tree.h"
@@ -125,14 +126,13 @@ bool ImportManager::DoImport(const SourceFile& file,
       if (TracingEnabled() &&
           TicksDelta(import_block_end, import_block_begin).InMilliseconds() >
               kImportBlockTraceThresholdMS) {
-        auto import_block_trace = std::make_unique<TraceItem>(
-            TraceItem::TRACE_IMPORT_BLOCK, file.value(),
-            std::this_thread::get_id());
-        import_block_trace->set_begin(import_block_begin);
-        import_block_trace->set_end(import_block_end);
-        import_block_trace->set_toolchain(
+        TraceItem import_block_trace(TraceItem::TRACE_IMPORT_BLOCK,
+                                     file.value());
+        import_block_trace.set_begin(import_block_begin);
+        import_block_trace.set_end(import_block_end);
+        import_block_trace.set_toolchain(
             scope->settings()->toolchain_label().GetUserVisibleName(false));
-        AddTrace(std::move(import_block_trace));
+        AddTrace(import_block_trace);
       }
     }
 
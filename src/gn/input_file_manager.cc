@@ -15,9 +15,13 @@
 #include "gn/tokenizer.h"
 #include "gn/trace.h"
 #include "gn/vector_utils.h"
+#include "util/ticks.h"
 
 namespace {
 
+// Prefetches only run when the worker pool has nothing else to do.
+constexpr int64_t kPrefetchPriority = -1;
+
 // The opposite of std::lock_guard.
 struct ScopedUnlock {
   ScopedUnlock(std::unique_lock<std::mutex>& lock) : lock_(lock) {
@@ -100,7 +104,12 @@ bool DoLoadFile(const LocationRange& origin,
 }  // namespace
 
 InputFileManager::InputFileData::InputFileData(const SourceFile& file_name)
-    : file(file_name), loaded(false), sync_invocation(false) {}
+    : file(file_name),
+      loaded(false),
+      sync_invocation(false),
+      prefetched(false),
+      unused(false),
+      started(true) {}
 
 InputFileManager::InputFileData::~InputFileData() = default;
 
@@ -136,6 +145,7 @@ bool InputFileManager::AsyncLoadFile(const LocationRange& origin,
 
     } else {
       InputFileData* data = found->second.get();
+      data->unused = false;
 
       // Prevent mixing async and sync loads. See SyncLoadFile for discussion.
       if (data->sync_invocation) {
@@ -152,7 +162,17 @@ bool InputFileManager::AsyncLoadFile(const LocationRange& origin,
         return false;
       }
 
-      if (data->loaded) {
+      if (!data->started) {
+        // The prefetch of this file is still queued behind all the other
+        // work, so load it now at the priority of a real load.
+        data->started = true;
+        data->prefetched = false;
+        data->scheduled_callbacks.push_back(callback);
+        schedule_this = [this, origin, build_settings, file_name,
+                         file = &data->file]() {
+          BackgroundLoadFile(origin, build_settings, file_name, file);
+        };
+      } else if (data->loaded) {
         // Can just directly issue the callback on the background thread.
         schedule_this = [callback, root = data->parsed_root.get()]() {
           InvokeFileLoadCallback(callback, root);
@@ -164,7 +184,9 @@ bool InputFileManager::AsyncLoadFile(const LocationRange& origin,
       }
     }
   }
-  g_scheduler->ScheduleWork(std::move(schedule_this));
+  g_scheduler->ScheduleWork(
+      std::move(schedule_this),
+      g_scheduler->load_timings()->GetPriority(file_name));
   return true;
 }
 
@@ -192,6 +214,12 @@ const ParseNode* InputFileManager::SyncLoadFile(
     // This file has either been loaded or is pending loading.
     data = found->second.get();
 
+    // A prefetched file takes the load type of the first real load of it.
+    if (data->unused) {
+      data->unused = false;
+      data->sync_invocation = true;
+    }
+
     if (!data->sync_invocation) {
       // Don't allow mixing of sync and async loads. If an async load is
       // scheduled and then a bunch of threads need to load it synchronously
@@ -220,7 +248,15 @@ const ParseNode* InputFileManager::SyncLoadFile(
       return nullptr;
     }
 
-    if (!data->loaded) {
+    if (!data->started) {
+      // The prefetch of this file is still queued, possibly behind this very
+      // task, so waiting for it could deadlock. Load the file here instead.
+      data->started = true;
+      data->prefetched = false;
+      ScopedUnlock unlock(lock);
+      if (!LoadFile(origin, build_settings, file_name, &data->file, err))
+        return nullptr;
+    } else if (!data->loaded) {
       // Wait for the already-pending sync load to complete.
       if (!data->completion_event) {
         data->completion_event = std::make_unique<AutoResetEvent>();
@@ -244,6 +280,29 @@ const ParseNode* InputFileManager::SyncLoadFile(
   return data->parsed_root.get();
 }
 
+void InputFileManager::PrefetchFile(const BuildSettings* build_settings,
+                                    const SourceFile& file_name) {
+  InputFile* file;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (input_files_.find(file_name) != input_files_.end())
+      return;
+
+    std::unique_ptr<InputFileData> data =
+        std::make_unique<InputFileData>(file_name);
+    data->prefetched = true;
+    data->unused = true;
+    data->started = false;
+    file = &data->file;
+    input_files_[file_name] = std::move(data);
+  }
+  g_scheduler->ScheduleWork(
+      [this, build_settings, file_name, file]() {
+        BackgroundPrefetchFile(build_settings, file_name, file);
+      },
+      kPrefetchPriority);
+}
+
 void InputFileManager::AddDynamicInput(
     const SourceFile& name,
     InputFile** file,
@@ -261,7 +320,26 @@ void InputFileManager::AddDynamicInput(
 
 int InputFileManager::GetInputFileCount() const {
   std::lock_guard<std::mutex> lock(lock_);
-  return static_cast<int>(input_files_.size());
+  int count = 0;
+  for (const auto& file : input_files_) {
+    if (!file.second->unused)
+      count++;
+  }
+  return count;
+}
+
+void InputFileManager::GetMemoryStats(size_t* files, size_t* bytes) const {
+  std::lock_guard<std::mutex> lock(lock_);
+  *files = 0;
+  *bytes = 0;
+  for (const auto& file : input_files_) {
+    // The data of files still loading isn't protected by the lock.
+    if (!file.second->loaded)
+      continue;
+    (*files)++;
+    *bytes += sizeof(InputFileData) + file.second->file.contents().capacity() +
+              file.second->tokens.capacity() * sizeof(Token);
+  }
 }
 
 void InputFileManager::AddAllPhysicalInputFileNamesToVectorSetSorter(
@@ -269,7 +347,7 @@ void InputFileManager::AddAllPhysicalInputFileNamesToVectorSetSorter(
   std::lock_guard<std::mutex> lock(lock_);
 
   for (const auto& file : input_files_) {
-    if (!file.second->file.physical_name().empty())
+    if (!file.second->unused && !file.second->file.physical_name().empty())
       sorter->Add(file.second->file.physical_name());
   }
 }
@@ -283,6 +361,37 @@ void InputFileManager::BackgroundLoadFile(const LocationRange& origin,
     g_scheduler->FailWithError(err);
 }
 
+void InputFileManager::BackgroundPrefetchFile(
+    const BuildSettings* build_settings,
+    const SourceFile& name,
+    InputFile* file) {
+  {
+    // A real load may have taken the file over while this was queued.
+    std::lock_guard<std::mutex> lock(lock_);
+    InputFileMap::iterator found = input_files_.find(name);
+    DCHECK(found != input_files_.end());
+    if (found->second->started)
+      return;
+    found->second->started = true;
+  }
+
+  Err err;
+  if (LoadFile(LocationRange(), build_settings, name, file, &err))
+    return;
+
+  // Failed prefetches nobody asked for are dropped by LoadFile(), and sync
+  // loads report the error themselves, so only async loads are left to report.
+  bool report_error;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    InputFileMap::const_iterator found = input_files_.find(name);
+    report_error =
+        found != input_files_.end() && !found->second->sync_invocation;
+  }
+  if (report_error)
+    g_scheduler->FailWithError(err);
+}
+
 bool InputFileManager::LoadFile(const LocationRange& origin,
                                 const BuildSettings* build_settings,
                                 const SourceFile& name,
@@ -290,8 +399,10 @@ bool InputFileManager::LoadFile(const LocationRange& origin,
                                 Err* err) {
   std::vector<Token> tokens;
   std::unique_ptr<ParseNode> root;
+  ElapsedTimer timer;
   bool success = DoLoadFile(origin, build_settings, name, load_file_callback_,
                             file, &tokens, &root, err);
+  TickDelta load_time = timer.Elapsed();
   // Can't return early. We have to ensure that the completion event is
   // signaled in all cases because another thread could be blocked on this one.
 
@@ -300,12 +411,16 @@ bool InputFileManager::LoadFile(const LocationRange& origin,
   ParseNode* unowned_root = root.get();
 
   std::vector<FileLoadCallback> callbacks;
+  bool sync_invocation;
+  bool prefetched;
   {
     std::lock_guard<std::mutex> lock(lock_);
     DCHECK(input_files_.find(name) != input_files_.end());
 
     InputFileData* data = input_files_[name].get();
     data->loaded = true;
+    sync_invocation = data->sync_invocation;
+    prefetched = data->prefetched;
     if (success) {
       data->tokens = std::move(tokens);
       data->parsed_root = std::move(root);
@@ -328,8 +443,19 @@ bool InputFileManager::LoadFile(const LocationRange& origin,
       data->completion_event->Signal();
 
     callbacks = std::move(data->scheduled_callbacks);
+
+    // Forget failed prefetches nothing asked for so that a later load tries
+    // again and reports the error against the right origin. Nothing can be
+    // waiting on them.
+    if (!success && data->unused)
+      input_files_.erase(name);
   }
 
+  // Imports are timed as part of running the file importing them, and
+  // prefetched files were loaded off the critical path.
+  if (!sync_invocation && !prefetched)
+    g_scheduler->load_timings()->AddTime(name, load_time);
+
   // Run pending invocations. Theoretically we could schedule each of these
   // separately to get some parallelism. But normally there will only be one
   // item in the list, so that's extra overhead and complexity for no gain.
@@ -68,6 +68,14 @@ class InputFileManager : public base::RefCountedThreadSafe<InputFileManager> {
                                 const SourceFile& file_name,
                                 Err* err);
 
+  // Starts loading and parsing the given file in the background before it is
+  // known to be needed, for example because the previous run used it. A later
+  // AsyncLoadFile() or SyncLoadFile() of the file picks up the result. Files
+  // that are never requested aren't counted as inputs and failing to load
+  // them isn't an error.
+  void PrefetchFile(const BuildSettings* build_settings,
+                    const SourceFile& file_name);
+
   // Creates an entry to manage the memory associated with keeping a parsed
   // set of code in memory.
   //
@@ -91,6 +99,10 @@ class InputFileManager : public base::RefCountedThreadSafe<InputFileManager> {
   // Does not count dynamic input.
   int GetInputFileCount() const;
 
+  // Returns the number of loaded files and an estimate of the bytes used by
+  // their contents and tokens, for memory stats. Does not count dynamic input.
+  void GetMemoryStats(size_t* files, size_t* bytes) const;
+
   // Add all physical input files to a VectorSetSorter instance.
   // This allows fast merging and sorting with other file paths sets.
   //
@@ -120,6 +132,16 @@ class InputFileManager : public base::RefCountedThreadSafe<InputFileManager> {
 
     bool sync_invocation;
 
+    // Set when the load was started by PrefetchFile().
+    bool prefetched;
+
+    // Set while a prefetched file hasn't been requested by a real load.
+    bool unused;
+
+    // Set once a thread has started loading the file. Until then, the file is
+    // a queued prefetch which a real load can take over.
+    bool started;
+
     // Lists all invocations that need to be executed when the file completes
     // loading.
     std::vector<FileLoadCallback> scheduled_callbacks;
@@ -143,6 +165,10 @@ class InputFileManager : public base::RefCountedThreadSafe<InputFileManager> {
                           const SourceFile& name,
                           InputFile* file);
 
+  void BackgroundPrefetchFile(const BuildSettings* build_settings,
+                              const SourceFile& name,
+                              InputFile* file);
+
   // Loads the given file. On error, sets the Err and return false.
   bool LoadFile(const LocationRange& origin,
                 const BuildSettings* build_settings,
@@ -17,6 +17,7 @@
 #include "gn/commands.h"
 #include "gn/deps_iterator.h"
 #include "gn/desc_builder.h"
+#include "gn/dry_run.h"
 #include "gn/filesystem_utils.h"
 #include "gn/invoke_python.h"
 #include "gn/scheduler.h"
@@ -115,7 +116,8 @@ bool JSONProjectWriter::RunAndWriteFiles(
       return false;
     }
 
-    if (!exec_script.empty()) {
+    // The script would read the file, which isn't written in a dry run.
+    if (!exec_script.empty() && !DryRunEnabled()) {
       SourceFile script_file;
       if (exec_script[0] != '/') {
         // Relative path, assume the base is in build_dir.
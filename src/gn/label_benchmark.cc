@@ -0,0 +1,139 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "gn/label.h"
+#include "gn/label_id.h"
+#include "gn/source_dir.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+const size_t kCount = 10000;
+
+std::vector<SourceDir> MakeDirs() {
+  std::vector<SourceDir> dirs;
+  for (size_t i = 0; i < kCount / 10; i++)
+    dirs.emplace_back("//components/module" + std::to_string(i) + "/");
+  return dirs;
+}
+
+std::vector<Label> MakeLabels() {
+  SourceDir toolchain_dir("//build/toolchain/");
+  std::vector<SourceDir> dirs = MakeDirs();
+  std::vector<Label> labels;
+  for (size_t i = 0; i < kCount; i++) {
+    labels.emplace_back(dirs[i / 10], "target" + std::to_string(i % 10),
+                        toolchain_dir, "default");
+  }
+  return labels;
+}
+
+// Interns the same labels from |thread_count| new threads. Their caches are
+// empty so every lookup goes to the global table, as happens when the
+// scheduler's workers start defining items. The labels are interned once up
+// front so only lookups are measured.
+void RunInternThreads(benchmark::State& state, size_t thread_count) {
+  std::vector<Label> labels = MakeLabels();
+  for (const Label& label : labels)
+    LabelId id(label);
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; i++) {
+      threads.emplace_back([&labels]() {
+        for (const Label& label : labels)
+          benchmark::DoNotOptimize(LabelId(label).value());
+      });
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  state.SetItemsProcessed(state.iterations() * thread_count * kCount);
+}
+
+}  // namespace
+
+// Constructing a label interns its parts and computes its hash.
+BENCHMARK(Label_Construct) {
+  SourceDir toolchain_dir("//build/toolchain/");
+  std::vector<SourceDir> dirs = MakeDirs();
+  std::vector<std::string> names;
+  for (size_t i = 0; i < 10; i++)
+    names.push_back("target" + std::to_string(i));
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kCount; i++) {
+      Label label(dirs[i / 10], names[i % 10], toolchain_dir, "default");
+      benchmark::DoNotOptimize(label.hash());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+BENCHMARK(Label_UnorderedSetLookup) {
+  std::vector<Label> labels = MakeLabels();
+  std::unordered_set<Label> set(labels.begin(), labels.begin() + kCount / 2);
+  while (state.KeepRunning()) {
+    size_t found = 0;
+    for (const Label& label : labels)
+      found += set.count(label);
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+// Sorting compares the directories and names as strings.
+BENCHMARK(Label_Sort) {
+  std::vector<Label> labels = MakeLabels();
+  std::reverse(labels.begin(), labels.end());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::vector<Label> sorted = labels;
+    state.ResumeTiming();
+    std::sort(sorted.begin(), sorted.end());
+    benchmark::DoNotOptimize(sorted.front().hash());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+// Interning an already interned label only hits the thread's cache.
+BENCHMARK(LabelId_Intern) {
+  std::vector<Label> labels = MakeLabels();
+  while (state.KeepRunning()) {
+    for (const Label& label : labels)
+      benchmark::DoNotOptimize(LabelId(label).value());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+BENCHMARK(LabelId_InternColdCache_1Thread) {
+  RunInternThreads(state, 1);
+}
+
+BENCHMARK(LabelId_InternColdCache_4Threads) {
+  RunInternThreads(state, 4);
+}
+
+BENCHMARK(LabelId_InternColdCache_16Threads) {
+  RunInternThreads(state, 16);
+}
+
+BENCHMARK(LabelId_UnorderedSetLookup) {
+  std::vector<LabelId> ids;
+  for (const Label& label : MakeLabels())
+    ids.emplace_back(label);
+  std::unordered_set<LabelId> set(ids.begin(), ids.begin() + kCount / 2);
+  while (state.KeepRunning()) {
+    size_t found = 0;
+    for (LabelId id : ids)
+      found += set.count(id);
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
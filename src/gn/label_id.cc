@@ -0,0 +1,192 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/label_id.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "base/logging.h"
+#include "gn/hash_table_base.h"
+#include "util/thread_local_pointer.h"
+
+namespace {
+
+// A HashTableBase node type that stores an id and the hash of its label. The
+// label itself is only stored once, in the slabs of the LabelTable, so a
+// lookup compares the labels of the ids with the same hash.
+struct LabelIdNode {
+  uint32_t hash;
+  uint32_t id;
+
+  // The following methods are required by HashTableBase<>. Id 0 is the null
+  // label, which is never looked up, so it marks free nodes.
+  bool is_valid() const { return !is_null(); }
+  bool is_null() const { return !id; }
+  size_t hash_value() const { return hash; }
+
+  // No deletion support means faster lookup code.
+  static constexpr bool is_tombstone() { return false; }
+};
+
+// A set of ids, looked up by their labels.
+struct LabelIdSet : public HashTableBase<LabelIdNode> {
+  using BaseType = HashTableBase<LabelIdNode>;
+  using Node = BaseType::Node;
+
+  // Returns the hash of |label| for the set. The hash of a label has few
+  // distinct low bits since it mixes in atom pointers, so its bits are mixed
+  // before the high ones are dropped.
+  static uint32_t Hash(const Label& label) {
+    uint64_t hash = label.hash();
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<uint32_t>(hash);
+  }
+
+  // Returns the node of |label|, whose id is 0 if it isn't in the set, in
+  // which case the node can be passed to Insert(). |get_label| returns the
+  // label of an id.
+  template <typename GetLabel>
+  Node* Lookup(uint32_t hash,
+               const Label& label,
+               const GetLabel& get_label) const {
+    return BaseType::NodeLookup(hash, [&](const Node* node) {
+      return node->hash == hash && get_label(node->id) == label;
+    });
+  }
+
+  void Insert(Node* node, uint32_t hash, uint32_t id) {
+    node->hash = hash;
+    node->id = id;
+    BaseType::UpdateAfterInsert();
+  }
+
+  size_t GetBytes() const { return bucket_count() * sizeof(Node); }
+};
+
+// The labels are stored in slabs which are never moved or freed, so the label
+// of an id can be read without taking the lock: the id was handed out after
+// its label was written, and whoever got the id from the thread that interned
+// it synchronized with it.
+class LabelTable {
+ public:
+  LabelTable() {
+    // Id 0 is the null label, so that LabelId() doesn't need a lookup. It's
+    // not in |ids_| since the null label is never interned.
+    slabs_[0].store(new LabelStorage[kLabelsPerSlab],
+                    std::memory_order_relaxed);
+    new (&slabs_[0].load(std::memory_order_relaxed)[0].label) Label();
+    count_ = 1;
+  }
+
+  uint32_t Intern(uint32_t hash, const Label& label) {
+    DCHECK(!label.is_null());
+    std::lock_guard<std::mutex> lock(mutex_);
+    LabelIdSet::Node* node = ids_.Lookup(
+        hash, label, [this](uint32_t id) -> const Label& { return Get(id); });
+    if (node->id)
+      return node->id;
+
+    CHECK(count_ < kMaxSlabs * kLabelsPerSlab) << "Too many labels.";
+    uint32_t id = static_cast<uint32_t>(count_++);
+    LabelStorage* slab = slabs_[id / kLabelsPerSlab].load(
+        std::memory_order_relaxed);
+    if (!slab) {
+      slab = new LabelStorage[kLabelsPerSlab];
+      slabs_[id / kLabelsPerSlab].store(slab, std::memory_order_release);
+    }
+    new (&slab[id % kLabelsPerSlab].label) Label(label);
+    ids_.Insert(node, hash, id);
+    return id;
+  }
+
+  const Label& Get(uint32_t id) const {
+    return slabs_[id / kLabelsPerSlab]
+        .load(std::memory_order_acquire)[id % kLabelsPerSlab]
+        .label;
+  }
+
+  // Adds |delta| to the bytes used by the caches of the threads.
+  void AddLocalBytes(size_t delta) {
+    local_bytes_.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  void GetStats(size_t* count, size_t* bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *count = count_;
+    // The pages of a slab are only touched as labels are added to it.
+    *bytes = sizeof(*this) + count_ * sizeof(LabelStorage) +
+             ids_.GetBytes() + local_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr size_t kLabelsPerSlab = 1 << 16;
+  static constexpr size_t kMaxSlabs = 1 << 16;
+
+  // Storage for a Label that isn't constructed with the slab, so the pages of
+  // a new slab are only touched as labels are added.
+  union LabelStorage {
+    LabelStorage() {}
+    ~LabelStorage() {}
+    Label label;
+  };
+
+  std::mutex mutex_;
+  LabelIdSet ids_;
+  size_t count_ = 0;
+  std::atomic<LabelStorage*> slabs_[kMaxSlabs] = {};
+  std::atomic<size_t> local_bytes_{0};
+};
+
+LabelTable& GetLabelTable() {
+  // Leaked, so ids stay valid during static destruction.
+  static LabelTable* table = new LabelTable;
+  return *table;
+}
+
+// Each thread caches the ids it has seen to avoid taking the table's lock in
+// most cases. Like the table, the cache only stores ids and reads their labels
+// from the slabs, which is safe since the thread got the ids from the table.
+struct LocalLabelIds {
+  LabelIdSet set;
+};
+
+}  // namespace
+
+LabelId::LabelId(const Label& label) {
+  if (label.is_null())
+    return;
+
+  LabelTable& table = GetLabelTable();
+  LocalLabelIds*& local_ids = ThreadLocalPointer<LocalLabelIds>();
+  if (!local_ids)
+    local_ids = new LocalLabelIds;  // Leaked with the thread.
+  LabelIdSet& set = local_ids->set;
+
+  uint32_t hash = LabelIdSet::Hash(label);
+  LabelIdSet::Node* node = set.Lookup(
+      hash, label, [&table](uint32_t id) -> const Label& {
+        return table.Get(id);
+      });
+  if (node->id) {
+    id_ = node->id;
+    return;
+  }
+  id_ = table.Intern(hash, label);
+  size_t old_bytes = set.GetBytes();
+  set.Insert(node, hash, id_);
+  table.AddLocalBytes(set.GetBytes() - old_bytes);
+}
+
+const Label& LabelId::get() const {
+  return GetLabelTable().Get(id_);
+}
+
+// static
+void LabelId::GetTableStats(size_t* count, size_t* bytes) {
+  GetLabelTable().GetStats(count, bytes);
+}
@@ -0,0 +1,71 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_LABEL_ID_H_
+#define TOOLS_GN_LABEL_ID_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "gn/label.h"
+
+// A LabelId is a 32-bit handle to a Label interned in a global table.
+//
+// Labels are five words long and are copied into every dependency and config
+// pair, and into every BuilderRecord. A LabelId is the index of the label in
+// the table instead: it's a quarter of the size, two ids are equal if and
+// only if their labels are, and hashing doesn't touch the label. The label
+// itself is returned in O(1) by get().
+//
+// Ids depend on the order labels are first interned in, which changes from one
+// run to the next with threads. They must never be used to order things, so
+// operator< compares the labels, and the result of hash() must not be used in
+// a way that affects the output.
+//
+// Interned labels live until the program exits, like StringAtom strings.
+// Thread-safe.
+class LabelId {
+ public:
+  // The null label.
+  LabelId() = default;
+
+  explicit LabelId(const Label& label);
+
+  const Label& get() const;
+
+  // Allow the id to be used where a Label is expected.
+  operator const Label&() const { return get(); }
+  const Label* operator->() const { return &get(); }
+
+  uint32_t value() const { return id_; }
+  bool is_null() const { return id_ == 0; }
+
+  size_t hash() const { return std::hash<uint32_t>()(id_); }
+
+  bool operator==(LabelId other) const { return id_ == other.id_; }
+  bool operator!=(LabelId other) const { return id_ != other.id_; }
+  bool operator<(LabelId other) const {
+    return id_ != other.id_ && get() < other.get();
+  }
+
+  // Returns the number of interned labels and an estimate of the bytes they
+  // use, for memory stats.
+  static void GetTableStats(size_t* count, size_t* bytes);
+
+ private:
+  uint32_t id_ = 0;
+};
+
+namespace std {
+
+template <>
+struct hash<LabelId> {
+  std::size_t operator()(LabelId v) const { return v.hash(); }
+};
+
+}  // namespace std
+
+#endif  // TOOLS_GN_LABEL_ID_H_
@@ -0,0 +1,66 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gn/label_id.h"
+#include "gn/label_ptr.h"
+#include "gn/source_dir.h"
+#include "util/test/test.h"
+
+TEST(LabelId, Intern) {
+  Label a(SourceDir("//foo/"), "a", SourceDir("//tc/"), "default");
+  Label a_copy(SourceDir("//foo/"), "a", SourceDir("//tc/"), "default");
+  Label b(SourceDir("//foo/"), "b", SourceDir("//tc/"), "default");
+  Label a_other_toolchain(SourceDir("//foo/"), "a", SourceDir("//tc/"), "tc");
+
+  LabelId id_a(a);
+  EXPECT_EQ(LabelId(a_copy), id_a);
+  EXPECT_NE(LabelId(b), id_a);
+  EXPECT_NE(LabelId(a_other_toolchain), id_a);
+  EXPECT_EQ(a, id_a.get());
+  EXPECT_EQ("//foo:a(//tc:default)", id_a->GetUserVisibleName(true));
+
+  // Ids are ordered like their labels, whatever order they're interned in.
+  EXPECT_TRUE(id_a < LabelId(b));
+  EXPECT_FALSE(LabelId(b) < id_a);
+  EXPECT_FALSE(id_a < id_a);
+
+  LabelId null_id;
+  EXPECT_TRUE(null_id.is_null());
+  EXPECT_EQ(null_id, LabelId(Label()));
+  EXPECT_TRUE(null_id.get().is_null());
+}
+
+// Labels interned on different threads get the same id.
+TEST(LabelId, Threads) {
+  constexpr size_t kLabels = 100;
+  std::vector<LabelId> ids[2];
+  auto intern = [](std::vector<LabelId>* ids) {
+    for (size_t i = 0; i < kLabels; i++) {
+      ids->emplace_back(Label(SourceDir("//threads/"),
+                              "target" + std::to_string(i),
+                              SourceDir("//tc/"), "default"));
+    }
+  };
+  std::thread first(intern, &ids[0]);
+  std::thread second(intern, &ids[1]);
+  first.join();
+  second.join();
+
+  ASSERT_EQ(kLabels, ids[0].size());
+  EXPECT_EQ(ids[0], ids[1]);
+  for (size_t i = 0; i < kLabels; i++)
+    EXPECT_EQ("target" + std::to_string(i), ids[0][i]->name());
+}
+
+TEST(LabelId, LabelPtrPair) {
+  Label label(SourceDir("//foo/"), "bar");
+  LabelTargetPair pair(label);
+  EXPECT_EQ(label, pair.label);
+  EXPECT_EQ(LabelTargetPair(label), pair);
+  EXPECT_EQ(3 * sizeof(void*), sizeof(LabelTargetPair));
+}
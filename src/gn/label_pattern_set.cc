@@ -0,0 +1,176 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/label_pattern_set.h"
+
+#include <algorithm>
+
+#include "gn/string_atom.h"
+
+namespace {
+
+// Sets with up to this many patterns are matched by testing each pattern,
+// which is as fast as walking the trie for so few.
+constexpr size_t kMaxLinearPatterns = 4;
+
+// Returns the first directory component of |*dir|, including its trailing
+// slash, and removes it from |*dir|.
+std::string_view TakeComponent(std::string_view* dir) {
+  size_t slash = dir->find('/');
+  size_t size = slash == std::string_view::npos ? dir->size() : slash + 1;
+  std::string_view component = dir->substr(0, size);
+  dir->remove_prefix(size);
+  return component;
+}
+
+bool ChildLess(const std::pair<std::string_view, uint32_t>& child,
+               std::string_view component) {
+  return child.first < component;
+}
+
+}  // namespace
+
+LabelPatternSet::Node::Node() = default;
+LabelPatternSet::Node::Node(const Node& other) = default;
+LabelPatternSet::Node::Node(Node&& other) = default;
+LabelPatternSet::Node::~Node() = default;
+LabelPatternSet::Node& LabelPatternSet::Node::operator=(const Node& other) =
+    default;
+LabelPatternSet::Node& LabelPatternSet::Node::operator=(Node&& other) = default;
+
+LabelPatternSet::LabelPatternSet() = default;
+
+LabelPatternSet::LabelPatternSet(const std::vector<LabelPattern>& patterns)
+    : LabelPatternSet() {
+  for (const LabelPattern& pattern : patterns)
+    Add(pattern);
+}
+
+LabelPatternSet::LabelPatternSet(const LabelPatternSet& other) = default;
+LabelPatternSet::LabelPatternSet(LabelPatternSet&& other) = default;
+LabelPatternSet::~LabelPatternSet() = default;
+
+LabelPatternSet& LabelPatternSet::operator=(const LabelPatternSet& other) =
+    default;
+LabelPatternSet& LabelPatternSet::operator=(LabelPatternSet&& other) = default;
+
+void LabelPatternSet::Add(const LabelPattern& pattern) {
+  patterns_.push_back(pattern);
+  if (patterns_.size() <= kMaxLinearPatterns)
+    return;
+
+  if (nodes_.empty()) {
+    // Switching to the trie, index the patterns matched linearly so far.
+    nodes_.emplace_back();
+    for (const LabelPattern& existing : patterns_)
+      Index(existing);
+  } else {
+    Index(pattern);
+  }
+}
+
+void LabelPatternSet::Index(const LabelPattern& pattern) {
+  // Find or create the node for the pattern's directory. The views stay valid
+  // since SourceDir and StringAtom strings are interned.
+  uint32_t node = GetRoot(pattern.toolchain());
+  std::string_view dir(pattern.dir().value());
+  while (!dir.empty()) {
+    std::string_view component = TakeComponent(&dir);
+    auto& children = nodes_[node].children;
+    auto found = std::lower_bound(children.begin(), children.end(), component,
+                                  &ChildLess);
+    if (found != children.end() && found->first == component) {
+      node = found->second;
+    } else {
+      uint32_t child = static_cast<uint32_t>(nodes_.size());
+      // Insert before adding the node, which invalidates |children|.
+      children.insert(found, std::make_pair(component, child));
+      nodes_.emplace_back();
+      node = child;
+    }
+  }
+
+  Node& target = nodes_[node];
+  switch (pattern.type()) {
+    case LabelPattern::MATCH: {
+      // LabelPattern stores the name as a plain string, so intern it to get a
+      // view that stays valid.
+      std::string_view name(StringAtom(pattern.name()).str());
+      auto found = std::lower_bound(target.names.begin(), target.names.end(),
+                                    name);
+      if (found == target.names.end() || *found != name)
+        target.names.insert(found, name);
+      break;
+    }
+    case LabelPattern::DIRECTORY:
+      target.all_names = true;
+      break;
+    case LabelPattern::RECURSIVE_DIRECTORY:
+      target.recursive = true;
+      break;
+  }
+}
+
+void LabelPatternSet::Clear() {
+  *this = LabelPatternSet();
+}
+
+bool LabelPatternSet::Matches(const Label& label) const {
+  if (nodes_.empty())
+    return LabelPattern::VectorMatches(patterns_, label);
+
+  if (MatchesInTree(0, label))
+    return true;
+
+  for (const auto& [toolchain, root] : toolchain_roots_) {
+    // Toolchain must match exactly.
+    if (toolchain.dir() == label.toolchain_dir() &&
+        toolchain.name_atom().SameAs(label.toolchain_name_atom()))
+      return MatchesInTree(root, label);
+  }
+  return false;
+}
+
+uint32_t LabelPatternSet::GetRoot(const Label& toolchain) {
+  if (toolchain.is_null())
+    return 0;
+
+  for (const auto& [existing, root] : toolchain_roots_) {
+    if (existing.dir() == toolchain.dir() &&
+        existing.name_atom().SameAs(toolchain.name_atom()))
+      return root;
+  }
+
+  uint32_t root = static_cast<uint32_t>(nodes_.size());
+  nodes_.emplace_back();
+  toolchain_roots_.push_back(std::make_pair(toolchain, root));
+  return root;
+}
+
+bool LabelPatternSet::MatchesInTree(uint32_t root, const Label& label) const {
+  uint32_t node = root;
+  std::string_view dir(label.dir().value());
+  for (;;) {
+    const Node& current = nodes_[node];
+    // A recursive pattern for any prefix of the directory matches.
+    if (current.recursive)
+      return true;
+
+    if (dir.empty()) {
+      // Reached the label's own directory.
+      if (current.all_names)
+        return true;
+      return std::binary_search(current.names.begin(), current.names.end(),
+                                std::string_view(label.name()));
+    }
+
+    std::string_view component = TakeComponent(&dir);
+    auto found = std::lower_bound(current.children.begin(),
+                                  current.children.end(), component,
+                                  &ChildLess);
+    if (found == current.children.end() || found->first != component)
+      return false;
+    node = found->second;
+  }
+}
@@ -0,0 +1,96 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_LABEL_PATTERN_SET_H_
+#define TOOLS_GN_LABEL_PATTERN_SET_H_
+
+#include <stdint.h>
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "base/gtest_prod_util.h"
+#include "gn/label.h"
+#include "gn/label_pattern.h"
+
+// A set of label patterns compiled for matching many labels against.
+//
+// LabelPattern::VectorMatches() tests every pattern in turn. Once there are
+// more than a few patterns, this class instead indexes them by toolchain and
+// then by directory in a trie over the directory components, so matching a
+// label walks the components of its directory once regardless of the number
+// of patterns. Most sets (visibility lists, for instance) are empty or short,
+// and those don't allocate any index.
+class LabelPatternSet {
+ public:
+  LabelPatternSet();
+  explicit LabelPatternSet(const std::vector<LabelPattern>& patterns);
+  LabelPatternSet(const LabelPatternSet& other);
+  LabelPatternSet(LabelPatternSet&& other);
+  ~LabelPatternSet();
+
+  LabelPatternSet& operator=(const LabelPatternSet& other);
+  LabelPatternSet& operator=(LabelPatternSet&& other);
+
+  void Add(const LabelPattern& pattern);
+  void Clear();
+
+  bool empty() const { return patterns_.empty(); }
+
+  // The patterns in the order they were added.
+  const std::vector<LabelPattern>& patterns() const { return patterns_; }
+
+  // Returns true if any of the patterns match the label. Equivalent to
+  // LabelPattern::VectorMatches(patterns(), label).
+  bool Matches(const Label& label) const;
+
+ private:
+  FRIEND_TEST_ALL_PREFIXES(LabelPatternSet, IndexesLongSets);
+
+  // A directory in the trie. The views point into interned SourceDir and
+  // StringAtom strings which are never freed.
+  struct Node {
+    Node();
+    Node(const Node& other);
+    Node(Node&& other);
+    ~Node();
+
+    Node& operator=(const Node& other);
+    Node& operator=(Node&& other);
+
+    // Sorted by component. Each component includes its trailing slash.
+    std::vector<std::pair<std::string_view, uint32_t>> children;
+
+    // Sorted names of targets matched exactly in this directory.
+    std::vector<std::string_view> names;
+
+    // Set for a "dir:*" pattern for this directory.
+    bool all_names = false;
+
+    // Set for a "dir/*" pattern, matching this directory and all below.
+    bool recursive = false;
+  };
+
+  // Adds the pattern to the trie.
+  void Index(const LabelPattern& pattern);
+
+  // Returns the index of the root node for the given pattern toolchain,
+  // creating it if necessary. A null toolchain matches all toolchains.
+  uint32_t GetRoot(const Label& toolchain);
+
+  bool MatchesInTree(uint32_t root, const Label& label) const;
+
+  std::vector<LabelPattern> patterns_;
+
+  // Empty while the patterns are matched linearly. Otherwise node 0 is the
+  // root for patterns without a toolchain.
+  std::vector<Node> nodes_;
+
+  // Roots for patterns with a toolchain. There are normally very few distinct
+  // toolchains so this is searched linearly.
+  std::vector<std::pair<Label, uint32_t>> toolchain_roots_;
+};
+
+#endif  // TOOLS_GN_LABEL_PATTERN_SET_H_
@@ -0,0 +1,132 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/label_pattern_set.h"
+
+#include <string>
+#include <vector>
+
+#include "gn/err.h"
+#include "gn/value.h"
+#include "util/test/test.h"
+
+namespace {
+
+LabelPattern GetPattern(const char* str) {
+  Err err;
+  LabelPattern pattern = LabelPattern::GetPattern(
+      SourceDir("//foo/"), std::string_view(), Value(nullptr, str), &err);
+  EXPECT_FALSE(err.has_error()) << str;
+  return pattern;
+}
+
+Label GetLabel(const char* str) {
+  Err err;
+  Label label = Label::Resolve(SourceDir("//"), std::string_view(),
+                               Label(SourceDir("//tc/"), "default"),
+                               Value(nullptr, str), &err);
+  EXPECT_FALSE(err.has_error()) << str;
+  return label;
+}
+
+}  // namespace
+
+TEST(LabelPatternSet, Matches) {
+  LabelPatternSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.Matches(GetLabel("//foo:bar")));
+
+  set.Add(GetPattern("//foo:bar"));
+  set.Add(GetPattern("//foo/baz:*"));
+  set.Add(GetPattern("//a/b/*"));
+  set.Add(GetPattern("//x/*(//other:tc)"));
+  EXPECT_FALSE(set.empty());
+  EXPECT_EQ(4u, set.patterns().size());
+
+  EXPECT_TRUE(set.Matches(GetLabel("//foo:bar")));
+  EXPECT_FALSE(set.Matches(GetLabel("//foo:bart")));
+  EXPECT_FALSE(set.Matches(GetLabel("//foo/sub:bar")));
+  EXPECT_TRUE(set.Matches(GetLabel("//foo/baz:anything")));
+  EXPECT_FALSE(set.Matches(GetLabel("//foo/baz/sub:anything")));
+  EXPECT_TRUE(set.Matches(GetLabel("//a/b:c")));
+  EXPECT_TRUE(set.Matches(GetLabel("//a/b/c/d:e")));
+  EXPECT_FALSE(set.Matches(GetLabel("//a/bb:c")));
+  EXPECT_FALSE(set.Matches(GetLabel("//a:b")));
+
+  // Toolchain-specific pattern.
+  EXPECT_FALSE(set.Matches(GetLabel("//x/y:z")));
+  EXPECT_TRUE(set.Matches(GetLabel("//x/y:z(//other:tc)")));
+  EXPECT_FALSE(set.Matches(GetLabel("//x/y:z(//other:tc2)")));
+
+  set.Clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.Matches(GetLabel("//foo:bar")));
+
+  // "*" matches everything.
+  set.Add(GetPattern("*"));
+  EXPECT_TRUE(set.Matches(GetLabel("//any/where:at_all(//other:tc)")));
+}
+
+// Short sets are matched without building the trie.
+TEST(LabelPatternSet, IndexesLongSets) {
+  LabelPatternSet set;
+  EXPECT_TRUE(set.nodes_.empty());
+  EXPECT_FALSE(set.Matches(GetLabel("//foo:bar")));
+
+  set.Add(GetPattern("//foo:bar"));
+  set.Add(GetPattern("//a/*"));
+  EXPECT_TRUE(set.nodes_.empty());
+  EXPECT_TRUE(set.Matches(GetLabel("//foo:bar")));
+  EXPECT_TRUE(set.Matches(GetLabel("//a/b:c")));
+
+  set.Add(GetPattern("//b:*"));
+  set.Add(GetPattern("//c:c(//tc:tc2)"));
+  set.Add(GetPattern("//d:d"));
+  EXPECT_FALSE(set.nodes_.empty());
+  EXPECT_TRUE(set.Matches(GetLabel("//foo:bar")));
+  EXPECT_TRUE(set.Matches(GetLabel("//a/b:c")));
+  EXPECT_TRUE(set.Matches(GetLabel("//b:x")));
+  EXPECT_TRUE(set.Matches(GetLabel("//c:c(//tc:tc2)")));
+  EXPECT_FALSE(set.Matches(GetLabel("//c:c")));
+  EXPECT_TRUE(set.Matches(GetLabel("//d:d")));
+  EXPECT_FALSE(set.Matches(GetLabel("//d:e")));
+
+  set.Clear();
+  EXPECT_TRUE(set.nodes_.empty());
+}
+
+// The set must agree with testing each pattern in turn.
+TEST(LabelPatternSet, MatchesLikeVector) {
+  const char* kPatterns[] = {
+      "//foo:bar", "//foo:*",       "//foo/*",         ":baz",
+      "bar/*",     "//a/b/c:d",     "//a/*(//tc:tc2)", "//a:*(//tc)",
+      "/abs/*",    "//foo/bar:bar", "//foo/bar(//tc)", "//a/b:*",
+  };
+  const char* kLabels[] = {
+      "//foo:bar",       "//foo:baz",         "//foo/bar:bar",
+      "//foo/bar:x",     "//foo/bar/baz:x",   "//a/b/c:d",
+      "//a/b/c:e",       "//a:x(//tc)",       "//a:x(//tc:tc2)",
+      "//a/b:x(//tc:tc2)", "/abs/x:y",        "/abs:y",
+      "//foo/bar(//tc)", "//fo:bar",          "//a/b:x",
+  };
+
+  // Check each pattern on its own and the growing list of all of them.
+  std::vector<LabelPattern> patterns;
+  for (const char* pattern : kPatterns) {
+    std::vector<LabelPattern> single = {GetPattern(pattern)};
+    patterns.push_back(single[0]);
+
+    LabelPatternSet single_set(single);
+    LabelPatternSet set(patterns);
+    for (const char* label_str : kLabels) {
+      Label label = GetLabel(label_str);
+      EXPECT_EQ(LabelPattern::VectorMatches(single, label),
+                single_set.Matches(label))
+          << pattern << " " << label_str;
+      EXPECT_EQ(LabelPattern::VectorMatches(patterns, label),
+                set.Matches(label))
+          << pattern << " " << label_str;
+    }
+  }
+}
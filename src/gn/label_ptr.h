@@ -10,6 +10,7 @@
 #include <functional>
 
 #include "gn/label.h"
+#include "gn/label_id.h"
 
 class Config;
 class ParseNode;
@@ -27,6 +28,7 @@ struct LabelPtrPair {
   LabelPtrPair() = default;
 
   explicit LabelPtrPair(const Label& l) : label(l) {}
+  explicit LabelPtrPair(LabelId l) : label(l) {}
 
   // This constructor is typically used in unit tests, it extracts the label
   // automatically from a given pointer.
@@ -34,7 +36,8 @@ struct LabelPtrPair {
 
   ~LabelPtrPair() = default;
 
-  Label label;
+  // Interned, so the pair is three words long and comparing pairs is cheap.
+  LabelId label;
   const T* ptr = nullptr;
 
   // The origin of this dependency. This will be null for internally generated
@@ -69,8 +72,7 @@ namespace std {
 template <typename T>
 struct hash<LabelPtrPair<T>> {
   std::size_t operator()(const LabelPtrPair<T>& v) const {
-    hash<Label> h;
-    return h(v.label);
+    return v.label.hash();
   }
 };
 
@@ -0,0 +1,132 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/load_timings.h"
+
+#include <algorithm>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "util/atomic_write.h"
+
+// static
+const char LoadTimings::kFileName[] = "gn_load_timings.txt";
+
+namespace {
+
+// Starts the last line of the file, followed by the number of files before it,
+// so a file that was cut short isn't mistaken for a complete one.
+const char kEndMarker[] = "end ";
+
+}  // namespace
+
+LoadTimings::LoadTimings() = default;
+
+LoadTimings::~LoadTimings() = default;
+
+bool LoadTimings::Read(const base::FilePath& path) {
+  previous_.clear();
+
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+
+  // Each line is "<priority> <source-absolute file name>", and the last one is
+  // the end marker with the number of lines before it.
+  std::vector<std::string_view> lines = base::SplitStringPiece(
+      contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  const size_t marker_size = sizeof(kEndMarker) - 1;
+  int64_t count;
+  if (lines.empty() || lines.back().substr(0, marker_size) != kEndMarker ||
+      !base::StringToInt64(lines.back().substr(marker_size), &count) ||
+      count != static_cast<int64_t>(lines.size() - 1))
+    return false;
+  lines.pop_back();
+
+  for (std::string_view line : lines) {
+    size_t space = line.find(' ');
+    int64_t priority;
+    if (space == std::string_view::npos ||
+        !base::StringToInt64(line.substr(0, space), &priority) ||
+        priority < 0 || line.substr(space + 1, 2) != "//") {
+      previous_.clear();
+      return false;
+    }
+    previous_[SourceFile(std::string(line.substr(space + 1)))] = priority;
+  }
+  return true;
+}
+
+int64_t LoadTimings::GetPriority(const SourceFile& file) const {
+  auto found = previous_.find(file);
+  return found == previous_.end() ? 0 : found->second;
+}
+
+void LoadTimings::RecordLoad(const SourceFile& file, const SourceFile& parent) {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (indices_.find(file) != indices_.end())
+    return;
+
+  // Adding the parent first keeps parents before their children in |loads_|.
+  size_t parent_index =
+      parent.is_null() || parent == file ? kNoParent : GetIndexLocked(parent);
+  size_t index = GetIndexLocked(file);
+  loads_[index].parent = parent_index;
+}
+
+void LoadTimings::AddTime(const SourceFile& file, TickDelta time) {
+  std::lock_guard<std::mutex> lock(lock_);
+  loads_[GetIndexLocked(file)].micros +=
+      static_cast<int64_t>(time.InMicroseconds());
+}
+
+std::vector<std::pair<SourceFile, int64_t>> LoadTimings::GetPriorities()
+    const {
+  std::lock_guard<std::mutex> lock(lock_);
+
+  // Children always come after their parent, so walking backwards sees every
+  // child's chain before its parent's.
+  std::vector<int64_t> chains(loads_.size());
+  for (size_t i = loads_.size(); i-- > 0;) {
+    chains[i] += loads_[i].micros;
+    size_t parent = loads_[i].parent;
+    if (parent != kNoParent)
+      chains[parent] = std::max(chains[parent], chains[i]);
+  }
+
+  std::vector<std::pair<SourceFile, int64_t>> result;
+  result.reserve(loads_.size());
+  for (size_t i = 0; i < loads_.size(); i++)
+    result.emplace_back(loads_[i].file, chains[i]);
+  return result;
+}
+
+bool LoadTimings::Write(const base::FilePath& path) const {
+  std::vector<std::pair<SourceFile, int64_t>> priorities = GetPriorities();
+  std::string contents;
+  for (const auto& [file, priority] : priorities) {
+    contents += base::Int64ToString(priority);
+    contents += ' ';
+    contents += file.value();
+    contents += '\n';
+  }
+  contents += kEndMarker;
+  contents += base::NumberToString(priorities.size());
+  contents += '\n';
+
+  // The file is replaced by a rename so an interrupted run can't leave a
+  // partial one behind.
+  return util::WriteFileAtomically(path, contents.data(),
+                                   static_cast<int>(contents.size())) ==
+         static_cast<int>(contents.size());
+}
+
+size_t LoadTimings::GetIndexLocked(const SourceFile& file) {
+  auto [found, inserted] = indices_.try_emplace(file, loads_.size());
+  if (inserted)
+    loads_.push_back({file, kNoParent});
+  return found->second;
+}
@@ -0,0 +1,87 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_LOAD_TIMINGS_H_
+#define TOOLS_GN_LOAD_TIMINGS_H_
+
+#include <stdint.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gn/source_file.h"
+#include "util/ticks.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+// Timings of the build files loaded by a run, saved in the build directory so
+// the next run can start the loads on its critical path first.
+//
+// Build files are discovered as the files that depend on them are run, so a
+// slow file, or a fast one that leads to slow ones, can end up at the back of
+// the worker queue and delay the end of the load. Each loaded file is
+// recorded along with the file whose load caused it, which gives a tree of
+// loads. The priority of a file is the time taken by the longest chain of
+// loads starting at it, so the files leading to the slowest ones come first.
+class LoadTimings {
+ public:
+  LoadTimings();
+  ~LoadTimings();
+
+  // Name of the file the timings are saved to in the build directory.
+  static const char kFileName[];
+
+  // Reads the priorities saved by a previous run from |path|, replacing any
+  // read before. Returns false if the file doesn't exist or is malformed.
+  // Must be called before any loads are scheduled.
+  bool Read(const base::FilePath& path);
+
+  // Returns the priority of loading |file|, in microseconds of the previous
+  // run, or 0 if it's not known. Thread-safe.
+  int64_t GetPriority(const SourceFile& file) const;
+
+  // Records that a load of |file| was scheduled by a file run from |parent|,
+  // which is null for the root of the load. Only the first load of each file
+  // is kept. Thread-safe.
+  void RecordLoad(const SourceFile& file, const SourceFile& parent);
+
+  // Adds |time| spent loading or running |file|. Thread-safe.
+  void AddTime(const SourceFile& file, TickDelta time);
+
+  // Returns the priorities of the files recorded by this run, in the order
+  // they were first loaded.
+  std::vector<std::pair<SourceFile, int64_t>> GetPriorities() const;
+
+  // Writes the priorities of this run to |path|, replacing the file
+  // atomically. Returns false on failure.
+  bool Write(const base::FilePath& path) const;
+
+ private:
+  struct Load {
+    SourceFile file;
+    size_t parent;  // Index in |loads_|, or kNoParent.
+    int64_t micros = 0;
+  };
+  static constexpr size_t kNoParent = static_cast<size_t>(-1);
+
+  // Returns the index of |file| in |loads_|, adding it if needed. Must be
+  // called with |lock_| held.
+  size_t GetIndexLocked(const SourceFile& file);
+
+  // Read by GetPriority() without locking since it's only written by Read().
+  std::unordered_map<SourceFile, int64_t> previous_;
+
+  mutable std::mutex lock_;
+  std::vector<Load> loads_;
+  std::unordered_map<SourceFile, size_t> indices_;
+
+  LoadTimings(const LoadTimings&) = delete;
+  LoadTimings& operator=(const LoadTimings&) = delete;
+};
+
+#endif  // TOOLS_GN_LOAD_TIMINGS_H_
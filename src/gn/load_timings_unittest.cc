@@ -0,0 +1,113 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/load_timings.h"
+
+#include <string.h>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "util/test/test.h"
+
+namespace {
+
+TickDelta Micros(uint64_t micros) {
+  return TickDelta(micros * 1000);
+}
+
+}  // namespace
+
+TEST(LoadTimings, LongestChain) {
+  SourceFile root("//BUILD.gn");
+  SourceFile a("//a/BUILD.gn");
+  SourceFile b("//a/b/BUILD.gn");
+  SourceFile c("//c/BUILD.gn");
+
+  LoadTimings timings;
+  timings.RecordLoad(root, SourceFile());
+  timings.RecordLoad(a, root);
+  timings.RecordLoad(c, root);
+  timings.RecordLoad(b, a);
+  timings.RecordLoad(b, c);  // Only the first load counts.
+  timings.AddTime(root, Micros(10));
+  timings.AddTime(a, Micros(5));
+  timings.AddTime(b, Micros(60));
+  timings.AddTime(b, Micros(40));
+  timings.AddTime(c, Micros(50));
+
+  auto priorities = timings.GetPriorities();
+  ASSERT_EQ(4u, priorities.size());
+  EXPECT_EQ(root, priorities[0].first);
+  EXPECT_EQ(115, priorities[0].second);
+  EXPECT_EQ(a, priorities[1].first);
+  EXPECT_EQ(105, priorities[1].second);
+  EXPECT_EQ(c, priorities[2].first);
+  EXPECT_EQ(50, priorities[2].second);
+  EXPECT_EQ(b, priorities[3].first);
+  EXPECT_EQ(100, priorities[3].second);
+}
+
+TEST(LoadTimings, WriteAndRead) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.GetPath().AppendASCII(LoadTimings::kFileName);
+
+  SourceFile root("//BUILD.gn");
+  SourceFile a("//a/BUILD.gn");
+
+  LoadTimings written;
+  written.RecordLoad(root, SourceFile());
+  written.RecordLoad(a, root);
+  written.AddTime(root, Micros(3));
+  written.AddTime(a, Micros(7));
+  ASSERT_TRUE(written.Write(path));
+
+  LoadTimings read;
+  EXPECT_EQ(0, read.GetPriority(a));
+  ASSERT_TRUE(read.Read(path));
+  EXPECT_EQ(10, read.GetPriority(root));
+  EXPECT_EQ(7, read.GetPriority(a));
+  EXPECT_EQ(0, read.GetPriority(SourceFile("//unknown/BUILD.gn")));
+
+  // A missing file leaves no priorities.
+  EXPECT_FALSE(read.Read(temp_dir.GetPath().AppendASCII("missing")));
+  EXPECT_EQ(0, read.GetPriority(root));
+}
+
+// Files that were cut short or are malformed are ignored as a whole.
+TEST(LoadTimings, ReadRejectsBadFiles) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.GetPath().AppendASCII(LoadTimings::kFileName);
+
+  SourceFile root("//BUILD.gn");
+  SourceFile a("//a/BUILD.gn");
+
+  LoadTimings written;
+  written.RecordLoad(root, SourceFile());
+  written.RecordLoad(a, root);
+  written.AddTime(root, Micros(3));
+  written.AddTime(a, Micros(7));
+  ASSERT_TRUE(written.Write(path));
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  EXPECT_EQ("10 //BUILD.gn\n7 //a/BUILD.gn\nend 2\n", contents);
+
+  LoadTimings read;
+  for (const char* bad : {
+           "",
+           "10 //BUILD.gn\n7 //a/BUI",                  // Truncated.
+           "10 //BUILD.gn\n7 //a/BUILD.gn\n",           // No end marker.
+           "10 //BUILD.gn\nend 2\n",                    // Wrong count.
+           "10 //BUILD.gn\n-7 //a/BUILD.gn\nend 2\n",   // Negative priority.
+           "10 //BUILD.gn\n7 a/BUILD.gn\nend 2\n",      // Not source-absolute.
+       }) {
+    int size = static_cast<int>(strlen(bad));
+    ASSERT_EQ(size, base::WriteFile(path, bad, size));
+    EXPECT_FALSE(read.Read(path)) << bad;
+    EXPECT_EQ(0, read.GetPriority(root)) << bad;
+  }
+}
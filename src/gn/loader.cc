@@ -9,6 +9,7 @@
 #include "gn/build_settings.h"
 #include "gn/err.h"
 #include "gn/filesystem_utils.h"
+#include "gn/input_file.h"
 #include "gn/input_file_manager.h"
 #include "gn/parse_tree.h"
 #include "gn/scheduler.h"
@@ -17,15 +18,19 @@
 #include "gn/source_dir.h"
 #include "gn/source_file.h"
 #include "gn/trace.h"
+#include "util/ticks.h"
 
 namespace {
 
 struct SourceFileAndOrigin {
-  SourceFileAndOrigin(const SourceFile& f, const LocationRange& o)
-      : file(f), origin(o) {}
+  SourceFileAndOrigin(const SourceFile& f,
+                      const LocationRange& o,
+                      const SourceFile& p)
+      : file(f), origin(o), parent(p) {}
 
   SourceFile file;
   LocationRange origin;
+  SourceFile parent;
 };
 
 }  // namespace
@@ -81,8 +86,10 @@ Loader::Loader() = default;
 
 Loader::~Loader() = default;
 
-void Loader::Load(const Label& label, const LocationRange& origin) {
-  Load(BuildFileForLabel(label), origin, label.GetToolchainLabel());
+void Loader::Load(const Label& label,
+                  const LocationRange& origin,
+                  const SourceFile& parent) {
+  Load(BuildFileForLabel(label), origin, label.GetToolchainLabel(), parent);
 }
 
 // -----------------------------------------------------------------------------
@@ -98,7 +105,8 @@ LoaderImpl::~LoaderImpl() = default;
 
 void LoaderImpl::Load(const SourceFile& file,
                       const LocationRange& origin,
-                      const Label& in_toolchain_name) {
+                      const Label& in_toolchain_name,
+                      const SourceFile& parent) {
   const Label& toolchain_name = in_toolchain_name.is_null()
                                     ? default_toolchain_label_
                                     : in_toolchain_name;
@@ -122,7 +130,7 @@ void LoaderImpl::Load(const SourceFile& file,
     // toolchain name is.
     record->is_toolchain_loaded = true;
 
-    record->waiting_on_me.push_back(SourceFileAndOrigin(file, origin));
+    record->waiting_on_me.push_back(SourceFileAndOrigin(file, origin, parent));
     ScheduleLoadBuildConfig(&record->settings, Scope::KeyValueMap());
 
     return;
@@ -145,13 +153,14 @@ void LoaderImpl::Load(const SourceFile& file,
     toolchain_records_[toolchain_name] = std::move(new_record);
 
     // Schedule a load of the toolchain using the default one.
-    Load(BuildFileForLabel(toolchain_name), origin, default_toolchain_label_);
+    Load(BuildFileForLabel(toolchain_name), origin, default_toolchain_label_,
+         parent);
   }
 
   if (record->is_config_loaded)
-    ScheduleLoadFile(&record->settings, origin, file);
+    ScheduleLoadFile(&record->settings, origin, file, parent);
   else
-    record->waiting_on_me.push_back(SourceFileAndOrigin(file, origin));
+    record->waiting_on_me.push_back(SourceFileAndOrigin(file, origin, parent));
 }
 
 void LoaderImpl::ToolchainLoaded(const Toolchain* toolchain) {
@@ -204,9 +213,11 @@ SourceFile LoaderImpl::BuildFileForLabel(const Label& label) const {
 
 void LoaderImpl::ScheduleLoadFile(const Settings* settings,
                                   const LocationRange& origin,
-                                  const SourceFile& file) {
+                                  const SourceFile& file,
+                                  const SourceFile& parent) {
   Err err;
   pending_loads_++;
+  g_scheduler->load_timings()->RecordLoad(file, parent);
   if (!AsyncLoadFile(
           origin, settings->build_settings(), file,
           [this, settings, file, origin](const ParseNode* parse_node) {
@@ -262,6 +273,7 @@ void LoaderImpl::BackgroundLoadFile(const Settings* settings,
   ScopedTrace trace(TraceItem::TRACE_FILE_EXECUTE, file_name.value());
   trace.SetToolchain(settings->toolchain_label());
 
+  ElapsedTimer timer;
   Err err;
   root->Execute(&our_scope, &err);
   if (!err.has_error())
@@ -282,6 +294,7 @@ void LoaderImpl::BackgroundLoadFile(const Settings* settings,
     settings->build_settings()->ItemDefined(std::move(item));
 
   trace.Done();
+  g_scheduler->load_timings()->AddTime(file_name, timer.Elapsed());
 
   task_runner_->PostTask([this]() { DidLoadFile(); });
 }
@@ -421,7 +434,8 @@ void LoaderImpl::DidLoadBuildConfig(const Label& label) {
 
   // Schedule all waiting file loads.
   for (const auto& waiting : record->waiting_on_me)
-    ScheduleLoadFile(&record->settings, waiting.origin, waiting.file);
+    ScheduleLoadFile(&record->settings, waiting.origin, waiting.file,
+                     waiting.parent);
   record->waiting_on_me.clear();
 
   DecrementPendingLoads();
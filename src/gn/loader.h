@@ -34,10 +34,12 @@ class Loader : public base::RefCountedThreadSafe<Loader> {
   // Loads the given file in the conext of the given toolchain. The initial
   // call to this (the one that actually starts the generation) should have an
   // empty toolchain name, which will trigger the load of the default build
-  // config.
+  // config. |parent| is the build file whose items required this one, or null
+  // for the root, and is only used for the load timings.
   virtual void Load(const SourceFile& file,
                     const LocationRange& origin,
-                    const Label& toolchain_name) = 0;
+                    const Label& toolchain_name,
+                    const SourceFile& parent) = 0;
 
   // Notification that the given toolchain has loaded. This will unblock files
   // waiting on this definition.
@@ -55,7 +57,9 @@ class Loader : public base::RefCountedThreadSafe<Loader> {
 
   // Helper function that extracts the file and toolchain name from the given
   // label, and calls Load().
-  void Load(const Label& label, const LocationRange& origin);
+  void Load(const Label& label,
+            const LocationRange& origin,
+            const SourceFile& parent);
 
   // When processing the default build config, we want to capture the argument
   // of set_default_build_config. The implementation of that function uses this
@@ -83,7 +87,8 @@ class LoaderImpl : public Loader {
   // Loader implementation.
   void Load(const SourceFile& file,
             const LocationRange& origin,
-            const Label& toolchain_name) override;
+            const Label& toolchain_name,
+            const SourceFile& parent) override;
   void ToolchainLoaded(const Toolchain* toolchain) override;
   Label GetDefaultToolchain() const override;
   const Settings* GetToolchainSettings(const Label& label) const override;
@@ -125,7 +130,8 @@ class LoaderImpl : public Loader {
   // Schedules the input file manager to load the given file.
   void ScheduleLoadFile(const Settings* settings,
                         const LocationRange& origin,
-                        const SourceFile& file);
+                        const SourceFile& file,
+                        const SourceFile& parent);
   void ScheduleLoadBuildConfig(Settings* settings,
                                const Scope::KeyValueMap& toolchain_overrides);
 
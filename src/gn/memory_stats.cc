@@ -0,0 +1,256 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/memory_stats.h"
+
+#include <stddef.h>
+
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "gn/builder.h"
+#include "gn/builder_record.h"
+#include "gn/config.h"
+#include "gn/config_value_list.h"
+#include "gn/input_file_manager.h"
+#include "gn/label_id.h"
+#include "gn/string_atom.h"
+#include "gn/target.h"
+#include "util/build_config.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+bool memory_stats_enabled = false;
+
+struct Counter {
+  std::atomic<int64_t> objects{0};
+  std::atomic<int64_t> bytes{0};
+  std::atomic<int64_t> peak_bytes{0};
+};
+
+Counter counters[static_cast<size_t>(MemoryCounter::NUM_COUNTERS)];
+
+const char* kCounterNames[] = {
+    "Parse nodes",
+    "Scopes",
+    "Scope values",
+    "Writer buffers",
+};
+static_assert(std::size(kCounterNames) ==
+                  static_cast<size_t>(MemoryCounter::NUM_COUNTERS),
+              "Every counter needs a name");
+
+struct OwnerStats {
+  std::string name;
+  int64_t objects;
+  int64_t bytes;  // -1 when only objects are counted.
+  int64_t peak_bytes;
+};
+
+struct PhaseStats {
+  std::string name;
+  uint64_t peak_rss;
+  std::vector<OwnerStats> owners;
+};
+
+std::mutex phases_lock;
+std::vector<PhaseStats>* phases = nullptr;
+
+// Returns the peak resident set size of the process in bytes, or 0 if it's
+// not known.
+uint64_t GetPeakRss() {
+#if defined(OS_WIN)
+  PROCESS_MEMORY_COUNTERS info;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info)))
+    return 0;
+  return info.PeakWorkingSetSize;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OS_MACOSX)
+  return usage.ru_maxrss;  // Already in bytes.
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+double ToMegabytes(int64_t bytes) {
+  return bytes / (1024.0 * 1024.0);
+}
+
+}  // namespace
+
+void EnableMemoryStats() {
+  memory_stats_enabled = true;
+}
+
+bool MemoryStatsEnabled() {
+  return memory_stats_enabled;
+}
+
+void CountMemory(MemoryCounter counter, int64_t objects, int64_t bytes) {
+  if (!memory_stats_enabled)
+    return;
+
+  Counter& c = counters[static_cast<size_t>(counter)];
+  c.objects.fetch_add(objects, std::memory_order_relaxed);
+  int64_t total = c.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  int64_t peak = c.peak_bytes.load(std::memory_order_relaxed);
+  while (total > peak &&
+         !c.peak_bytes.compare_exchange_weak(peak, total,
+                                             std::memory_order_relaxed)) {
+  }
+}
+
+void GetMemoryCounter(MemoryCounter counter, int64_t* objects, int64_t* bytes) {
+  const Counter& c = counters[static_cast<size_t>(counter)];
+  *objects = c.objects.load(std::memory_order_relaxed);
+  *bytes = c.bytes.load(std::memory_order_relaxed);
+}
+
+void RecordMemoryPhase(const char* phase,
+                       const InputFileManager* input_file_manager,
+                       const Builder* builder) {
+  if (!memory_stats_enabled)
+    return;
+
+  PhaseStats stats;
+  stats.name = phase;
+  stats.peak_rss = GetPeakRss();
+
+  if (input_file_manager) {
+    size_t files = 0;
+    size_t bytes = 0;
+    input_file_manager->GetMemoryStats(&files, &bytes);
+    stats.owners.push_back({"Input files and tokens",
+                            static_cast<int64_t>(files),
+                            static_cast<int64_t>(bytes),
+                            static_cast<int64_t>(bytes)});
+  }
+
+  size_t atoms = 0;
+  size_t atom_bytes = 0;
+  StringAtom::GetTableStats(&atoms, &atom_bytes);
+  stats.owners.push_back({"StringAtom table", static_cast<int64_t>(atoms),
+                          static_cast<int64_t>(atom_bytes),
+                          static_cast<int64_t>(atom_bytes)});
+
+  size_t labels = 0;
+  size_t label_bytes = 0;
+  LabelId::GetTableStats(&labels, &label_bytes);
+  stats.owners.push_back({"Label table", static_cast<int64_t>(labels),
+                          static_cast<int64_t>(label_bytes),
+                          static_cast<int64_t>(label_bytes)});
+
+  size_t lists = 0;
+  size_t list_bytes = 0;
+  ConfigValueList<std::string>::GetTableStats(&lists, &list_bytes);
+  size_t dir_lists = 0;
+  size_t dir_list_bytes = 0;
+  ConfigValueList<SourceDir>::GetTableStats(&dir_lists, &dir_list_bytes);
+  lists += dir_lists;
+  list_bytes += dir_list_bytes;
+  stats.owners.push_back({"Config value lists", static_cast<int64_t>(lists),
+                          static_cast<int64_t>(list_bytes),
+                          static_cast<int64_t>(list_bytes)});
+
+  if (builder) {
+    std::vector<const BuilderRecord*> records = builder->GetAllRecords();
+    int64_t targets = 0;
+    int64_t target_bytes = 0;
+    int64_t configs = 0;
+    for (const BuilderRecord* record : records) {
+      if (!record->item())
+        continue;
+      if (const Target* target = record->item()->AsTarget()) {
+        targets++;
+        target_bytes += target->GetLayoutSize();
+      } else if (record->item()->AsConfig()) {
+        configs++;
+      }
+    }
+    int64_t record_bytes = records.size() * sizeof(BuilderRecord);
+    int64_t config_bytes = configs * sizeof(Config);
+    stats.owners.push_back({"Builder records",
+                            static_cast<int64_t>(records.size()), record_bytes,
+                            record_bytes});
+    stats.owners.push_back({"Targets", targets, target_bytes, target_bytes});
+    stats.owners.push_back({"Configs", configs, config_bytes, config_bytes});
+  }
+
+  // The counters report their peak since the previous phase. Parse nodes
+  // vary in size so only their number is counted.
+  for (size_t i = 0; i < std::size(counters); i++) {
+    Counter& c = counters[i];
+    int64_t bytes = c.bytes.load(std::memory_order_relaxed);
+    int64_t peak_bytes = c.peak_bytes.exchange(bytes);
+    if (i == static_cast<size_t>(MemoryCounter::PARSE_NODES))
+      bytes = peak_bytes = -1;
+    stats.owners.push_back({kCounterNames[i],
+                            c.objects.load(std::memory_order_relaxed), bytes,
+                            peak_bytes});
+  }
+
+  std::lock_guard<std::mutex> lock(phases_lock);
+  if (!phases)
+    phases = new std::vector<PhaseStats>;
+  phases->push_back(std::move(stats));
+}
+
+std::string SummarizeMemoryStats() {
+  if (!memory_stats_enabled)
+    return std::string();
+
+  std::ostringstream out;
+  std::lock_guard<std::mutex> lock(phases_lock);
+  if (!phases)
+    return std::string();
+
+  for (const PhaseStats& phase : *phases) {
+    out << base::StringPrintf("Memory after %s: peak RSS %.2f MB\n",
+                              phase.name.c_str(),
+                              ToMegabytes(phase.peak_rss));
+    out << "  (objects, MB, peak MB during phase, owner)\n";
+    for (const OwnerStats& owner : phase.owners) {
+      out << base::StringPrintf(" %10lld  ",
+                                static_cast<long long>(owner.objects));
+      if (owner.bytes < 0) {
+        out << "        -          -  ";
+      } else {
+        out << base::StringPrintf("%9.2f  %9.2f  ", ToMegabytes(owner.bytes),
+                                  ToMegabytes(owner.peak_bytes));
+      }
+      out << owner.name << std::endl;
+    }
+    out << std::endl;
+  }
+  return out.str();
+}
+
+void ResetMemoryStatsForTesting() {
+  memory_stats_enabled = false;
+  for (Counter& c : counters) {
+    c.objects = 0;
+    c.bytes = 0;
+    c.peak_bytes = 0;
+  }
+
+  std::lock_guard<std::mutex> lock(phases_lock);
+  delete phases;
+  phases = nullptr;
+}
@@ -0,0 +1,62 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_MEMORY_STATS_H_
+#define TOOLS_GN_MEMORY_STATS_H_
+
+#include <stdint.h>
+
+#include <string>
+
+class Builder;
+class InputFileManager;
+
+// Memory accounting for --memstats.
+//
+// Objects that come and go during a run are counted as they are created and
+// destroyed with CountMemory(). Owners that keep their memory for the whole
+// run are instead measured each time a phase is recorded. Byte counts are
+// estimates of the memory directly held by each owner.
+
+enum class MemoryCounter {
+  PARSE_NODES,
+  SCOPES,
+  SCOPE_VALUES,
+  WRITER_BUFFERS,
+
+  NUM_COUNTERS,
+};
+
+// Call to turn memory stats on. It's off by default, and must be enabled
+// before any of the counted objects are created.
+void EnableMemoryStats();
+
+// Returns whether memory stats are enabled.
+bool MemoryStatsEnabled();
+
+// Adjusts the given counter by the given number of objects and bytes, which
+// are negative when objects are freed. Does nothing unless memory stats are
+// enabled.
+void CountMemory(MemoryCounter counter, int64_t objects, int64_t bytes);
+
+// Returns the current number of objects and bytes of the given counter.
+void GetMemoryCounter(MemoryCounter counter, int64_t* objects, int64_t* bytes);
+
+// Records the peak RSS of the process and the memory held by the major owners
+// at the end of the given phase. Either of the pointers may be null if the
+// corresponding owner doesn't exist yet. Must not be called while other
+// threads are loading files or defining items.
+void RecordMemoryPhase(const char* phase,
+                       const InputFileManager* input_file_manager,
+                       const Builder* builder);
+
+// Returns a report of the recorded phases, or the empty string if memory
+// stats are not enabled.
+std::string SummarizeMemoryStats();
+
+// Turns memory stats off, zeroes the counters and drops the recorded phases.
+// Must not be called while other threads may be counting memory.
+void ResetMemoryStatsForTesting();
+
+#endif  // TOOLS_GN_MEMORY_STATS_H_
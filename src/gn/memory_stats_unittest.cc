@@ -0,0 +1,80 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/memory_stats.h"
+
+#include <string>
+
+#include "gn/string_output_buffer.h"
+#include "util/test/test.h"
+
+namespace {
+
+class MemoryStatsTest : public testing::Test {
+ public:
+  void SetUp() override { EnableMemoryStats(); }
+  void TearDown() override { ResetMemoryStatsForTesting(); }
+};
+
+}  // namespace
+
+TEST_F(MemoryStatsTest, RecordsPhases) {
+  EXPECT_TRUE(MemoryStatsEnabled());
+
+  // Objects made by earlier tests may be freed while this one runs, so the
+  // counts are checked relative to where they started.
+  int64_t start_pages = 0;
+  int64_t start_bytes = 0;
+  GetMemoryCounter(MemoryCounter::WRITER_BUFFERS, &start_pages, &start_bytes);
+
+  RecordMemoryPhase("memstats test start", nullptr, nullptr);
+  const size_t page_size = StringOutputBuffer::GetPageSizeForTesting();
+  {
+    StringOutputBuffer buffer;
+    buffer.Append(std::string(page_size * 2, 'x'));
+    RecordMemoryPhase("memstats test write", nullptr, nullptr);
+
+    int64_t pages = 0;
+    int64_t bytes = 0;
+    GetMemoryCounter(MemoryCounter::WRITER_BUFFERS, &pages, &bytes);
+    EXPECT_EQ(2, pages - start_pages);
+    EXPECT_EQ(static_cast<int64_t>(page_size * 2), bytes - start_bytes);
+  }
+
+  int64_t pages = 0;
+  int64_t bytes = 0;
+  GetMemoryCounter(MemoryCounter::WRITER_BUFFERS, &pages, &bytes);
+  EXPECT_EQ(start_pages, pages);
+  EXPECT_EQ(start_bytes, bytes);
+
+  std::string summary = SummarizeMemoryStats();
+  EXPECT_NE(std::string::npos,
+            summary.find("Memory after memstats test start: peak RSS"))
+      << summary;
+  EXPECT_NE(std::string::npos,
+            summary.find("Memory after memstats test write: peak RSS"))
+      << summary;
+  EXPECT_NE(std::string::npos, summary.find("  StringAtom table\n"))
+      << summary;
+  EXPECT_NE(std::string::npos, summary.find("  Writer buffers\n")) << summary;
+}
+
+TEST_F(MemoryStatsTest, Reset) {
+  CountMemory(MemoryCounter::SCOPES, 1, 100);
+  RecordMemoryPhase("memstats test reset", nullptr, nullptr);
+
+  ResetMemoryStatsForTesting();
+  EXPECT_FALSE(MemoryStatsEnabled());
+  EXPECT_EQ(std::string(), SummarizeMemoryStats());
+
+  int64_t objects = -1;
+  int64_t bytes = -1;
+  GetMemoryCounter(MemoryCounter::SCOPES, &objects, &bytes);
+  EXPECT_EQ(0, objects);
+  EXPECT_EQ(0, bytes);
+
+  // The phases recorded before the reset are gone once stats are back on.
+  EnableMemoryStats();
+  EXPECT_EQ(std::string(), SummarizeMemoryStats());
+}
@@ -22,7 +22,20 @@ NinjaActionTargetWriter::NinjaActionTargetWriter(const Target* target,
       path_output_no_escaping_(
           target->settings()->build_settings()->build_dir(),
           target->settings()->build_settings()->root_path_utf8(),
-          ESCAPE_NONE) {}
+          ESCAPE_NONE),
+      source_evaluator_(target,
+                        target->settings(),
+                        SubstitutionWriter::OUTPUT_ABSOLUTE,
+                        SourceDir()),
+      outputs_program_(
+          source_evaluator_.Compile(target->action_values().outputs())),
+      depfile_program_(
+          source_evaluator_.Compile(target->action_values().depfile())),
+      ninja_variables_evaluator_(
+          target,
+          target->settings(),
+          SubstitutionWriter::OUTPUT_RELATIVE,
+          target->settings()->build_settings()->build_dir()) {}
 
 NinjaActionTargetWriter::~NinjaActionTargetWriter() = default;
 
@@ -258,12 +271,11 @@ void NinjaActionTargetWriter::WriteSourceRules(
     // used in both the args and the response file. However, this should be
     // very unusual (normally the substitutions will go in one place or the
     // other) and the redundant assignment won't bother Ninja.
-    SubstitutionWriter::WriteNinjaVariablesForSource(
-        target_, settings_, sources[i],
-        target_->action_values().args().required_types(), args_escape_options,
-        out_);
-    SubstitutionWriter::WriteNinjaVariablesForSource(
-        target_, settings_, sources[i],
+    ninja_variables_evaluator_.WriteNinjaVariablesForSource(
+        sources[i], target_->action_values().args().required_types(),
+        args_escape_options, out_);
+    ninja_variables_evaluator_.WriteNinjaVariablesForSource(
+        sources[i],
         target_->action_values().rsp_file_contents().required_types(),
         args_escape_options, out_);
     WriteNinjaVariablesForAction();
@@ -285,9 +297,8 @@ void NinjaActionTargetWriter::WriteOutputFilesForBuildLine(
     std::vector<OutputFile>* output_files) {
   size_t first_output_index = output_files->size();
 
-  SubstitutionWriter::ApplyListToSourceAsOutputFile(
-      target_, settings_, target_->action_values().outputs(), source,
-      output_files);
+  source_evaluator_.ApplyToSourceAsOutputFile(outputs_program_, source,
+                                              output_files);
 
   for (size_t i = first_output_index; i < output_files->size(); i++) {
     out_ << " ";
@@ -299,8 +310,7 @@ void NinjaActionTargetWriter::WriteDepfile(const SourceFile& source) {
   out_ << "  depfile = ";
   path_output_.WriteFile(
       out_,
-      SubstitutionWriter::ApplyPatternToSourceAsOutputFile(
-          target_, settings_, target_->action_values().depfile(), source));
+      source_evaluator_.ApplyToSourceAsOutputFile(depfile_program_, source));
   out_ << std::endl;
   // Using "deps = gcc" allows Ninja to read and store the depfile content in
   // its internal database which improves performance, especially for large
@@ -9,6 +9,7 @@
 
 #include "base/gtest_prod_util.h"
 #include "gn/ninja_target_writer.h"
+#include "gn/substitution_evaluator.h"
 
 class OutputFile;
 
@@ -60,6 +61,16 @@ class NinjaActionTargetWriter : public NinjaTargetWriter {
   // computing intermediate strings.
   PathOutput path_output_no_escaping_;
 
+  // Apply the output and depfile patterns to the sources of action_foreach
+  // targets, compiled once for all the sources.
+  SubstitutionEvaluator source_evaluator_;
+  std::vector<SubstitutionEvaluator::Program> outputs_program_;
+  SubstitutionEvaluator::Program depfile_program_;
+
+  // Computes the values of the source variables, which are relative to the
+  // build directory.
+  SubstitutionEvaluator ninja_variables_evaluator_;
+
   NinjaActionTargetWriter(const NinjaActionTargetWriter&) = delete;
   NinjaActionTargetWriter& operator=(const NinjaActionTargetWriter&) = delete;
 };
@@ -46,6 +46,7 @@ void NinjaBinaryTargetWriter::Run() {
     NinjaRustBinaryTargetWriter writer(target_, out_);
     writer.SetResolvedTargetData(GetResolvedTargetData());
     writer.SetNinjaOutputs(ninja_outputs_);
+    writer.SetFlagsCache(flags_cache_);
     writer.Run();
     return;
   }
@@ -53,6 +54,7 @@ void NinjaBinaryTargetWriter::Run() {
   NinjaCBinaryTargetWriter writer(target_, out_);
   writer.SetResolvedTargetData(GetResolvedTargetData());
   writer.SetNinjaOutputs(ninja_outputs_);
+  writer.SetFlagsCache(flags_cache_);
   writer.Run();
 }
 
@@ -120,6 +122,8 @@ NinjaBinaryTargetWriter::WriteInputsStampOrPhonyAndGetDep(
   }
 
   out_ << std::endl;
+  if (tool != BuiltinTool::kBuiltinToolPhony)
+    WriteFileVariablesForStep();
   return {stamp_or_phony};
 }
 
@@ -293,6 +297,7 @@ void NinjaBinaryTargetWriter::WriteCompilerBuildLine(
     path_output_.WriteFiles(out_, order_only_deps);
   }
   out_ << std::endl;
+  WriteFileVariablesForStep();
 
   if (!sources.empty() && can_write_source_info) {
     out_ << "  " << "source_file_part = " << sources[0].GetName();
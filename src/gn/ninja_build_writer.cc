@@ -17,6 +17,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "gn/build_settings.h"
 #include "gn/builder.h"
+#include "gn/dry_run.h"
 #include "gn/err.h"
 #include "gn/escape.h"
 #include "gn/filesystem_utils.h"
@@ -106,9 +107,10 @@ base::CommandLine GetSelfInvocationCommandLine(
     // Only write arguments we haven't already written. Always skip "args"
     // since those will have been written to the file and will be used
     // implicitly in the future. Keeping --args would mean changes to the file
-    // would be ignored.
+    // would be ignored. --dry-run only makes sense for manual invocations.
     if (i->first != switches::kQuiet && i->first != switches::kRoot &&
-        i->first != switches::kDotfile && i->first != switches::kArgs) {
+        i->first != switches::kDotfile && i->first != switches::kArgs &&
+        i->first != kDryRunSwitch) {
       std::string escaped_value =
           EscapeString(FilePathToUTF8(i->second), escape_shell, nullptr);
       cmdline.AppendSwitch(i->first, escaped_value);
@@ -262,12 +264,23 @@ bool NinjaBuildWriter::RunAndWriteFile(const BuildSettings* build_settings,
   if (!gen.Run(err))
     return false;
 
+  base::FilePath ninja_file_name(build_settings->GetFullPath(
+      SourceFile(build_settings->build_dir().value() + "build.ninja")));
+  base::FilePath dep_file_name(build_settings->GetFullPath(
+      SourceFile(build_settings->build_dir().value() + "build.ninja.d")));
+  base::FilePath stamp_file_name(build_settings->GetFullPath(
+      SourceFile(build_settings->build_dir().value() + "build.ninja.stamp")));
+  if (DryRunEnabled()) {
+    RecordDryRunWrite(ninja_file_name, file.str());
+    RecordDryRunWrite(dep_file_name, depfile.str());
+    RecordDryRunWrite(stamp_file_name, std::string_view());
+    return true;
+  }
+
   // Unconditionally write the build.ninja. Ninja's build-out-of-date
   // checking will re-run GN when any build input is newer than build.ninja, so
   // any time the build is updated, build.ninja's timestamp needs to updated
   // also, even if the contents haven't been changed.
-  base::FilePath ninja_file_name(build_settings->GetFullPath(
-      SourceFile(build_settings->build_dir().value() + "build.ninja")));
   base::CreateDirectory(ninja_file_name.DirName());
   std::string ninja_contents = file.str();
   if (util::WriteFileAtomically(ninja_file_name, ninja_contents.data(),
@@ -278,8 +291,6 @@ bool NinjaBuildWriter::RunAndWriteFile(const BuildSettings* build_settings,
   }
 
   // Dep file listing build dependencies.
-  base::FilePath dep_file_name(build_settings->GetFullPath(
-      SourceFile(build_settings->build_dir().value() + "build.ninja.d")));
   std::string dep_contents = depfile.str();
   if (util::WriteFileAtomically(dep_file_name, dep_contents.data(),
                                 static_cast<int>(dep_contents.size())) !=
@@ -291,9 +302,6 @@ bool NinjaBuildWriter::RunAndWriteFile(const BuildSettings* build_settings,
   // Finally, write the empty build.ninja.stamp file. This is the output
   // expected by the first of the two ninja rules used to accomplish
   // regeneration.
-
-  base::FilePath stamp_file_name(build_settings->GetFullPath(
-      SourceFile(build_settings->build_dir().value() + "build.ninja.stamp")));
   std::string stamp_contents;
   if (util::WriteFileAtomically(stamp_file_name, stamp_contents.data(),
                                 static_cast<int>(stamp_contents.size())) !=
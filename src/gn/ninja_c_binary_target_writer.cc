@@ -132,7 +132,9 @@ void NinjaCBinaryTargetWriter::Run() {
   std::vector<ModuleDep> module_dep_info =
       GetModuleDepsInformation(target_, resolved());
 
+  BeginFileVariables();
   WriteCompilerVars(module_dep_info);
+  EndFileVariables();
 
   size_t num_output_uses = target_->sources().size();
 
@@ -694,6 +696,7 @@ void NinjaCBinaryTargetWriter::WriteLinkerStuff(
 
   // End of the link "build" line.
   out_ << std::endl;
+  WriteFileVariablesForStep();
 
   // The remaining things go in the inner scope of the link line.
   if (target_->output_type() == Target::EXECUTABLE ||
@@ -8,7 +8,9 @@
 #include <sstream>
 #include <utility>
 
+#include "gn/c_substitution_type.h"
 #include "gn/config.h"
+#include "gn/ninja_flags_cache.h"
 #include "gn/ninja_target_command_util.h"
 #include "gn/pool.h"
 #include "gn/scheduler.h"
@@ -2814,3 +2816,191 @@ TEST_F(NinjaCBinaryTargetWriterTest, Pool) {
   std::string out_str = out.str();
   EXPECT_EQ(expected, out_str) << expected << "\n" << out_str;
 }
+
+// Tests that targets with the same configs share the rendered flags.
+TEST_F(NinjaCBinaryTargetWriterTest, FlagsCache) {
+  Err err;
+  TestWithScope setup;
+
+  Config config(setup.settings(), Label(SourceDir("//foo/"), "config"));
+  config.visibility().SetPublic();
+  config.own_values().defines().push_back("FOO");
+  config.own_values().include_dirs().push_back(SourceDir("//foo/include/"));
+  config.own_values().cflags_cc().push_back("-fno-rtti");
+  config.own_values().Intern();
+  ASSERT_TRUE(config.OnResolved(&err));
+
+  Target first(setup.settings(), Label(SourceDir("//foo/"), "first"));
+  Target second(setup.settings(), Label(SourceDir("//foo/"), "second"));
+  for (Target* target : {&first, &second}) {
+    target->set_output_type(Target::SOURCE_SET);
+    target->visibility().SetPublic();
+    target->sources().push_back(SourceFile("//foo/input.cc"));
+    target->source_types_used().Set(SourceFile::SOURCE_CPP);
+    target->configs().push_back(LabelConfigPair(&config));
+    target->SetToolchain(setup.toolchain());
+    ASSERT_TRUE(target->OnResolved(&err));
+  }
+
+  // Not interned, so never cached.
+  Target third(setup.settings(), Label(SourceDir("//foo/"), "third"));
+  third.set_output_type(Target::SOURCE_SET);
+  third.visibility().SetPublic();
+  third.sources().push_back(SourceFile("//foo/input.cc"));
+  third.source_types_used().Set(SourceFile::SOURCE_CPP);
+  third.configs().push_back(LabelConfigPair(&config));
+  third.config_values().defines().push_back("BAR");
+  third.SetToolchain(setup.toolchain());
+  ASSERT_TRUE(third.OnResolved(&err));
+
+  NinjaFlagsCache cache;
+  const char expected_flags[] =
+      "defines = -DFOO\n"
+      "include_dirs = -I../../foo/include\n"
+      "cflags =\n"
+      "cflags_cc = -fno-rtti\n";
+  for (const Target* target : {&first, &second}) {
+    std::ostringstream out;
+    NinjaCBinaryTargetWriter writer(target, out);
+    writer.SetFlagsCache(&cache);
+    writer.Run();
+    std::string out_str = out.str();
+    EXPECT_EQ(0u, out_str.find(expected_flags)) << out_str;
+  }
+
+  NinjaFlagsCache::Key key;
+  ASSERT_TRUE(NinjaFlagsCache::MakeKey(&first, &CSubstitutionDefines,
+                                       &ConfigValues::defines, &key));
+  const std::string* defines = cache.Find(key);
+  ASSERT_TRUE(defines);
+  EXPECT_EQ(" -DFOO", *defines);
+
+  EXPECT_FALSE(NinjaFlagsCache::MakeKey(&third, &CSubstitutionDefines,
+                                        &ConfigValues::defines, &key));
+  std::ostringstream out;
+  NinjaCBinaryTargetWriter writer(&third, out);
+  writer.SetFlagsCache(&cache);
+  writer.Run();
+  std::string out_str = out.str();
+  EXPECT_EQ(0u, out_str.find("defines = -DBAR -DFOO\n")) << out_str;
+}
+
+// Tests that the flags can be written as references to shared variables.
+TEST_F(NinjaCBinaryTargetWriterTest, SharedFlags) {
+  Err err;
+  TestWithScope setup;
+  setup.build_settings()->set_ninja_shared_flags(true);
+
+  Config config(setup.settings(), Label(SourceDir("//foo/"), "config"));
+  config.visibility().SetPublic();
+  config.own_values().defines().push_back("A_DEFINE_LONG_ENOUGH_TO_BE_SHARED");
+  config.own_values().defines().push_back("ANOTHER_DEFINE_TO_MAKE_SURE=1");
+  config.own_values().cflags_cc().push_back("-fno-rtti");
+  config.own_values().Intern();
+  ASSERT_TRUE(config.OnResolved(&err));
+
+  Target target(setup.settings(), Label(SourceDir("//foo/"), "bar"));
+  target.set_output_type(Target::SOURCE_SET);
+  target.visibility().SetPublic();
+  target.sources().push_back(SourceFile("//foo/input.cc"));
+  target.source_types_used().Set(SourceFile::SOURCE_CPP);
+  target.configs().push_back(LabelConfigPair(&config));
+  target.SetToolchain(setup.toolchain());
+  ASSERT_TRUE(target.OnResolved(&err));
+
+  NinjaFlagsCache cache;
+  std::ostringstream out;
+  NinjaCBinaryTargetWriter writer(&target, out);
+  writer.SetFlagsCache(&cache);
+  writer.Run();
+
+  std::vector<std::pair<std::string, std::string>> shared =
+      cache.GetSharedVariables(setup.toolchain());
+  ASSERT_EQ(1u, shared.size());
+  EXPECT_EQ(
+      " -DA_DEFINE_LONG_ENOUGH_TO_BE_SHARED -DANOTHER_DEFINE_TO_MAKE_SURE=1",
+      shared[0].second);
+
+  // The short cflags_cc are still written in the target.
+  std::string expected_flags = "defines = $" + shared[0].first +
+                               "\n"
+                               "include_dirs =\n"
+                               "cflags =\n"
+                               "cflags_cc = -fno-rtti\n";
+  std::string out_str = out.str();
+  EXPECT_EQ(0u, out_str.find(expected_flags)) << out_str;
+}
+
+// Tests that sharded targets set their variables on each build step.
+TEST_F(NinjaCBinaryTargetWriterTest, TargetShards) {
+  Err err;
+  TestWithScope setup;
+  setup.build_settings()->set_ninja_target_shards(4);
+
+  Target target(setup.settings(), Label(SourceDir("//foo/"), "bar"));
+  target.set_output_type(Target::SOURCE_SET);
+  target.visibility().SetPublic();
+  target.sources().push_back(SourceFile("//foo/input1.cc"));
+  target.source_types_used().Set(SourceFile::SOURCE_CPP);
+  target.SetToolchain(setup.toolchain());
+  ASSERT_TRUE(target.OnResolved(&err));
+
+  // The rules are returned rather than written to a file of their own.
+  std::string rules = NinjaTargetWriter::RunAndWriteFile(&target);
+  const char expected[] =
+      "build obj/foo/bar.input1.o: cxx ../../foo/input1.cc\n"
+      "  defines =\n"
+      "  include_dirs =\n"
+      "  cflags =\n"
+      "  cflags_cc =\n"
+      "  root_out_dir = .\n"
+      "  target_gen_dir = gen/foo\n"
+      "  target_out_dir = obj/foo\n"
+      "  target_output_name = bar\n"
+      "  source_file_part = input1.cc\n"
+      "  source_name_part = input1\n"
+      "\n"
+      "build phony/foo/bar: phony obj/foo/bar.input1.o\n";
+  EXPECT_EQ(expected, rules) << expected << "\n" << rules;
+
+  // The link step gets the variables too.
+  Target exe(setup.settings(), Label(SourceDir("//foo/"), "exe"));
+  exe.set_output_type(Target::EXECUTABLE);
+  exe.sources().push_back(SourceFile("//foo/main.cc"));
+  exe.source_types_used().Set(SourceFile::SOURCE_CPP);
+  exe.private_deps().push_back(LabelTargetPair(&target));
+  exe.SetToolchain(setup.toolchain());
+  ASSERT_TRUE(exe.OnResolved(&err));
+
+  std::string exe_rules = NinjaTargetWriter::RunAndWriteFile(&exe);
+  const char exe_expected[] =
+      "build obj/foo/exe.main.o: cxx ../../foo/main.cc\n"
+      "  defines =\n"
+      "  include_dirs =\n"
+      "  cflags =\n"
+      "  cflags_cc =\n"
+      "  root_out_dir = .\n"
+      "  target_gen_dir = gen/foo\n"
+      "  target_out_dir = obj/foo\n"
+      "  target_output_name = exe\n"
+      "  source_file_part = main.cc\n"
+      "  source_name_part = main\n"
+      "\n"
+      "build ./exe: link obj/foo/exe.main.o obj/foo/bar.input1.o || "
+      "phony/foo/bar\n"
+      "  defines =\n"
+      "  include_dirs =\n"
+      "  cflags =\n"
+      "  cflags_cc =\n"
+      "  root_out_dir = .\n"
+      "  target_gen_dir = gen/foo\n"
+      "  target_out_dir = obj/foo\n"
+      "  target_output_name = exe\n"
+      "  ldflags =\n"
+      "  libs =\n"
+      "  frameworks =\n"
+      "  swiftmodules =\n"
+      "  output_extension =\n"
+      "  output_dir =\n";
+  EXPECT_EQ(exe_expected, exe_rules) << exe_expected << "\n" << exe_rules;
+}
@@ -10,6 +10,7 @@
 #include "gn/output_file.h"
 #include "gn/scheduler.h"
 #include "gn/string_utils.h"
+#include "gn/substitution_evaluator.h"
 #include "gn/substitution_list.h"
 #include "gn/substitution_writer.h"
 #include "gn/target.h"
@@ -108,10 +109,14 @@ void NinjaCopyTargetWriter::WriteCopyRules(
   // to avoid conflicts. This is also needed for data_deps on a copy target.
   // Such cases should be avoided where possible, but sometimes that's not
   // possible.
+  SubstitutionEvaluator evaluator(target_, target_->settings(),
+                                  SubstitutionWriter::OUTPUT_ABSOLUTE,
+                                  SourceDir());
+  SubstitutionEvaluator::Program output_program =
+      evaluator.Compile(output_subst);
   for (const auto& input_file : target_->sources()) {
     OutputFile output_file =
-        SubstitutionWriter::ApplyPatternToSourceAsOutputFile(
-            target_, target_->settings(), output_subst, input_file);
+        evaluator.ApplyToSourceAsOutputFile(output_program, input_file);
     output_files->push_back(output_file);
 
     out_ << "build ";
@@ -0,0 +1,96 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/ninja_flags_cache.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "base/strings/stringprintf.h"
+#include "gn/string_utils.h"
+#include "gn/substitution_type.h"
+
+namespace {
+
+// Texts shorter than this aren't worth replacing with a variable reference.
+constexpr size_t kMinSharedTextLength = 64;
+
+}  // namespace
+
+NinjaFlagsCache::NinjaFlagsCache() = default;
+
+NinjaFlagsCache::~NinjaFlagsCache() = default;
+
+const std::string* NinjaFlagsCache::Find(const Key& key) const {
+  Shard& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock(shard.lock);
+  auto found = shard.map.find(key);
+  if (found == shard.map.end())
+    return nullptr;
+  // Entries are never modified or removed, so this stays valid.
+  return &found->second;
+}
+
+const std::string& NinjaFlagsCache::Insert(Key key, std::string text) {
+  Shard& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock(shard.lock);
+  return shard.map.emplace(std::move(key), std::move(text)).first->second;
+}
+
+const std::string* NinjaFlagsCache::UseSharedVariable(
+    const Toolchain* toolchain,
+    const Substitution* substitution,
+    const std::string& text) {
+  if (text.size() < kMinSharedTextLength)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(shared_lock_);
+  auto found = shared_texts_.find(&text);
+  if (found == shared_texts_.end()) {
+    // The name only depends on the text so it's the same for all targets and
+    // from one run to the next.
+    std::string name =
+        base::StringPrintf("%s_%016" PRIx64, substitution->ninja_name,
+                           StableHash(text));
+    auto inserted = shared_names_.emplace(std::move(name), &text);
+    const std::string* shared_name = &inserted.first->first;
+    // The same text may be cached under several keys. In the very unlikely
+    // case of a hash collision, the text isn't shared.
+    if (!inserted.second && *inserted.first->second != text)
+      shared_name = nullptr;
+    found = shared_texts_.emplace(&text, shared_name).first;
+  }
+  if (found->second)
+    shared_used_[toolchain].insert(found->second);
+  return found->second;
+}
+
+std::vector<std::pair<std::string, std::string>>
+NinjaFlagsCache::GetSharedVariables(const Toolchain* toolchain) const {
+  std::vector<std::pair<std::string, std::string>> result;
+  std::lock_guard<std::mutex> lock(shared_lock_);
+  auto found = shared_used_.find(toolchain);
+  if (found == shared_used_.end())
+    return result;
+  for (const std::string* name : found->second)
+    result.emplace_back(*name, *shared_names_.at(*name));
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+size_t NinjaFlagsCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = std::hash<const void*>()(key.substitution);
+  for (const void* list : key.lists)
+    hash = hash * 31 + std::hash<const void*>()(list);
+  return hash;
+}
+
+NinjaFlagsCache::Shard& NinjaFlagsCache::GetShard(const Key& key) const {
+  // Mix the bits, pointer hashes are usually the identity.
+  size_t hash = KeyHash()(key);
+  return shards_[(hash ^ (hash >> 16)) % kNumShards];
+}
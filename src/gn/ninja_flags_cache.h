@@ -0,0 +1,132 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_NINJA_FLAGS_CACHE_H_
+#define TOOLS_GN_NINJA_FLAGS_CACHE_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gn/config_values_extractors.h"
+
+struct Substitution;
+class Toolchain;
+
+// Caches the rendered values of the compiler flag variables ("defines",
+// "include_dirs", "cflags"...) written by the ninja target writers.
+//
+// Most targets of a toolchain get their flags from the same stack of configs,
+// so the same escaped text would otherwise be computed for each of them. The
+// text only depends on the lists it's made of, which are immutable and shared
+// once interned (see ConfigValueList), so it's keyed by the addresses of
+// these lists. Targets with lists that aren't interned aren't cached.
+//
+// With the "ninja_shared_flags" .gn option, the cache also names the rendered
+// texts so they can be written once as variables of the toolchain's ninja
+// file and referenced from the target ninja files, see UseSharedVariable().
+//
+// The text of a variable must always be rendered with the same writer and
+// escaping, and paths must be relative to the same build directory. A cache
+// should therefore not outlive the writing of one build directory.
+//
+// Thread-safe.
+class NinjaFlagsCache {
+ public:
+  // Identifies the value of one variable for one target.
+  struct Key {
+    const Substitution* substitution = nullptr;
+    std::vector<const void*> lists;
+
+    bool operator==(const Key& other) const {
+      return substitution == other.substitution && lists == other.lists;
+    }
+  };
+
+  NinjaFlagsCache();
+  ~NinjaFlagsCache();
+
+  // Fills the key identifying the given value of the target. Returns false if
+  // the value can't be cached.
+  template <typename T>
+  static bool MakeKey(const Target* target,
+                      const Substitution* substitution,
+                      const std::vector<T>& (ConfigValues::*getter)() const,
+                      Key* key) {
+    key->substitution = substitution;
+    key->lists.clear();
+    for (ConfigValuesIterator iter(target); !iter.done(); iter.Next()) {
+      if (!iter.cur().is_interned())
+        return false;
+      const std::vector<T>& values = ((iter.cur()).*getter)();
+      // Empty lists don't contribute anything and aren't interned.
+      if (!values.empty())
+        key->lists.push_back(&values);
+    }
+    return true;
+  }
+
+  // Returns the cached text for the key, or null if there is none. The
+  // returned pointer stays valid for the lifetime of the cache.
+  const std::string* Find(const Key& key) const;
+
+  // Adds the text for the key and returns the cached text. If another thread
+  // added it first, that one is returned.
+  const std::string& Insert(Key key, std::string text);
+
+  // Returns the name of a toolchain-level ninja variable holding |text|, which
+  // must have been returned by Find() or Insert() for the given substitution,
+  // and records that the toolchain's ninja file must define it. Returns null
+  // if the text should be written as is, because it's shorter than a
+  // reference to it.
+  const std::string* UseSharedVariable(const Toolchain* toolchain,
+                                       const Substitution* substitution,
+                                       const std::string& text);
+
+  // Returns the shared variables used by the targets of the toolchain as
+  // (name, value) pairs, sorted by name. The values start with a space, like
+  // all rendered texts.
+  std::vector<std::pair<std::string, std::string>> GetSharedVariables(
+      const Toolchain* toolchain) const;
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Shard {
+    std::mutex lock;
+    std::unordered_map<Key, std::string, KeyHash> map;
+  };
+
+  Shard& GetShard(const Key& key) const;
+
+  mutable Shard shards_[kNumShards];
+
+  // Protects the shared variables below.
+  mutable std::mutex shared_lock_;
+
+  // Maps the shared variable names to their text.
+  std::map<std::string, const std::string*> shared_names_;
+
+  // Maps the cached texts to their shared variable name, or null if they
+  // can't be shared.
+  std::unordered_map<const std::string*, const std::string*> shared_texts_;
+
+  // The names of the shared variables used by each toolchain.
+  std::map<const Toolchain*, std::set<const std::string*>> shared_used_;
+
+  NinjaFlagsCache(const NinjaFlagsCache&) = delete;
+  NinjaFlagsCache& operator=(const NinjaFlagsCache&) = delete;
+};
+
+#endif  // TOOLS_GN_NINJA_FLAGS_CACHE_H_
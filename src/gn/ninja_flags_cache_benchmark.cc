@@ -0,0 +1,73 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gn/c_substitution_type.h"
+#include "gn/ninja_flags_cache.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+const size_t kCount = 1000;
+
+// Keys of the flags of |kCount| targets. Each target gets its flags from a
+// stack of three of the lists in |lists|, which stand in for the interned
+// config value lists.
+std::vector<NinjaFlagsCache::Key> MakeKeys(const std::vector<int>& lists) {
+  std::vector<NinjaFlagsCache::Key> keys(kCount);
+  for (size_t i = 0; i < kCount; i++) {
+    keys[i].substitution = &CSubstitutionCFlags;
+    for (size_t j = 0; j < 3; j++)
+      keys[i].lists.push_back(&lists[(i + j * 7) % lists.size()]);
+  }
+  return keys;
+}
+
+// Looks up the flags of the same targets from |thread_count| threads and
+// references them as shared variables, as the ninja target writers do for
+// each target. All the texts are cached up front.
+void RunLookupThreads(benchmark::State& state, size_t thread_count) {
+  std::vector<int> lists(kCount / 4);
+  std::vector<NinjaFlagsCache::Key> keys = MakeKeys(lists);
+  NinjaFlagsCache cache;
+  for (size_t i = 0; i < kCount; i++) {
+    cache.Insert(keys[i],
+                 " -DFLAGS_OF_TARGET_" + std::to_string(i) +
+                     " -Wall -Wextra -Werror -fno-exceptions -fno-rtti");
+  }
+
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; i++) {
+      threads.emplace_back([&keys, &cache]() {
+        for (const NinjaFlagsCache::Key& key : keys) {
+          const std::string* text = cache.Find(key);
+          // The toolchain is only used to group the variables.
+          benchmark::DoNotOptimize(
+              cache.UseSharedVariable(nullptr, key.substitution, *text));
+        }
+      });
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  state.SetItemsProcessed(state.iterations() * thread_count * kCount);
+}
+
+}  // namespace
+
+BENCHMARK(NinjaFlagsCache_Lookup_1Thread) {
+  RunLookupThreads(state, 1);
+}
+
+BENCHMARK(NinjaFlagsCache_Lookup_4Threads) {
+  RunLookupThreads(state, 4);
+}
+
+BENCHMARK(NinjaFlagsCache_Lookup_16Threads) {
+  RunLookupThreads(state, 16);
+}
@@ -12,6 +12,7 @@
 #include "base/json/string_escape.h"
 #include "gn/builder.h"
 #include "gn/commands.h"
+#include "gn/dry_run.h"
 #include "gn/filesystem_utils.h"
 #include "gn/invoke_python.h"
 #include "gn/settings.h"
@@ -134,7 +135,8 @@ bool NinjaOutputsWriter::RunAndWriteFiles(
       return false;
     }
 
-    if (!exec_script.empty()) {
+    // The script would read the file, which isn't written in a dry run.
+    if (!exec_script.empty() && !DryRunEnabled()) {
       SourceFile script_file;
       if (exec_script[0] != '/') {
         // Relative path, assume the base is in build_dir.
@@ -113,10 +113,19 @@ void NinjaRustBinaryTargetWriter::Run() {
 
   size_t num_output_uses = target_->sources().size();
 
+  // Targets written to a shard need their variables before the first build
+  // step.
+  if (WritesToShard()) {
+    BeginFileVariables();
+    WriteCompilerVars();
+    EndFileVariables();
+  }
+
   std::vector<OutputFile> input_deps =
       WriteInputsStampOrPhonyAndGetDep(num_output_uses);
 
-  WriteCompilerVars();
+  if (!WritesToShard())
+    WriteCompilerVars();
 
   // Classify our dependencies.
   ClassifiedDeps classified_deps = GetClassifiedDeps();
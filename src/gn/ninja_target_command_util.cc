@@ -52,7 +52,8 @@ void WriteOneFlag(RecursiveWriterConfig config,
                   PathOutput& path_output,
                   std::ostream& out,
                   bool write_substitution,
-                  bool indent) {
+                  bool indent,
+                  NinjaFlagsCache* cache) {
   if (!target->toolchain()->substitution_bits().used.count(subst_enum))
     return;
 
@@ -61,6 +62,16 @@ void WriteOneFlag(RecursiveWriterConfig config,
   if (write_substitution)
     out << subst_enum->ninja_name << " =";
 
+  auto write_flags = [&]() {
+    WriteCachedFlags(
+        cache, target, subst_enum, getter,
+        [&](std::ostream& flags_out) {
+          RecursiveTargetConfigStringsToStream(config, target, getter,
+                                               flag_escape_options, flags_out);
+        },
+        out);
+  };
+
   if (has_precompiled_headers) {
     const CTool* tool = target->toolchain()->GetToolAsC(tool_name);
     if (tool && tool->precompiled_header_type() == CTool::PCH_MSVC) {
@@ -71,16 +82,14 @@ void WriteOneFlag(RecursiveWriterConfig config,
       // Enables precompiled headers and names the .h file. It's a string
       // rather than a file name (so no need to rebase or use path_output).
       out << " /Yu" << target->config_values().precompiled_header();
-      RecursiveTargetConfigStringsToStream(config, target, getter,
-                                           flag_escape_options, out);
+      write_flags();
     } else if (tool && tool->precompiled_header_type() == CTool::PCH_GCC) {
       // The targets to build the .gch files should omit the -include flag
       // below. To accomplish this, each substitution flag is overwritten in
       // the target rule and these values are repeated. The -include flag is
       // omitted in place of the required -x <header lang> flag for .gch
       // targets.
-      RecursiveTargetConfigStringsToStream(config, target, getter,
-                                           flag_escape_options, out);
+      write_flags();
 
       // Compute the gch file (it will be language-specific).
       std::vector<OutputFile> outputs;
@@ -94,12 +103,10 @@ void WriteOneFlag(RecursiveWriterConfig config,
         out << " -include " << pch_file;
       }
     } else {
-      RecursiveTargetConfigStringsToStream(config, target, getter,
-                                           flag_escape_options, out);
+      write_flags();
     }
   } else {
-    RecursiveTargetConfigStringsToStream(config, target, getter,
-                                         flag_escape_options, out);
+    write_flags();
   }
 
   if (write_substitution)
@@ -5,14 +5,19 @@
 #ifndef TOOLS_GN_NINJA_TARGET_COMMAND_WRITER_H_
 #define TOOLS_GN_NINJA_TARGET_COMMAND_WRITER_H_
 
+#include <sstream>
 #include <string_view>
+#include <utility>
 
 #include "base/json/string_escape.h"
+#include "gn/build_settings.h"
 #include "gn/config_values_extractors.h"
 #include "gn/escape.h"
 #include "gn/filesystem_utils.h"
 #include "gn/frameworks_utils.h"
+#include "gn/ninja_flags_cache.h"
 #include "gn/path_output.h"
+#include "gn/settings.h"
 #include "gn/target.h"
 #include "gn/toolchain.h"
 #include "gn/variables.h"
@@ -84,6 +89,39 @@ struct IncludeWriter {
   PathOutput& path_output_;
 };
 
+// Writes the values of the target returned by |getter| for the given
+// substitution by calling |render| with the stream to write to. The rendered
+// text is looked up in and added to the |cache|, which may be null. With the
+// "ninja_shared_flags" option, a reference to a toolchain-level variable
+// holding the text is written instead.
+template <typename T, typename Render>
+void WriteCachedFlags(NinjaFlagsCache* cache,
+                      const Target* target,
+                      const Substitution* subst_enum,
+                      const std::vector<T>& (ConfigValues::*getter)() const,
+                      Render render,
+                      std::ostream& out) {
+  NinjaFlagsCache::Key key;
+  if (!cache || !NinjaFlagsCache::MakeKey(target, subst_enum, getter, &key)) {
+    render(out);
+    return;
+  }
+  const std::string* text = cache->Find(key);
+  if (!text) {
+    std::ostringstream rendered;
+    render(rendered);
+    text = &cache->Insert(std::move(key), rendered.str());
+  }
+  if (target->settings()->build_settings()->ninja_shared_flags()) {
+    if (const std::string* name =
+            cache->UseSharedVariable(target->toolchain(), subst_enum, *text)) {
+      out << " $" << *name;
+      return;
+    }
+  }
+  out << *text;
+}
+
 // has_precompiled_headers is set when this substitution matches a tool type
 // that supports precompiled headers, and this target supports precompiled
 // headers. It doesn't indicate if the tool has precompiled headers (this
@@ -92,6 +130,9 @@ struct IncludeWriter {
 // The tool_type indicates the corresponding tool for flags that are
 // tool-specific (e.g. "cflags_c"). For non-tool-specific flags (e.g.
 // "defines") tool_type should be TYPE_NONE.
+//
+// If |cache| is not null, the flags coming from the configs are rendered
+// through it, see WriteCachedFlags().
 void WriteOneFlag(RecursiveWriterConfig config,
                   const Target* target,
                   const Substitution* subst_enum,
@@ -103,7 +144,8 @@ void WriteOneFlag(RecursiveWriterConfig config,
                   PathOutput& path_output,
                   std::ostream& out,
                   bool write_substitution = true,
-                  bool indent = false);
+                  bool indent = false,
+                  NinjaFlagsCache* cache = nullptr);
 
 // Fills |outputs| with the object or gch file for the precompiled header of the
 // given type (flag type and tool type must match).
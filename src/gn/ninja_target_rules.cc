@@ -0,0 +1,73 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/ninja_target_rules.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "gn/ninja_flags_cache.h"
+#include "gn/ninja_target_writer.h"
+#include "gn/resolved_target_data.h"
+#include "gn/target.h"
+
+NinjaTargetRules::NinjaTargetRules(bool want_ninja_outputs)
+    : want_ninja_outputs_(want_ninja_outputs),
+      resolved_map_(std::make_unique<ResolvedMap>()),
+      flags_cache_(std::make_unique<NinjaFlagsCache>()) {}
+
+NinjaTargetRules::~NinjaTargetRules() = default;
+
+void NinjaTargetRules::WriteTarget(const Target* target) {
+  ResolvedTargetData* resolved;
+  std::vector<OutputFile> target_ninja_outputs;
+  std::vector<OutputFile>* ninja_outputs =
+      want_ninja_outputs_ ? &target_ninja_outputs : nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    resolved = &(*resolved_map_)[std::this_thread::get_id()];
+  }
+  std::string rule = NinjaTargetWriter::RunAndWriteFile(
+      target, resolved, ninja_outputs, flags_cache_.get());
+
+  DCHECK(!rule.empty());
+
+  std::lock_guard<std::mutex> lock(lock_);
+  rules_[target->toolchain()].emplace_back(target, std::move(rule));
+  if (want_ninja_outputs_)
+    ninja_outputs_map_.emplace(target, std::move(target_ninja_outputs));
+}
+
+bool NinjaTargetRules::WriteRootFiles(const BuildSettings* build_settings,
+                                      const Builder& builder,
+                                      Err* err) {
+  std::lock_guard<std::mutex> lock(lock_);
+  for (auto& cur_toolchain : rules_) {
+    std::sort(cur_toolchain.second.begin(), cur_toolchain.second.end(),
+              [](const NinjaWriter::TargetRulePair& a,
+                 const NinjaWriter::TargetRulePair& b) {
+                return a.first->label() < b.first->label();
+              });
+  }
+
+  return NinjaWriter::RunAndWriteFiles(build_settings, builder, rules_,
+                                       flags_cache_.get(), err);
+}
+
+size_t NinjaTargetRules::GetTargetCount() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  size_t count = 0;
+  for (const auto& rules : rules_)
+    count += rules.second.size();
+  return count;
+}
+
+void NinjaTargetRules::LeakOnPurpose() {
+  (void)resolved_map_.release();
+  (void)flags_cache_.release();
+}
@@ -0,0 +1,78 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_NINJA_TARGET_RULES_H_
+#define TOOLS_GN_NINJA_TARGET_RULES_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "gn/ninja_outputs_writer.h"
+#include "gn/ninja_writer.h"
+
+class Builder;
+class BuildSettings;
+class Err;
+class NinjaFlagsCache;
+class ResolvedTargetData;
+class Target;
+
+// Writes the ninja files of targets and collects their build rules, then
+// writes the root ninja files from them. This is how "gn gen" writes the
+// ninja files: each target is written on a worker thread as soon as it's
+// resolved.
+class NinjaTargetRules {
+ public:
+  using OutputsMap = NinjaOutputsWriter::MapType;
+
+  // The outputs of each target are also collected when |want_ninja_outputs|
+  // is set, for --ninja-outputs-file.
+  explicit NinjaTargetRules(bool want_ninja_outputs);
+  ~NinjaTargetRules();
+
+  // Writes the ninja file of |target| and keeps its build rule. Can be called
+  // from any thread.
+  void WriteTarget(const Target* target);
+
+  // Writes the root ninja files with the rules of the targets written so far.
+  // The rules of each toolchain are sorted by label first so the files have
+  // deterministic content. Must not be called while targets are being
+  // written. On failure, fills in |err| and returns false.
+  bool WriteRootFiles(const BuildSettings* build_settings,
+                      const Builder& builder,
+                      Err* err);
+
+  // Returns the number of targets written.
+  size_t GetTargetCount() const;
+
+  bool want_ninja_outputs() const { return want_ninja_outputs_; }
+  const OutputsMap& ninja_outputs_map() const { return ninja_outputs_map_; }
+
+  // Leaks the per-thread resolved data and the flags cache to avoid expensive
+  // process teardown.
+  void LeakOnPurpose();
+
+ private:
+  const bool want_ninja_outputs_;
+
+  // Protects the members below other than |flags_cache_|.
+  mutable std::mutex lock_;
+  NinjaWriter::PerToolchainRules rules_;
+  OutputsMap ninja_outputs_map_;
+
+  using ResolvedMap = std::unordered_map<std::thread::id, ResolvedTargetData>;
+  std::unique_ptr<ResolvedMap> resolved_map_;
+
+  // Shared by all writer threads. Doesn't need the lock.
+  std::unique_ptr<NinjaFlagsCache> flags_cache_;
+
+  NinjaTargetRules(const NinjaTargetRules&) = delete;
+  NinjaTargetRules& operator=(const NinjaTargetRules&) = delete;
+};
+
+#endif  // TOOLS_GN_NINJA_TARGET_RULES_H_
@@ -20,6 +20,7 @@
 #include "gn/ninja_bundle_data_target_writer.h"
 #include "gn/ninja_copy_target_writer.h"
 #include "gn/ninja_create_bundle_target_writer.h"
+#include "gn/ninja_flags_cache.h"
 #include "gn/ninja_generated_file_target_writer.h"
 #include "gn/ninja_group_target_writer.h"
 #include "gn/ninja_target_command_util.h"
@@ -53,6 +54,10 @@ void NinjaTargetWriter::SetNinjaOutputs(
   ninja_outputs_ = ninja_outputs;
 }
 
+void NinjaTargetWriter::SetFlagsCache(NinjaFlagsCache* flags_cache) {
+  flags_cache_ = flags_cache;
+}
+
 ResolvedTargetData* NinjaTargetWriter::GetResolvedTargetData() {
   return const_cast<ResolvedTargetData*>(&resolved());
 }
@@ -99,7 +104,8 @@ void NinjaTargetWriter::WriteOutputs(std::vector<OutputFile>&& outputs) const {
 std::string NinjaTargetWriter::RunAndWriteFile(
     const Target* target,
     ResolvedTargetData* resolved,
-    std::vector<OutputFile>* ninja_outputs) {
+    std::vector<OutputFile>* ninja_outputs,
+    NinjaFlagsCache* flags_cache) {
   const Settings* settings = target->settings();
 
   ScopedTrace trace(TraceItem::TRACE_FILE_WRITE_NINJA,
@@ -150,6 +156,7 @@ std::string NinjaTargetWriter::RunAndWriteFile(
     NinjaActionTargetWriter writer(target, rules);
     writer.SetResolvedTargetData(resolved);
     writer.SetNinjaOutputs(ninja_outputs);
+    writer.SetFlagsCache(flags_cache);
     writer.Run();
   } else if (target->output_type() == Target::GROUP) {
     NinjaGroupTargetWriter writer(target, rules);
@@ -166,11 +173,18 @@ std::string NinjaTargetWriter::RunAndWriteFile(
     NinjaBinaryTargetWriter writer(target, rules);
     writer.SetResolvedTargetData(resolved);
     writer.SetNinjaOutputs(ninja_outputs);
+    writer.SetFlagsCache(flags_cache);
     writer.Run();
   } else {
     CHECK(0) << "Output type of target not handled.";
   }
 
+  // With sharded output, the toolchain writer adds the rules to a file shared
+  // with other targets, see WritesToShard().
+  if (needs_file_write &&
+      settings->build_settings()->ninja_target_shards() > 0)
+    return storage.str();
+
   if (needs_file_write) {
     // Write the ninja file.
     SourceFile ninja_file = GetNinjaFileForTarget(target);
@@ -194,6 +208,45 @@ std::string NinjaTargetWriter::RunAndWriteFile(
   return storage.str();
 }
 
+bool NinjaTargetWriter::WritesToShard() const {
+  return target_->IsBinary() &&
+         settings_->build_settings()->ninja_target_shards() > 0;
+}
+
+void NinjaTargetWriter::BeginFileVariables() {
+  if (!WritesToShard())
+    return;
+  DCHECK(!file_variables_buf_);
+  file_variables_buf_ = std::make_unique<std::stringbuf>();
+  saved_buf_ = out_.rdbuf(file_variables_buf_.get());
+}
+
+void NinjaTargetWriter::EndFileVariables() {
+  if (!WritesToShard())
+    return;
+  out_.rdbuf(saved_buf_);
+  saved_buf_ = nullptr;
+
+  // Indent the variables for build steps, without the blank lines separating
+  // them from the rules.
+  std::string variables = file_variables_buf_->str();
+  file_variables_buf_.reset();
+  size_t begin = 0;
+  while (begin < variables.size()) {
+    size_t end = variables.find('\n', begin);
+    end = end == std::string::npos ? variables.size() : end + 1;
+    if (end - begin > 1) {
+      file_variables_.append("  ");
+      file_variables_.append(variables, begin, end - begin);
+    }
+    begin = end;
+  }
+}
+
+void NinjaTargetWriter::WriteFileVariablesForStep() const {
+  out_ << file_variables_;
+}
+
 void NinjaTargetWriter::WriteEscapedSubstitution(const Substitution* type) {
   EscapeOptions opts;
   opts.mode = ESCAPE_NINJA;
@@ -269,9 +322,14 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     if (indent)
       out_ << "  ";
     out_ << CSubstitutionDefines.ninja_name << " =";
-    RecursiveTargetConfigToStream<std::string>(kRecursiveWriterSkipDuplicates,
-                                               target_, &ConfigValues::defines,
-                                               DefineWriter(), out_);
+    WriteCachedFlags(
+        flags_cache_, target_, &CSubstitutionDefines, &ConfigValues::defines,
+        [this](std::ostream& out) {
+          RecursiveTargetConfigToStream<std::string>(
+              kRecursiveWriterSkipDuplicates, target_, &ConfigValues::defines,
+              DefineWriter(), out);
+        },
+        out_);
     out_ << std::endl;
   }
 
@@ -301,9 +359,16 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     PathOutput include_path_output(
         path_output_.current_dir(),
         settings_->build_settings()->root_path_utf8(), ESCAPE_NINJA_COMMAND);
-    RecursiveTargetConfigToStream<SourceDir>(
-        kRecursiveWriterSkipDuplicates, target_, &ConfigValues::include_dirs,
-        IncludeWriter(include_path_output), out_);
+    WriteCachedFlags(
+        flags_cache_, target_, &CSubstitutionIncludeDirs,
+        &ConfigValues::include_dirs,
+        [this, &include_path_output](std::ostream& out) {
+          RecursiveTargetConfigToStream<SourceDir>(
+              kRecursiveWriterSkipDuplicates, target_,
+              &ConfigValues::include_dirs, IncludeWriter(include_path_output),
+              out);
+        },
+        out_);
     out_ << std::endl;
   }
 
@@ -318,7 +383,7 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_,
                  &CSubstitutionAsmFlags, false, Tool::kToolNone,
                  &ConfigValues::asmflags, opts, path_output_, out_, true,
-                 indent);
+                 indent, flags_cache_);
   }
   if (respect_source_used
           ? (target_->source_types_used().Get(SourceFile::SOURCE_C) ||
@@ -329,7 +394,7 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
           : bits.used.count(&CSubstitutionCFlags)) {
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_, &CSubstitutionCFlags,
                  false, Tool::kToolNone, &ConfigValues::cflags, opts,
-                 path_output_, out_, true, indent);
+                 path_output_, out_, true, indent, flags_cache_);
   }
   if (respect_source_used
           ? target_->source_types_used().Get(SourceFile::SOURCE_C)
@@ -337,7 +402,7 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_, &CSubstitutionCFlagsC,
                  has_precompiled_headers, CTool::kCToolCc,
                  &ConfigValues::cflags_c, opts, path_output_, out_, true,
-                 indent);
+                 indent, flags_cache_);
   }
   if (respect_source_used
           ? (target_->source_types_used().Get(SourceFile::SOURCE_CPP) ||
@@ -346,7 +411,7 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_,
                  &CSubstitutionCFlagsCc, has_precompiled_headers,
                  CTool::kCToolCxx, &ConfigValues::cflags_cc, opts, path_output_,
-                 out_, true, indent);
+                 out_, true, indent, flags_cache_);
   }
   if (respect_source_used
           ? target_->source_types_used().Get(SourceFile::SOURCE_M)
@@ -354,7 +419,7 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_,
                  &CSubstitutionCFlagsObjC, has_precompiled_headers,
                  CTool::kCToolObjC, &ConfigValues::cflags_objc, opts,
-                 path_output_, out_, true, indent);
+                 path_output_, out_, true, indent, flags_cache_);
   }
   if (respect_source_used
           ? target_->source_types_used().Get(SourceFile::SOURCE_MM)
@@ -362,7 +427,7 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_,
                  &CSubstitutionCFlagsObjCc, has_precompiled_headers,
                  CTool::kCToolObjCxx, &ConfigValues::cflags_objcc, opts,
-                 path_output_, out_, true, indent);
+                 path_output_, out_, true, indent, flags_cache_);
   }
   if (target_->source_types_used().SwiftSourceUsed() || !respect_source_used) {
     if (bits.used.count(&CSubstitutionSwiftModuleName)) {
@@ -408,7 +473,7 @@ void NinjaTargetWriter::WriteCCompilerVars(const SubstitutionBits& bits,
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_,
                  &CSubstitutionSwiftFlags, false, CTool::kCToolSwift,
                  &ConfigValues::swiftflags, opts, path_output_, out_, true,
-                 indent);
+                 indent, flags_cache_);
   }
 }
 
@@ -572,6 +637,8 @@ std::vector<OutputFile> NinjaTargetWriter::WriteInputDepsStampOrPhonyAndGetDep(
   out_ << ": " << tool;
   WriteOutputs(outs);
   out_ << "\n";
+  if (tool != BuiltinTool::kBuiltinToolPhony)
+    WriteFileVariablesForStep();
   return std::vector<OutputFile>{input_stamp_or_phony};
 }
 
@@ -622,4 +689,6 @@ void NinjaTargetWriter::WriteStampOrPhonyForTarget(
     path_output_.WriteFiles(out_, order_only_deps);
   }
   out_ << std::endl;
+  if (target_->has_dependency_output_file())
+    WriteFileVariablesForStep();
 }
@@ -6,11 +6,14 @@
 #define TOOLS_GN_NINJA_TARGET_WRITER_H_
 
 #include <iosfwd>
+#include <memory>
+#include <string>
 
 #include "gn/path_output.h"
 #include "gn/resolved_target_data.h"
 #include "gn/substitution_type.h"
 
+class NinjaFlagsCache;
 class OutputFile;
 class Settings;
 class Target;
@@ -39,6 +42,11 @@ class NinjaTargetWriter {
   // collected.
   void SetNinjaOutputs(std::vector<OutputFile>* ninja_outputs);
 
+  // Sets the cache used to render the compiler flag variables. Does not
+  // transfer ownership, and allows several NinjaTargetWriter instances to
+  // share the same rendered flags. A nullptr value disables caching.
+  void SetFlagsCache(NinjaFlagsCache* flags_cache);
+
   // Returns the build line to be written to the toolchain build file.
   //
   // Some targets have their rules written to separate files, and some can have
@@ -46,13 +54,20 @@ class NinjaTargetWriter {
   // function will return the rules as a string. For the separate file case,
   // the separate ninja file will be written and the return string will be the
   // subninja command to load that file.
+  // With the "ninja_target_shards" option, the rules of the separate file
+  // case are returned instead, for NinjaToolchainWriter to write to a shard,
+  // see WritesToShard().
   //
   // If |ninja_outputs| is not nullptr, it will be set with the list of
   // Ninja output paths generated by the corresponding writer.
+  //
+  // If |flags_cache| is not nullptr, it's used to render the compiler flags,
+  // see SetFlagsCache().
   static std::string RunAndWriteFile(
       const Target* target,
       ResolvedTargetData* resolved = nullptr,
-      std::vector<OutputFile>* ninja_outputs = nullptr);
+      std::vector<OutputFile>* ninja_outputs = nullptr,
+      NinjaFlagsCache* flags_cache = nullptr);
 
   virtual void Run() = 0;
 
@@ -82,6 +97,23 @@ class NinjaTargetWriter {
                              bool indent,
                              bool always_write);
 
+  // Returns whether the rules are written to a file shared with other targets
+  // (see BuildSettings::ninja_target_shards()) instead of a file of their
+  // own. Ninja only scopes variables per file, so these targets repeat the
+  // variables that would be set at the top of their file on each of their
+  // build steps instead.
+  bool WritesToShard() const;
+
+  // For targets written to a shard, what is written to out_ between these
+  // calls is kept as the file-level variables of the target instead, to be
+  // written by WriteFileVariablesForStep(). Otherwise these do nothing.
+  void BeginFileVariables();
+  void EndFileVariables();
+
+  // Writes the file-level variables of a target written to a shard under the
+  // build line just written. Phony steps don't run a command and skip this.
+  void WriteFileVariablesForStep() const;
+
   // Writes to the output stream a phony rule for input dependencies, and
   // returns the file to be appended to source rules that encodes the
   // order-only dependencies for the current target.
@@ -119,6 +151,10 @@ class NinjaTargetWriter {
   // be const.
   mutable std::vector<OutputFile>* ninja_outputs_ = nullptr;
 
+  // Renders the compiler flags shared by many targets only once, see
+  // SetFlagsCache(). Can be null.
+  NinjaFlagsCache* flags_cache_ = nullptr;
+
   // The ResolvedTargetData instance can be set through SetResolvedTargetData()
   // or it will be created lazily when resolved() is called, hence the need
   // for 'mutable' here.
@@ -129,6 +165,15 @@ class NinjaTargetWriter {
   void WriteCopyRules();
   void WriteEscapedSubstitution(const Substitution* type);
 
+  // Collects the file-level variables between BeginFileVariables() and
+  // EndFileVariables(), while out_ writes to it.
+  std::unique_ptr<std::stringbuf> file_variables_buf_;
+  std::streambuf* saved_buf_ = nullptr;
+
+  // The file-level variables of a target written to a shard, indented for
+  // build steps.
+  std::string file_variables_;
+
   NinjaTargetWriter(const NinjaTargetWriter&) = delete;
   NinjaTargetWriter& operator=(const NinjaTargetWriter&) = delete;
 };
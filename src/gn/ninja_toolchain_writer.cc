@@ -5,17 +5,22 @@
 #include "gn/ninja_toolchain_writer.h"
 
 #include <fstream>
+#include <sstream>
+#include <string>
 
 #include "base/files/file_util.h"
 #include "base/strings/stringize_macros.h"
 #include "gn/build_settings.h"
 #include "gn/builtin_tool.h"
 #include "gn/c_tool.h"
+#include "gn/dry_run.h"
 #include "gn/filesystem_utils.h"
 #include "gn/general_tool.h"
+#include "gn/ninja_flags_cache.h"
 #include "gn/ninja_utils.h"
 #include "gn/pool.h"
 #include "gn/settings.h"
+#include "gn/string_utils.h"
 #include "gn/substitution_writer.h"
 #include "gn/target.h"
 #include "gn/toolchain.h"
@@ -40,7 +45,8 @@ NinjaToolchainWriter::NinjaToolchainWriter(const Settings* settings,
 NinjaToolchainWriter::~NinjaToolchainWriter() = default;
 
 void NinjaToolchainWriter::Run(
-    const std::vector<NinjaWriter::TargetRulePair>& rules) {
+    const std::vector<NinjaWriter::TargetRulePair>& rules,
+    const NinjaFlagsCache* flags_cache) {
   std::string rule_prefix = GetNinjaRulePrefixForToolchain(settings_);
 
   for (const auto& tool : toolchain_->tools()) {
@@ -52,20 +58,59 @@ void NinjaToolchainWriter::Run(
   }
   out_ << std::endl;
 
-  for (const auto& pair : rules)
-    out_ << pair.second;
+  // The target files are loaded by the rules below, so they can refer to these.
+  if (flags_cache) {
+    std::vector<std::pair<std::string, std::string>> shared_flags =
+        flags_cache->GetSharedVariables(toolchain_);
+    for (const auto& [name, value] : shared_flags)
+      out_ << name << " =" << value << std::endl;
+    if (!shared_flags.empty())
+      out_ << std::endl;
+  }
+
+  // Binary targets of the same directory are usually built together, so keep
+  // them in the same shard.
+  size_t num_shards = settings_->build_settings()->ninja_target_shards();
+  shards_.clear();
+  shards_.resize(num_shards);
+  for (const auto& pair : rules) {
+    if (num_shards > 0 && pair.first->IsBinary()) {
+      size_t shard =
+          StableHash(pair.first->label().dir().value()) % num_shards;
+      shards_[shard] << pair.second;
+    } else {
+      out_ << pair.second;
+    }
+  }
+
+  for (size_t i = 0; i < shards_.size(); i++) {
+    if (shards_[i].size() == 0)
+      continue;
+    out_ << "subninja ";
+    path_output_.WriteFile(out_, GetShardFile(i));
+    out_ << std::endl;
+  }
 }
 
 // static
 bool NinjaToolchainWriter::RunAndWriteFile(
     const Settings* settings,
     const Toolchain* toolchain,
-    const std::vector<NinjaWriter::TargetRulePair>& rules) {
+    const std::vector<NinjaWriter::TargetRulePair>& rules,
+    const NinjaFlagsCache* flags_cache) {
   base::FilePath ninja_file(settings->build_settings()->GetFullPath(
       GetNinjaFileForToolchain(settings)));
   ScopedTrace trace(TraceItem::TRACE_FILE_WRITE_NINJA,
                     FilePathToUTF8(ninja_file));
 
+  if (DryRunEnabled()) {
+    std::stringstream file;
+    NinjaToolchainWriter gen(settings, toolchain, file);
+    gen.Run(rules, flags_cache);
+    RecordDryRunWrite(ninja_file, file.str());
+    return gen.WriteShardFiles();
+  }
+
   base::CreateDirectory(ninja_file.DirName());
 
   std::ofstream file;
@@ -75,7 +120,44 @@ bool NinjaToolchainWriter::RunAndWriteFile(
     return false;
 
   NinjaToolchainWriter gen(settings, toolchain, file);
-  gen.Run(rules);
+  gen.Run(rules, flags_cache);
+  return gen.WriteShardFiles();
+}
+
+SourceFile NinjaToolchainWriter::GetShardFile(size_t shard) const {
+  return SourceFile(GetBuildDirAsSourceDir(BuildDirContext(settings_),
+                                           BuildDirType::TOOLCHAIN_ROOT)
+                        .value() +
+                    "toolchain_shard_" + std::to_string(shard) + ".ninja");
+}
+
+bool NinjaToolchainWriter::WriteShardFiles() const {
+  for (size_t i = 0; i < shards_.size(); i++) {
+    base::FilePath shard_file =
+        settings_->build_settings()->GetFullPath(GetShardFile(i));
+    if (shards_[i].size() == 0) {
+      // Don't leave the rules of a previous gen around.
+      if (!DryRunEnabled())
+        base::DeleteFile(shard_file, false);
+      continue;
+    }
+    ScopedTrace trace(TraceItem::TRACE_FILE_WRITE_NINJA,
+                      FilePathToUTF8(shard_file));
+    if (!shards_[i].WriteToFileIfChanged(shard_file, nullptr))
+      return false;
+  }
+
+  // Delete the shards left over from a previous gen with more shards. They're
+  // numbered consecutively, so stop at the first one that doesn't exist.
+  if (DryRunEnabled())
+    return true;
+  for (size_t i = shards_.size();; i++) {
+    base::FilePath shard_file =
+        settings_->build_settings()->GetFullPath(GetShardFile(i));
+    if (!base::PathExists(shard_file))
+      break;
+    base::DeleteFile(shard_file, false);
+  }
   return true;
 }
 
@@ -13,31 +13,47 @@
 #include "base/gtest_prod_util.h"
 #include "gn/ninja_writer.h"
 #include "gn/path_output.h"
+#include "gn/string_output_buffer.h"
 #include "gn/toolchain.h"
 
 struct EscapeOptions;
+class NinjaFlagsCache;
 class Settings;
 class Tool;
 
 class NinjaToolchainWriter {
  public:
   // Takes the settings for the toolchain, as well as the list of all targets
-  // associated with the toolchain.
+  // associated with the toolchain. The shared flag variables used by these
+  // targets are taken from |flags_cache| if not null.
   static bool RunAndWriteFile(
       const Settings* settings,
       const Toolchain* toolchain,
-      const std::vector<NinjaWriter::TargetRulePair>& rules);
+      const std::vector<NinjaWriter::TargetRulePair>& rules,
+      const NinjaFlagsCache* flags_cache = nullptr);
 
  private:
   FRIEND_TEST_ALL_PREFIXES(NinjaToolchainWriter, WriteToolRule);
   FRIEND_TEST_ALL_PREFIXES(NinjaToolchainWriter, WriteToolRuleWithLauncher);
+  FRIEND_TEST_ALL_PREFIXES(NinjaToolchainWriter, SharedFlags);
+  FRIEND_TEST_ALL_PREFIXES(NinjaToolchainWriter, TargetShards);
+  FRIEND_TEST_ALL_PREFIXES(NinjaToolchainWriter, DeletesStaleShards);
 
   NinjaToolchainWriter(const Settings* settings,
                        const Toolchain* toolchain,
                        std::ostream& out);
   ~NinjaToolchainWriter();
 
-  void Run(const std::vector<NinjaWriter::TargetRulePair>& extra_rules);
+  void Run(const std::vector<NinjaWriter::TargetRulePair>& extra_rules,
+           const NinjaFlagsCache* flags_cache);
+
+  // Returns the file holding the rules of the binary targets of the given
+  // shard, see BuildSettings::ninja_target_shards().
+  SourceFile GetShardFile(size_t shard) const;
+
+  // Writes the shard files filled by Run(), unless they didn't change, and
+  // deletes the empty ones and those left over from a previous gen.
+  bool WriteShardFiles() const;
 
   void WriteRules();
   void WriteToolRule(Tool* tool, const std::string& rule_prefix);
@@ -54,6 +70,10 @@ class NinjaToolchainWriter {
   std::ostream& out_;
   PathOutput path_output_;
 
+  // The contents of the shard files, indexed by shard. Empty if the targets
+  // aren't sharded.
+  std::vector<StringOutputBuffer> shards_;
+
   NinjaToolchainWriter(const NinjaToolchainWriter&) = delete;
   NinjaToolchainWriter& operator=(const NinjaToolchainWriter&) = delete;
 };
@@ -4,7 +4,12 @@
 
 #include <sstream>
 
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "gn/c_substitution_type.h"
+#include "gn/ninja_flags_cache.h"
 #include "gn/ninja_toolchain_writer.h"
+#include "gn/target.h"
 #include "gn/test_with_scope.h"
 #include "util/test/test.h"
 
@@ -38,3 +43,101 @@ TEST(NinjaToolchainWriter, WriteToolRuleWithLauncher) {
       "-o ${out}\n",
       stream.str());
 }
+
+TEST(NinjaToolchainWriter, SharedFlags) {
+  TestWithScope setup;
+
+  NinjaFlagsCache cache;
+  NinjaFlagsCache::Key key;
+  key.substitution = &CSubstitutionDefines;
+  const std::string& text = cache.Insert(
+      key, " -DFIRST_QUITE_LONG_DEFINE=1 -DSECOND_QUITE_LONG_DEFINE=2 -DTHIRD=3");
+  const std::string* name =
+      cache.UseSharedVariable(setup.toolchain(), &CSubstitutionDefines, text);
+  ASSERT_TRUE(name);
+  EXPECT_EQ(0u, name->find("defines_"));
+
+  // Too short to be worth sharing.
+  key.substitution = &CSubstitutionCFlags;
+  const std::string& short_text = cache.Insert(key, " -O2");
+  EXPECT_FALSE(cache.UseSharedVariable(setup.toolchain(), &CSubstitutionCFlags,
+                                       short_text));
+
+  std::ostringstream stream;
+  NinjaToolchainWriter writer(setup.settings(), setup.toolchain(), stream);
+  writer.Run(std::vector<NinjaWriter::TargetRulePair>(), &cache);
+
+  std::string expected = "\n" + *name + " =" + text + "\n\n";
+  EXPECT_NE(std::string::npos, stream.str().find(expected)) << stream.str();
+  EXPECT_EQ(std::string::npos, stream.str().find(" -O2"));
+}
+
+TEST(NinjaToolchainWriter, TargetShards) {
+  TestWithScope setup;
+  setup.build_settings()->set_ninja_target_shards(2);
+
+  Target binary(setup.settings(), Label(SourceDir("//foo/"), "binary"));
+  binary.set_output_type(Target::SOURCE_SET);
+  Target other_binary(setup.settings(), Label(SourceDir("//foo/"), "other"));
+  other_binary.set_output_type(Target::STATIC_LIBRARY);
+  Target group(setup.settings(), Label(SourceDir("//foo/"), "group"));
+  group.set_output_type(Target::GROUP);
+
+  std::vector<NinjaWriter::TargetRulePair> rules;
+  rules.emplace_back(&binary, "build binary: cc\n");
+  rules.emplace_back(&group, "build group: phony\n");
+  rules.emplace_back(&other_binary, "build other: alink\n");
+
+  std::ostringstream stream;
+  NinjaToolchainWriter writer(setup.settings(), setup.toolchain(), stream);
+  writer.Run(rules, nullptr);
+
+  // Targets of the same directory share a shard, in order.
+  ASSERT_EQ(2u, writer.shards_.size());
+  size_t shard = writer.shards_[0].size() ? 0 : 1;
+  EXPECT_EQ("build binary: cc\nbuild other: alink\n",
+            writer.shards_[shard].str());
+  EXPECT_EQ(0u, writer.shards_[1 - shard].size());
+
+  std::string expected = "build group: phony\nsubninja toolchain_shard_" +
+                         std::to_string(shard) + ".ninja\n";
+  std::string out = stream.str();
+  EXPECT_EQ(out.size() - expected.size(), out.rfind(expected)) << out;
+}
+
+// Shards that are empty or beyond the shard count are deleted, so the rules of
+// a previous gen don't linger.
+TEST(NinjaToolchainWriter, DeletesStaleShards) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+
+  TestWithScope setup;
+  setup.build_settings()->SetRootPath(temp_dir.GetPath());
+  setup.build_settings()->set_ninja_target_shards(2);
+
+  Target binary(setup.settings(), Label(SourceDir("//foo/"), "binary"));
+  binary.set_output_type(Target::SOURCE_SET);
+  std::vector<NinjaWriter::TargetRulePair> rules;
+  rules.emplace_back(&binary, "build binary: cc\n");
+
+  std::ostringstream stream;
+  NinjaToolchainWriter writer(setup.settings(), setup.toolchain(), stream);
+  std::vector<base::FilePath> shard_files;
+  for (size_t i = 0; i < 4; i++) {
+    shard_files.push_back(
+        setup.build_settings()->GetFullPath(writer.GetShardFile(i)));
+    ASSERT_TRUE(base::CreateDirectory(shard_files[i].DirName()));
+    ASSERT_EQ(5, base::WriteFile(shard_files[i], "stale", 5));
+  }
+
+  writer.Run(rules, nullptr);
+  ASSERT_TRUE(writer.WriteShardFiles());
+
+  size_t shard = writer.shards_[0].size() ? 0 : 1;
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(shard_files[shard], &contents));
+  EXPECT_EQ("build binary: cc\n", contents);
+  EXPECT_FALSE(base::PathExists(shard_files[1 - shard]));
+  EXPECT_FALSE(base::PathExists(shard_files[2]));
+  EXPECT_FALSE(base::PathExists(shard_files[3]));
+}
@@ -13,6 +13,7 @@
 class Builder;
 class BuildSettings;
 class Err;
+class NinjaFlagsCache;
 class Target;
 class Toolchain;
 
@@ -27,17 +28,21 @@ class NinjaWriter {
 
   // On failure will populate |err| and will return false.  The map contains
   // the per-toolchain set of rules collected to write to the toolchain build
-  // files.
+  // files. |flags_cache| is the cache the target rules were written with, if
+  // any, which holds the shared flag variables to write.
   static bool RunAndWriteFiles(const BuildSettings* build_settings,
                                const Builder& builder,
                                const PerToolchainRules& per_toolchain_rules,
+                               const NinjaFlagsCache* flags_cache,
                                Err* err);
 
  private:
   NinjaWriter(const Builder& builder);
   ~NinjaWriter();
 
-  bool WriteToolchains(const PerToolchainRules& per_toolchain_rules, Err* err);
+  bool WriteToolchains(const PerToolchainRules& per_toolchain_rules,
+                       const NinjaFlagsCache* flags_cache,
+                       Err* err);
 
   const Builder& builder_;
 
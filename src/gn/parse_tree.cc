@@ -15,6 +15,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "gn/functions.h"
+#include "gn/memory_stats.h"
 #include "gn/operators.h"
 #include "gn/scope.h"
 #include "gn/string_utils.h"
@@ -166,9 +167,13 @@ void Comments::ReverseSuffix() {
     std::swap(suffix_[i], suffix_[j]);
 }
 
-ParseNode::ParseNode() = default;
+ParseNode::ParseNode() {
+  CountMemory(MemoryCounter::PARSE_NODES, 1, 0);
+}
 
-ParseNode::~ParseNode() = default;
+ParseNode::~ParseNode() {
+  CountMemory(MemoryCounter::PARSE_NODES, -1, 0);
+}
 
 const AccessorNode* ParseNode::AsAccessor() const {
   return nullptr;
@@ -4,11 +4,80 @@
 
 #include "gn/path_output.h"
 
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
 #include "base/strings/string_util.h"
 #include "gn/filesystem_utils.h"
 #include "gn/output_file.h"
+#include "gn/source_file.h"
 #include "gn/string_utils.h"
 #include "util/build_config.h"
+#include "util/thread_local_pointer.h"
+
+namespace {
+
+// Identifies a rendered path. For a source-absolute current directory, the
+// rendered path only depends on these: the source root is only used to
+// rebase system-absolute directories.
+struct RenderedPathKey {
+  SourceFile file;
+  SourceDir current_dir;
+  EscapingMode mode;
+  EscapingPlatform platform;
+  bool inhibit_quoting;
+
+  bool operator==(const RenderedPathKey& other) const {
+    return file == other.file && current_dir == other.current_dir &&
+           mode == other.mode && platform == other.platform &&
+           inhibit_quoting == other.inhibit_quoting;
+  }
+};
+
+struct RenderedPathKeyHash {
+  size_t operator()(const RenderedPathKey& key) const {
+    size_t hash = std::hash<SourceFile>()(key.file) * 31 +
+                  std::hash<SourceDir>()(key.current_dir);
+    return hash * 31 + (static_cast<size_t>(key.mode) << 2) +
+           (static_cast<size_t>(key.platform) << 1) + key.inhibit_quoting;
+  }
+};
+
+using RenderedPathMap =
+    std::unordered_map<RenderedPathKey, const std::string*, RenderedPathKeyHash>;
+
+// The paths rendered by all threads. The rendered strings are leaked, like
+// StringAtom values. Every entry is a path that was written to a generated
+// file, so the table is bounded by the total size of the ninja files, and
+// is usually much smaller since most paths are written many times.
+//
+// Like for StringAtom, the mutex would be a bottleneck, so each thread keeps
+// its own cache of the rendered paths it uses, and only looks up this table
+// on a miss. The per-thread caches only hold pointers to the shared strings.
+class RenderedPathTable {
+ public:
+  template <typename Render>
+  const std::string* FindOrAdd(const RenderedPathKey& key, Render render) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::string*& rendered = map_[key];
+    if (!rendered)
+      rendered = new std::string(render());
+    return rendered;
+  }
+
+ private:
+  std::mutex mutex_;
+  RenderedPathMap map_;
+};
+
+RenderedPathTable& GetRenderedPathTable() {
+  static RenderedPathTable* table = new RenderedPathTable;
+  return *table;
+}
+
+}  // namespace
 
 PathOutput::PathOutput(const SourceDir& current_dir,
                        std::string_view source_root,
@@ -23,7 +92,10 @@ PathOutput::PathOutput(const SourceDir& current_dir,
 PathOutput::~PathOutput() = default;
 
 void PathOutput::WriteFile(std::ostream& out, const SourceFile& file) const {
-  WritePathStr(out, file.value());
+  if (current_dir_.is_source_absolute())
+    out << GetRenderedPath(file);
+  else
+    WritePathStr(out, file.value());
 }
 
 void PathOutput::WriteDir(std::ostream& out,
@@ -128,6 +200,24 @@ void PathOutput::WriteFile(std::ostream& out,
   EscapeStringToStream(out, FilePathToUTF8(file), options_);
 }
 
+const std::string& PathOutput::GetRenderedPath(const SourceFile& file) const {
+  DCHECK(current_dir_.is_source_absolute());
+  RenderedPathKey key{file, current_dir_, options_.mode, options_.platform,
+                      options_.inhibit_quoting};
+  RenderedPathMap*& local_paths = ThreadLocalPointer<RenderedPathMap>();
+  if (!local_paths)
+    local_paths = new RenderedPathMap;  // Leaked, like the table.
+  const std::string*& rendered = (*local_paths)[key];
+  if (!rendered) {
+    rendered = GetRenderedPathTable().FindOrAdd(key, [this, &file]() {
+      std::ostringstream out;
+      WritePathStr(out, file.value());
+      return out.str();
+    });
+  }
+  return *rendered;
+}
+
 void PathOutput::WriteSourceRelativeString(std::ostream& out,
                                            std::string_view str) const {
   if (options_.mode == ESCAPE_NINJA_COMMAND) {
@@ -48,6 +48,9 @@ class PathOutput {
   void set_inhibit_quoting(bool iq) { options_.inhibit_quoting = iq; }
   void set_escape_platform(EscapingPlatform p) { options_.platform = p; }
 
+  // SourceFiles are rendered once for all PathOutputs with the same
+  // source-absolute directory and escaping, later writes only copy the
+  // rendered path.
   void WriteFile(std::ostream& out, const SourceFile& file) const;
   void WriteFile(std::ostream& out, const OutputFile& file) const;
   void WriteFile(std::ostream& out, const base::FilePath& file) const;
@@ -78,6 +81,11 @@ class PathOutput {
   // current dir. This assumes leading slashes have been trimmed.
   void WriteSourceRelativeString(std::ostream& out, std::string_view str) const;
 
+  // Returns the file rendered by WritePathStr() from the cache of rendered
+  // paths, rendering it first if needed. The current directory must be
+  // source-absolute.
+  const std::string& GetRenderedPath(const SourceFile& file) const;
+
   SourceDir current_dir_;
 
   // Uses system slashes if convert_slashes_to_system_.
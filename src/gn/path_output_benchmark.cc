@@ -0,0 +1,111 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gn/path_output.h"
+#include "gn/source_dir.h"
+#include "gn/source_file.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+const size_t kCount = 1000;
+
+// Sources of a typical target, as written by each target that lists or
+// depends on them.
+std::vector<SourceFile> MakeFiles() {
+  std::vector<SourceFile> files;
+  for (size_t i = 0; i < kCount; i++) {
+    files.emplace_back("//third_party/some_library/src/module" +
+                       std::to_string(i / 100) + "/file" +
+                       std::to_string(i % 100) + ".cc");
+  }
+  return files;
+}
+
+// Writes the same files from |thread_count| new threads. Their caches are
+// empty so every lookup goes to the global table of rendered paths, as
+// happens when the writer threads start. The paths are rendered once up
+// front so only lookups are measured.
+void RunWriteFileThreads(benchmark::State& state, size_t thread_count) {
+  std::vector<SourceFile> files = MakeFiles();
+  {
+    PathOutput path_output(SourceDir("//out/Debug/"), "/src", ESCAPE_NINJA);
+    std::ostringstream out;
+    for (const SourceFile& file : files)
+      path_output.WriteFile(out, file);
+  }
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; i++) {
+      threads.emplace_back([&files]() {
+        PathOutput path_output(SourceDir("//out/Debug/"), "/src",
+                               ESCAPE_NINJA);
+        std::ostringstream out;
+        for (const SourceFile& file : files)
+          path_output.WriteFile(out, file);
+        benchmark::DoNotOptimize(out.tellp());
+      });
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  state.SetItemsProcessed(state.iterations() * thread_count * kCount);
+}
+
+}  // namespace
+
+// Rebases and escapes each file, like PathOutput did before caching.
+BENCHMARK(PathOutput_WriteFile_Render) {
+  std::vector<SourceFile> files = MakeFiles();
+  PathOutput path_output(SourceDir("//out/Debug/"), "/src", ESCAPE_NINJA);
+  while (state.KeepRunning()) {
+    std::ostringstream out;
+    for (const SourceFile& file : files)
+      path_output.WritePathStr(out, file.value());
+    benchmark::DoNotOptimize(out.tellp());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+BENCHMARK(PathOutput_WriteFile_Cached) {
+  std::vector<SourceFile> files = MakeFiles();
+  PathOutput path_output(SourceDir("//out/Debug/"), "/src", ESCAPE_NINJA);
+  while (state.KeepRunning()) {
+    std::ostringstream out;
+    for (const SourceFile& file : files)
+      path_output.WriteFile(out, file);
+    benchmark::DoNotOptimize(out.tellp());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+// Writers are created for each target, so they're usually new.
+BENCHMARK(PathOutput_WriteFile_CachedNewWriter) {
+  std::vector<SourceFile> files = MakeFiles();
+  while (state.KeepRunning()) {
+    PathOutput path_output(SourceDir("//out/Debug/"), "/src", ESCAPE_NINJA);
+    std::ostringstream out;
+    for (const SourceFile& file : files)
+      path_output.WriteFile(out, file);
+    benchmark::DoNotOptimize(out.tellp());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+BENCHMARK(PathOutput_WriteFile_ColdCache_1Thread) {
+  RunWriteFileThreads(state, 1);
+}
+
+BENCHMARK(PathOutput_WriteFile_ColdCache_4Threads) {
+  RunWriteFileThreads(state, 4);
+}
+
+BENCHMARK(PathOutput_WriteFile_ColdCache_16Threads) {
+  RunWriteFileThreads(state, 16);
+}
@@ -166,6 +166,48 @@ TEST(PathOutput, InhibitQuoting) {
   }
 }
 
+// Rendered paths are cached, check that each writer still gets its own.
+TEST(PathOutput, CachedPaths) {
+  SourceFile file("//foo/foo bar.cc");
+  PathOutput debug(SourceDir("//out/Debug/"), "/source/root", ESCAPE_NINJA);
+  PathOutput release(SourceDir("//out/Release/x/"), "/source/root",
+                     ESCAPE_NINJA);
+  PathOutput outside(SourceDir("/build/out/"), "/source/root", ESCAPE_NINJA);
+  PathOutput other_root(SourceDir("/build/out/"), "/other/root",
+                        ESCAPE_NINJA);
+  PathOutput none(SourceDir("//out/Debug/"), "/source/root", ESCAPE_NONE);
+  for (int i = 0; i < 2; i++) {
+    std::ostringstream out;
+    debug.WriteFile(out, file);
+    out << " ";
+    release.WriteFile(out, file);
+    out << " ";
+    outside.WriteFile(out, file);
+    out << " ";
+    other_root.WriteFile(out, file);
+    out << " ";
+    none.WriteFile(out, file);
+    EXPECT_EQ(
+        "../../foo/foo$ bar.cc ../../../foo/foo$ bar.cc "
+        "../../source/root/foo/foo$ bar.cc ../../other/root/foo/foo$ bar.cc "
+        "../../foo/foo bar.cc",
+        out.str());
+  }
+
+  // Changing the escaping options after construction changes the rendering.
+  PathOutput command(SourceDir("//out/Debug/"), "/source/root",
+                     ESCAPE_NINJA_COMMAND);
+  command.set_escape_platform(ESCAPE_PLATFORM_WIN);
+  for (bool inhibit_quoting : {false, true, false}) {
+    command.set_inhibit_quoting(inhibit_quoting);
+    std::ostringstream out;
+    command.WriteFile(out, file);
+    std::string expected = inhibit_quoting ? "../../foo/foo$ bar.cc"
+                                           : "\"../../foo/foo$ bar.cc\"";
+    EXPECT_EQ(expected, out.str());
+  }
+}
+
 TEST(PathOutput, WriteDir) {
   {
     SourceDir build_dir("//out/Debug/");
@@ -4,6 +4,11 @@
 
 #include "gn/pattern.h"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "base/logging.h"
 #include "gn/value.h"
 
 const char kFilePattern_Help[] =
@@ -42,6 +47,14 @@ Pattern examples
 
 namespace {
 
+// Special DFA transition targets.
+constexpr int32_t kDfaNoMatch = -1;
+constexpr int32_t kDfaMatch = -2;
+
+// Patterns that would need a larger DFA are matched by simulating the
+// automaton instead.
+constexpr size_t kMaxDfaStates = 1024;
+
 void ParsePattern(const std::string& s, std::vector<Pattern::Subrange>* out) {
   // Set when the last subrange is a literal so we can just append when we
   // find another literal.
@@ -188,12 +201,25 @@ PatternList::PatternList(const PatternList& other) = default;
 
 PatternList::~PatternList() = default;
 
+PatternList& PatternList::operator=(const PatternList& other) = default;
+
 void PatternList::Append(const Pattern& pattern) {
   patterns_.push_back(pattern);
+  Compile(pattern);
+}
+
+const PatternList::Dfa* PatternList::DfaCache::Set(
+    std::unique_ptr<Dfa> dfa) const {
+  Dfa* expected = nullptr;
+  if (dfa_.compare_exchange_strong(expected, dfa.get(),
+                                   std::memory_order_acq_rel)) {
+    return dfa.release();
+  }
+  return expected;
 }
 
 void PatternList::SetFromValue(const Value& v, Err* err) {
-  patterns_.clear();
+  *this = PatternList();
 
   if (v.type() != Value::LIST) {
     *err = Err(v.origin(), "This value must be a list.");
@@ -204,16 +230,37 @@ void PatternList::SetFromValue(const Value& v, Err* err) {
   for (const auto& elem : list) {
     if (!elem.VerifyTypeIs(Value::STRING, err))
       return;
-    patterns_.push_back(Pattern(elem.string_value()));
+    Append(Pattern(elem.string_value()));
   }
 }
 
 bool PatternList::MatchesString(const std::string& s) const {
-  for (const auto& pattern : patterns_) {
-    if (pattern.MatchesString(s))
+  if (matches_everything_)
+    return true;
+
+  if (exact_.find(s) != exact_.end())
+    return true;
+
+  std::string_view view(s);
+  for (size_t size : suffix_sizes_) {
+    if (size > view.size())
+      break;
+    if (suffixes_.find(view.substr(view.size() - size)) != suffixes_.end())
       return true;
   }
-  return false;
+  for (size_t size : prefix_sizes_) {
+    if (size > view.size())
+      break;
+    if (prefixes_.find(view.substr(0, size)) != prefixes_.end())
+      return true;
+  }
+
+  for (const std::string& substring : substrings_) {
+    if (view.find(substring) != std::string_view::npos)
+      return true;
+  }
+
+  return !start_states_.empty() && AutomatonMatches(view);
 }
 
 bool PatternList::MatchesValue(const Value& v) const {
@@ -221,3 +268,323 @@ bool PatternList::MatchesValue(const Value& v) const {
     return MatchesString(v.string_value());
   return false;
 }
+
+void PatternList::Compile(const Pattern& pattern) {
+  using Subrange = Pattern::Subrange;
+  const std::vector<Subrange>& ranges = pattern.subranges();
+
+  auto add_sized = [](const std::string& literal,
+                      std::set<std::string, std::less<>>* literals,
+                      std::vector<size_t>* sizes) {
+    literals->insert(literal);
+    auto found = std::lower_bound(sizes->begin(), sizes->end(), literal.size());
+    if (found == sizes->end() || *found != literal.size())
+      sizes->insert(found, literal.size());
+  };
+
+  if (ranges.empty()) {
+    // Empty pattern matches only empty string.
+    exact_.insert(std::string());
+  } else if (ranges.size() == 1 && ranges[0].type == Subrange::LITERAL) {
+    exact_.insert(ranges[0].literal);
+  } else if (ranges.size() == 1 && ranges[0].type == Subrange::ANYTHING) {
+    matches_everything_ = true;
+  } else if (ranges.size() == 2 && ranges[0].type == Subrange::ANYTHING &&
+             ranges[1].type == Subrange::LITERAL) {
+    add_sized(ranges[1].literal, &suffixes_, &suffix_sizes_);
+  } else if (ranges.size() == 2 && ranges[0].type == Subrange::LITERAL &&
+             ranges[1].type == Subrange::ANYTHING) {
+    add_sized(ranges[0].literal, &prefixes_, &prefix_sizes_);
+  } else if (ranges.size() == 3 && ranges[0].type == Subrange::ANYTHING &&
+             ranges[1].type == Subrange::LITERAL &&
+             ranges[2].type == Subrange::ANYTHING) {
+    substrings_.push_back(ranges[1].literal);
+  } else {
+    CompileToAutomaton(pattern);
+  }
+}
+
+void PatternList::CompileToAutomaton(const Pattern& pattern) {
+  using Subrange = Pattern::Subrange;
+  const std::vector<Subrange>& ranges = pattern.subranges();
+
+  start_states_.push_back(static_cast<uint32_t>(states_.size()));
+
+  // Emit the states of each subrange, remembering where each one starts so
+  // the transitions to the following subrange can be filled in afterwards.
+  std::vector<uint32_t> range_begin;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    range_begin.push_back(static_cast<uint32_t>(states_.size()));
+    switch (ranges[i].type) {
+      case Subrange::LITERAL:
+        for (char c : ranges[i].literal)
+          states_.push_back(State(State::CHAR, c));
+        break;
+      case Subrange::ANYTHING:
+        states_.push_back(State(i == ranges.size() - 1 ? State::ANYTHING_TO_END
+                                                       : State::ANYTHING));
+        break;
+      case Subrange::PATH_BOUNDARY:
+        // A boundary needs two states since one matched implicitly (at the
+        // beginning or end of the string) can't be followed by another
+        // implicit match.
+        states_.push_back(State(State::BOUNDARY));
+        states_.push_back(State(State::BOUNDARY_SLASH));
+        break;
+    }
+  }
+  range_begin.push_back(static_cast<uint32_t>(states_.size()));
+  states_.push_back(State(State::MATCH));
+
+  for (size_t i = 0; i < ranges.size(); i++) {
+    uint32_t next = range_begin[i + 1];
+    for (uint32_t state = range_begin[i]; state < next; state++) {
+      // Characters of a literal chain to each other; the last one and all
+      // other state types continue with the next subrange.
+      if (states_[state].type == State::CHAR && state + 1 < next)
+        states_[state].next = state + 1;
+      else
+        states_[state].next = next;
+    }
+  }
+
+  automaton_matches_empty_ = SimulateAutomaton(std::string_view());
+
+  // The automaton changed.
+  dfa_.Reset();
+}
+
+std::unique_ptr<PatternList::Dfa> PatternList::BuildDfa() const {
+  auto dfa = std::make_unique<Dfa>();
+
+  // Every character used by a literal gets its own class, as does the '/'
+  // matched by path boundaries. All other characters behave the same and
+  // share class 0.
+  dfa->class_count = 1;
+  auto add_class = [&dfa](char c) {
+    uint16_t& char_class = dfa->char_classes[static_cast<unsigned char>(c)];
+    if (!char_class)
+      char_class = static_cast<uint16_t>(dfa->class_count++);
+  };
+  add_class('/');
+  for (const State& state : states_) {
+    if (state.type == State::CHAR)
+      add_class(state.c);
+  }
+  const uint16_t slash_class =
+      dfa->char_classes[static_cast<unsigned char>('/')];
+
+  // Each DFA state is identified by the automaton states entered by consuming
+  // a character (the "kernel"). Transitions are computed from the closure of
+  // the kernel in the middle of the string, while a match at the end of the
+  // string depends on the closure at the end.
+  std::vector<uint32_t> added(states_.size(), 0);
+  uint32_t generation = 1;
+  std::map<std::vector<uint32_t>, int32_t> dfa_ids;
+  std::vector<std::vector<uint32_t>> closures(1);
+  for (uint32_t start : start_states_) {
+    if (AddState(start, true, false, generation, &added, &closures[0])) {
+      // Matches any non-empty string.
+      dfa->start = kDfaMatch;
+      dfa->valid = true;
+      return dfa;
+    }
+  }
+  dfa->start = 0;
+  dfa->accepts.push_back(false);  // The start is never the end here.
+
+  for (size_t i = 0; i < closures.size(); i++) {
+    if (closures.size() > kMaxDfaStates) {
+      dfa->transitions.clear();
+      dfa->accepts.clear();
+      return dfa;
+    }
+
+    for (size_t char_class = 0; char_class < dfa->class_count; char_class++) {
+      std::vector<uint32_t> kernel;
+      for (uint32_t index : closures[i]) {
+        const State& state = states_[index];
+        switch (state.type) {
+          case State::CHAR:
+            if (dfa->char_classes[static_cast<unsigned char>(state.c)] ==
+                char_class)
+              kernel.push_back(state.next);
+            break;
+          case State::ANYTHING:
+            kernel.push_back(index);
+            break;
+          case State::BOUNDARY:
+          case State::BOUNDARY_SLASH:
+            if (char_class == slash_class)
+              kernel.push_back(state.next);
+            break;
+          case State::ANYTHING_TO_END:
+          case State::MATCH:
+            break;
+        }
+      }
+
+      int32_t target = kDfaNoMatch;
+      if (!kernel.empty()) {
+        std::sort(kernel.begin(), kernel.end());
+        kernel.erase(std::unique(kernel.begin(), kernel.end()), kernel.end());
+
+        auto found = dfa_ids.find(kernel);
+        if (found != dfa_ids.end()) {
+          target = found->second;
+        } else {
+          std::vector<uint32_t> closure;
+          bool matches_rest = false;
+          generation++;
+          for (uint32_t index : kernel) {
+            matches_rest |=
+                AddState(index, false, false, generation, &added, &closure);
+          }
+
+          if (matches_rest) {
+            target = kDfaMatch;
+          } else {
+            std::vector<uint32_t> end_closure;
+            bool accepts = false;
+            generation++;
+            for (uint32_t index : kernel) {
+              accepts |=
+                  AddState(index, false, true, generation, &added, &end_closure);
+            }
+            target = static_cast<int32_t>(closures.size());
+            closures.push_back(std::move(closure));
+            dfa->accepts.push_back(accepts);
+          }
+          dfa_ids[kernel] = target;
+        }
+      }
+      dfa->transitions.push_back(target);
+    }
+  }
+  dfa->valid = true;
+  return dfa;
+}
+
+bool PatternList::AutomatonMatches(std::string_view s) const {
+  if (s.empty())
+    return automaton_matches_empty_;
+
+  const Dfa* dfa = dfa_.Get();
+  if (!dfa) {
+    if (!dfa_.ShouldBuild())
+      return SimulateAutomaton(s);
+    dfa = dfa_.Set(BuildDfa());
+  }
+  if (!dfa->valid)
+    return SimulateAutomaton(s);
+
+  int32_t state = dfa->start;
+  for (size_t i = 0; i < s.size() && state >= 0; i++) {
+    uint16_t char_class = dfa->char_classes[static_cast<unsigned char>(s[i])];
+    state = dfa->transitions[state * dfa->class_count + char_class];
+  }
+  if (state < 0)
+    return state == kDfaMatch;
+  return dfa->accepts[state];
+}
+
+bool PatternList::SimulateAutomaton(std::string_view s) const {
+  // Standard simulation of the nondeterministic automaton: track the set of
+  // states that can be active after each character. States are deduped per
+  // position using the position (plus one) as the generation.
+  std::vector<uint32_t> added(states_.size(), 0);
+  std::vector<uint32_t> current;
+  std::vector<uint32_t> next;
+
+  for (uint32_t start : start_states_) {
+    if (AddState(start, true, s.empty(), 1, &added, &current))
+      return true;
+  }
+
+  for (size_t pos = 0; pos < s.size() && !current.empty(); pos++) {
+    char c = s[pos];
+    bool at_end = pos + 1 == s.size();
+    uint32_t generation = static_cast<uint32_t>(pos + 2);
+    next.clear();
+    for (uint32_t index : current) {
+      const State& state = states_[index];
+      bool matched = false;
+      switch (state.type) {
+        case State::CHAR:
+          if (state.c == c) {
+            matched =
+                AddState(state.next, false, at_end, generation, &added, &next);
+          }
+          break;
+        case State::ANYTHING:
+          matched = AddState(index, false, at_end, generation, &added, &next);
+          break;
+        case State::BOUNDARY:
+        case State::BOUNDARY_SLASH:
+          if (c == '/') {
+            matched =
+                AddState(state.next, false, at_end, generation, &added, &next);
+          }
+          break;
+        case State::ANYTHING_TO_END:
+        case State::MATCH:
+          // Never added to a set, see AddState().
+          NOTREACHED();
+          break;
+      }
+      if (matched)
+        return true;
+    }
+    current.swap(next);
+  }
+  return false;
+}
+
+bool PatternList::AddState(uint32_t index,
+                           bool at_begin,
+                           bool at_end,
+                           uint32_t generation,
+                           std::vector<uint32_t>* added,
+                           std::vector<uint32_t>* set) const {
+  // Follow the chain of states that can be entered without consuming a
+  // character. This mirrors Pattern::RecursiveMatch().
+  for (;;) {
+    if ((*added)[index] == generation)
+      return false;
+    (*added)[index] = generation;
+
+    const State& state = states_[index];
+    switch (state.type) {
+      case State::CHAR:
+      case State::BOUNDARY_SLASH:
+        set->push_back(index);
+        return false;
+
+      case State::ANYTHING:
+        set->push_back(index);
+        // Like RecursiveMatch(), a * that isn't last never lets the rest of
+        // the pattern start at the end of the string.
+        if (at_end)
+          return false;
+        index = state.next;
+        break;
+
+      case State::ANYTHING_TO_END:
+        return true;
+
+      case State::BOUNDARY:
+        set->push_back(index);
+        if (!at_begin && !at_end)
+          return false;
+        // Implicit boundary. A boundary directly following can't also be
+        // implicit, so continue with its second state.
+        index = state.next;
+        if (states_[index].type == State::BOUNDARY)
+          index++;
+        break;
+
+      case State::MATCH:
+        return at_end;
+    }
+  }
+}
@@ -6,10 +6,17 @@
 #define TOOLS_GN_PATTERN_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "base/gtest_prod_util.h"
 #include "gn/value.h"
 
 extern const char kFilePattern_Help[];
@@ -53,6 +60,8 @@ class Pattern {
   // Returns true if the current pattern matches the given string.
   bool MatchesString(const std::string& s) const;
 
+  const std::vector<Subrange>& subranges() const { return subranges_; }
+
  private:
   // allow_implicit_path_boundary determines if a path boundary should accept
   // matches at the beginning or end of the string.
@@ -68,12 +77,23 @@ class Pattern {
   bool is_suffix_;
 };
 
+// A list of patterns that matches a string if any of its patterns do.
+//
+// The patterns are compiled as they are added so that matching a string
+// doesn't need to try each pattern in turn: the common forms "foo", "*foo",
+// "foo*", "*foo*" and "*" are looked up in tables, and all other patterns are
+// combined into a single automaton. Once the list has been matched against a
+// few strings, the automaton is converted to a DFA that runs over the string
+// in one pass, so lists that are only matched a few times (most filter
+// calls) don't pay for building it.
 class PatternList {
  public:
   PatternList();
   PatternList(const PatternList& other);
   ~PatternList();
 
+  PatternList& operator=(const PatternList& other);
+
   bool is_empty() const { return patterns_.empty(); }
 
   void Append(const Pattern& pattern);
@@ -86,7 +106,136 @@ class PatternList {
   bool MatchesValue(const Value& v) const;
 
  private:
+  struct State {
+    enum Type {
+      CHAR,             // Consumes |c|.
+      ANYTHING,         // * followed by more subranges.
+      ANYTHING_TO_END,  // * at the end, matches the rest of the string.
+      BOUNDARY,         // \b, may match the beginning or end of the string.
+      BOUNDARY_SLASH,   // \b right after an implicit boundary, needs a '/'.
+      MATCH,            // Matches the end of the string.
+    };
+
+    State(Type t, char ch = 0) : type(t), c(ch) {}
+
+    Type type;
+    char c;
+
+    // Index of the state for the following subrange.
+    uint32_t next = 0;
+  };
+
+  // Adds |pattern| to the lookup tables or the automaton.
+  void Compile(const Pattern& pattern);
+  void CompileToAutomaton(const Pattern& pattern);
+
+  // The automaton converted to a DFA. Characters are mapped to classes that
+  // the automaton can't tell apart. |transitions| holds, for each DFA state,
+  // the next state for each class, or one of the kDfa* values in pattern.cc.
+  // |accepts| says whether the DFA state is a match at the end of the string.
+  struct Dfa {
+    // False if the DFA got too large, in which case the automaton is
+    // simulated instead.
+    bool valid = false;
+    uint16_t char_classes[256] = {};
+    size_t class_count = 0;
+    int32_t start = 0;
+    std::vector<int32_t> transitions;
+    std::vector<bool> accepts;
+  };
+
+  // Holds the DFA once built, and counts the matches until then. Lists are
+  // matched from several threads (the patterns of tools, for instance), so
+  // the matches may race to build it and the first one to finish wins.
+  // Copies and assignments start over.
+  class DfaCache {
+   public:
+    DfaCache() = default;
+    DfaCache(const DfaCache&) {}
+    ~DfaCache() { Reset(); }
+
+    DfaCache& operator=(const DfaCache&) {
+      Reset();
+      return *this;
+    }
+
+    const Dfa* Get() const { return dfa_.load(std::memory_order_acquire); }
+
+    // Counts a match without the DFA and returns whether it's time to build
+    // it.
+    bool ShouldBuild() const {
+      return runs_.fetch_add(1, std::memory_order_relaxed) >= kRunsBeforeDfa;
+    }
+
+    // Stores |dfa| unless another thread did first, and returns the stored
+    // one.
+    const Dfa* Set(std::unique_ptr<Dfa> dfa) const;
+
+    void Reset() {
+      delete dfa_.exchange(nullptr);
+      runs_.store(0, std::memory_order_relaxed);
+    }
+
+   private:
+    // Simulating the automaton costs about as much as building a small DFA,
+    // so the DFA only pays off for lists that are matched many times.
+    static constexpr uint32_t kRunsBeforeDfa = 32;
+
+    mutable std::atomic<Dfa*> dfa_{nullptr};
+    mutable std::atomic<uint32_t> runs_{0};
+  };
+
+  FRIEND_TEST_ALL_PREFIXES(PatternList, DfaFallback);
+
+  // Converts the automaton to a DFA by subset construction. The DFA isn't
+  // valid if it gets too large.
+  std::unique_ptr<Dfa> BuildDfa() const;
+
+  // Returns true if any of the patterns compiled into the automaton match.
+  bool AutomatonMatches(std::string_view s) const;
+
+  // Runs the automaton state by state. Used to build the DFA, and to match
+  // when it couldn't be built.
+  bool SimulateAutomaton(std::string_view s) const;
+
+  // Adds |index| to |*set| along with the states reachable from it without
+  // consuming a character, given whether the current position is the
+  // beginning and/or end of the string. |added| holds the generation each
+  // state was last added in, and is used to avoid duplicates. Returns true if
+  // this completes a match.
+  bool AddState(uint32_t index,
+                bool at_begin,
+                bool at_end,
+                uint32_t generation,
+                std::vector<uint32_t>* added,
+                std::vector<uint32_t>* set) const;
+
   std::vector<Pattern> patterns_;
+
+  // Set when the list contains "*".
+  bool matches_everything_ = false;
+
+  // Literal patterns, and the literals of "*foo" and "foo*" patterns. The
+  // sizes are sorted so lookups can stop at the length of the string.
+  std::set<std::string, std::less<>> exact_;
+  std::set<std::string, std::less<>> suffixes_;
+  std::vector<size_t> suffix_sizes_;
+  std::set<std::string, std::less<>> prefixes_;
+  std::vector<size_t> prefix_sizes_;
+
+  // Literals of "*foo*" patterns.
+  std::vector<std::string> substrings_;
+
+  // Nondeterministic automaton for all other patterns. |start_states_| holds
+  // the first state of each pattern.
+  std::vector<State> states_;
+  std::vector<uint32_t> start_states_;
+
+  bool automaton_matches_empty_ = false;
+
+  // Built lazily, since building it costs more than simulating the automaton
+  // on a few strings.
+  DfaCache dfa_;
 };
 
 #endif  // TOOLS_GN_PATTERN_H_
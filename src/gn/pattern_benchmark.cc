@@ -0,0 +1,156 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "gn/pattern.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+// Source file names in the shape typically passed to filter_exclude().
+std::vector<std::string> MakeSources() {
+  const char* kSuffixes[] = {".cc",       "_win.cc",   "_mac.mm",
+                             "_linux.cc", "_posix.cc", ".h",
+                             "_test.cc",  "_fuchsia.cc"};
+  std::vector<std::string> sources;
+  for (int dir = 0; dir < 50; dir++) {
+    for (int file = 0; file < 40; file++) {
+      std::string path = "//components/module" + std::to_string(dir) + "/";
+      if (file % 10 == 0)
+        path += "win/";
+      path += "file" + std::to_string(file) + kSuffixes[file % 8];
+      sources.push_back(path);
+    }
+  }
+  return sources;
+}
+
+const char* kPlatformPatterns[] = {
+    "*_win.cc",     "*_mac.mm",  "*\\bwin/*", "*_test.cc",
+    "*_fuchsia.cc", "*_posix*", "*\\bandroid\\b*", "*/test/*.h",
+};
+
+// Many suffix patterns, as produced by build files that list excluded files
+// individually.
+std::vector<std::string> MakeManyPatterns() {
+  std::vector<std::string> patterns;
+  for (int i = 0; i < 200; i++)
+    patterns.push_back("*/file" + std::to_string(i) + "_win.cc");
+  return patterns;
+}
+
+template <typename Patterns>
+void RunBacktracking(benchmark::State& state,
+                     const Patterns& pattern_strings) {
+  std::vector<Pattern> patterns;
+  for (const auto& p : pattern_strings)
+    patterns.push_back(Pattern(p));
+  std::vector<std::string> sources = MakeSources();
+
+  while (state.KeepRunning()) {
+    int matches = 0;
+    for (const std::string& source : sources) {
+      for (const Pattern& pattern : patterns) {
+        if (pattern.MatchesString(source)) {
+          matches++;
+          break;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * sources.size());
+}
+
+template <typename Patterns>
+void RunCompiled(benchmark::State& state, const Patterns& pattern_strings) {
+  PatternList list;
+  for (const auto& p : pattern_strings)
+    list.Append(Pattern(p));
+  std::vector<std::string> sources = MakeSources();
+
+  while (state.KeepRunning()) {
+    int matches = 0;
+    for (const std::string& source : sources) {
+      if (list.MatchesString(source))
+        matches++;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * sources.size());
+}
+
+// Like filter_exclude(): the patterns are compiled for each call and matched
+// against a handful of sources.
+template <typename Patterns>
+void RunFilterBacktracking(benchmark::State& state,
+                           const Patterns& pattern_strings) {
+  std::vector<std::string> sources = MakeSources();
+  sources.resize(8);
+
+  while (state.KeepRunning()) {
+    std::vector<Pattern> patterns;
+    for (const auto& p : pattern_strings)
+      patterns.push_back(Pattern(p));
+    int matches = 0;
+    for (const std::string& source : sources) {
+      for (const Pattern& pattern : patterns) {
+        if (pattern.MatchesString(source)) {
+          matches++;
+          break;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Patterns>
+void RunFilterCompiled(benchmark::State& state,
+                       const Patterns& pattern_strings) {
+  std::vector<std::string> sources = MakeSources();
+  sources.resize(8);
+
+  while (state.KeepRunning()) {
+    PatternList list;
+    for (const auto& p : pattern_strings)
+      list.Append(Pattern(p));
+    int matches = 0;
+    for (const std::string& source : sources) {
+      if (list.MatchesString(source))
+        matches++;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(PatternList_Platform_Backtracking) {
+  RunBacktracking(state, kPlatformPatterns);
+}
+
+BENCHMARK(PatternList_Platform_Compiled) {
+  RunCompiled(state, kPlatformPatterns);
+}
+
+BENCHMARK(PatternList_ManySuffixes_Backtracking) {
+  RunBacktracking(state, MakeManyPatterns());
+}
+
+BENCHMARK(PatternList_ManySuffixes_Compiled) {
+  RunCompiled(state, MakeManyPatterns());
+}
+
+BENCHMARK(PatternList_FilterCall_Backtracking) {
+  RunFilterBacktracking(state, kPlatformPatterns);
+}
+
+BENCHMARK(PatternList_FilterCall_Compiled) {
+  RunFilterCompiled(state, kPlatformPatterns);
+}
@@ -5,8 +5,12 @@
 #include <stddef.h>
 
 #include <iterator>
+#include <string>
+#include <vector>
 
+#include "gn/err.h"
 #include "gn/pattern.h"
+#include "gn/value.h"
 #include "util/test/test.h"
 
 namespace {
@@ -17,49 +21,132 @@ struct Case {
   bool expected_match;
 };
 
+const Case kPatternCases[] = {
+    // Empty pattern matches only empty string.
+    {"", "", true},
+    {"", "foo", false},
+    // Exact matches.
+    {"foo", "foo", true},
+    {"foo", "bar", false},
+    // Path boundaries.
+    {"\\b", "", true},
+    {"\\b", "/", true},
+    {"\\b\\b", "/", true},
+    {"\\b\\b\\b", "", false},
+    {"\\b\\b\\b", "/", true},
+    {"\\b", "//", false},
+    {"\\bfoo\\b", "foo", true},
+    {"\\bfoo\\b", "/foo/", true},
+    {"\\b\\bfoo", "/foo", true},
+    // *
+    {"*", "", true},
+    {"*", "foo", true},
+    {"*foo", "foo", true},
+    {"*foo", "gagafoo", true},
+    {"*foo", "gagafoob", false},
+    {"foo*bar", "foobar", true},
+    {"foo*bar", "foo-bar", true},
+    {"foo*bar", "foolalalalabar", true},
+    {"foo*bar", "foolalalalabaz", false},
+    {"*a*b*c*d*", "abcd", true},
+    {"*a*b*c*d*", "1a2b3c4d5", true},
+    {"*a*b*c*d*", "1a2b3c45", false},
+    {"*\\bfoo\\b*", "foo", true},
+    {"*\\bfoo\\b*", "/foo/", true},
+    {"*\\bfoo\\b*", "foob", false},
+    {"*\\bfoo\\b*", "lala/foo/bar/baz", true},
+};
+
 }  // namespace
 
 TEST(Pattern, Matches) {
-  Case pattern_cases[] = {
-      // Empty pattern matches only empty string.
-      {"", "", true},
-      {"", "foo", false},
-      // Exact matches.
-      {"foo", "foo", true},
-      {"foo", "bar", false},
-      // Path boundaries.
-      {"\\b", "", true},
-      {"\\b", "/", true},
-      {"\\b\\b", "/", true},
-      {"\\b\\b\\b", "", false},
-      {"\\b\\b\\b", "/", true},
-      {"\\b", "//", false},
-      {"\\bfoo\\b", "foo", true},
-      {"\\bfoo\\b", "/foo/", true},
-      {"\\b\\bfoo", "/foo", true},
-      // *
-      {"*", "", true},
-      {"*", "foo", true},
-      {"*foo", "foo", true},
-      {"*foo", "gagafoo", true},
-      {"*foo", "gagafoob", false},
-      {"foo*bar", "foobar", true},
-      {"foo*bar", "foo-bar", true},
-      {"foo*bar", "foolalalalabar", true},
-      {"foo*bar", "foolalalalabaz", false},
-      {"*a*b*c*d*", "abcd", true},
-      {"*a*b*c*d*", "1a2b3c4d5", true},
-      {"*a*b*c*d*", "1a2b3c45", false},
-      {"*\\bfoo\\b*", "foo", true},
-      {"*\\bfoo\\b*", "/foo/", true},
-      {"*\\bfoo\\b*", "foob", false},
-      {"*\\bfoo\\b*", "lala/foo/bar/baz", true},
-  };
-  for (size_t i = 0; i < std::size(pattern_cases); i++) {
-    const Case& c = pattern_cases[i];
+  for (size_t i = 0; i < std::size(kPatternCases); i++) {
+    const Case& c = kPatternCases[i];
     Pattern pattern(c.pattern);
     bool result = pattern.MatchesString(c.candidate);
     EXPECT_EQ(c.expected_match, result)
         << i << ": \"" << c.pattern << "\", \"" << c.candidate << "\"";
   }
 }
+
+// The compiled PatternList must agree with matching each Pattern in turn.
+TEST(PatternList, MatchesLikePatterns) {
+  std::vector<std::string> patterns = {
+      "*.cc", "foo*", "*oo*", "*", "\\b*", "*\\b",
+      "foo*\\b", "\\b*\\b", "a*b*", "*/foo/*.h", "\\b\\b", "*\\b\\b",
+  };
+  std::vector<std::string> candidates = {
+      "foo/", "/", "a/b", "x.cc", "foo/bar.h", "/foo/x.h", "ab", "//",
+  };
+  for (const Case& c : kPatternCases) {
+    patterns.push_back(c.pattern);
+    candidates.push_back(c.candidate);
+  }
+
+  for (const std::string& a : patterns) {
+    for (const std::string& b : patterns) {
+      PatternList list;
+      list.Append(Pattern(a));
+      list.Append(Pattern(b));
+      for (const std::string& candidate : candidates) {
+        bool expected = Pattern(a).MatchesString(candidate) ||
+                        Pattern(b).MatchesString(candidate);
+        EXPECT_EQ(expected, list.MatchesString(candidate))
+            << "\"" << a << "\", \"" << b << "\", \"" << candidate << "\"";
+      }
+    }
+  }
+}
+
+// Patterns "*<c>*z" for distinct characters need a DFA state for each set of
+// characters seen so far, which is more than the DFA is allowed to have. The
+// list then simulates the automaton.
+TEST(PatternList, DfaFallback) {
+  const std::string kChars = "abcdefghijkl";
+  std::vector<Pattern> patterns;
+  PatternList list;
+  for (char c : kChars) {
+    patterns.push_back(Pattern(std::string("*") + c + "*z"));
+    list.Append(patterns.back());
+  }
+
+  std::vector<std::string> candidates = {"az", "lz", "abc", "zz", "abcdefz",
+                                         "kjihgfedcba", "z", "xyz", "lzq"};
+  // The first matches simulate the automaton, the later ones try to build the
+  // DFA, which is too large here, and fall back to simulating it.
+  for (int i = 0; i < 10; i++) {
+    for (const std::string& candidate : candidates) {
+      bool expected = false;
+      for (const Pattern& pattern : patterns)
+        expected |= pattern.MatchesString(candidate);
+      EXPECT_EQ(expected, list.MatchesString(candidate)) << candidate;
+    }
+  }
+
+  const PatternList::Dfa* dfa = list.dfa_.Get();
+  ASSERT_TRUE(dfa);
+  EXPECT_FALSE(dfa->valid);
+
+  // Appending resets the DFA, which is built again after enough matches.
+  list.Append(Pattern("\\bfoo\\b*"));
+  EXPECT_FALSE(list.dfa_.Get());
+  for (int i = 0; i < 100; i++)
+    EXPECT_TRUE(list.MatchesString("foo/bar"));
+  EXPECT_TRUE(list.dfa_.Get());
+}
+
+TEST(PatternList, SetFromValue) {
+  Value value(nullptr, Value::LIST);
+  value.list_value().push_back(Value(nullptr, "*.cc"));
+  value.list_value().push_back(Value(nullptr, "\\bwin/*"));
+
+  PatternList list;
+  list.Append(Pattern("*"));
+  Err err;
+  list.SetFromValue(value, &err);
+  ASSERT_FALSE(err.has_error());
+
+  EXPECT_TRUE(list.MatchesString("foo.cc"));
+  EXPECT_TRUE(list.MatchesString("win/bar.h"));
+  EXPECT_FALSE(list.MatchesString("iwin/bar.h"));
+}
@@ -0,0 +1,133 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "gn/pointer_set.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+struct Item {
+  int value = 0;
+};
+
+// Separately allocated objects, like the targets and configs that pointer
+// sets hold in practice.
+std::vector<std::unique_ptr<Item>> MakeItems(size_t count) {
+  std::vector<std::unique_ptr<Item>> items;
+  for (size_t i = 0; i < count; i++)
+    items.push_back(std::make_unique<Item>());
+  return items;
+}
+
+std::vector<const Item*> GetPointers(
+    const std::vector<std::unique_ptr<Item>>& items) {
+  std::vector<const Item*> pointers;
+  for (const auto& item : items)
+    pointers.push_back(item.get());
+  return pointers;
+}
+
+void RunInsert(benchmark::State& state, size_t count) {
+  auto items = MakeItems(count);
+  std::vector<const Item*> pointers = GetPointers(items);
+  while (state.KeepRunning()) {
+    PointerSet<const Item> set;
+    for (const Item* item : pointers)
+      set.add(item);
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// The same as RunInsert() with std::unordered_set, for comparison.
+void RunInsertStd(benchmark::State& state, size_t count) {
+  auto items = MakeItems(count);
+  std::vector<const Item*> pointers = GetPointers(items);
+  while (state.KeepRunning()) {
+    std::unordered_set<const Item*> set;
+    for (const Item* item : pointers)
+      set.insert(item);
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Looks up every item of a set and as many items which aren't in it.
+void RunLookup(benchmark::State& state, size_t count) {
+  auto items = MakeItems(count);
+  auto others = MakeItems(count);
+  std::vector<const Item*> pointers = GetPointers(items);
+  std::vector<const Item*> other_pointers = GetPointers(others);
+  PointerSet<const Item> set(pointers.begin(), pointers.end());
+  while (state.KeepRunning()) {
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+      found += set.contains(pointers[i]);
+      found += set.contains(other_pointers[i]);
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+
+void RunIterate(benchmark::State& state, size_t count) {
+  auto items = MakeItems(count);
+  std::vector<const Item*> pointers = GetPointers(items);
+  PointerSet<const Item> set(pointers.begin(), pointers.end());
+  while (state.KeepRunning()) {
+    int sum = 0;
+    for (const Item* item : set)
+      sum += item->value;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+}  // namespace
+
+// 16 is about the number of direct dependencies of a target, 1000 and 100000
+// are typical sizes of transitive sets in medium and large builds.
+BENCHMARK(PointerSet_Insert_16) {
+  RunInsert(state, 16);
+}
+
+BENCHMARK(PointerSet_Insert_1000) {
+  RunInsert(state, 1000);
+}
+
+BENCHMARK(PointerSet_Insert_100000) {
+  RunInsert(state, 100000);
+}
+
+BENCHMARK(PointerSet_InsertStdUnorderedSet_1000) {
+  RunInsertStd(state, 1000);
+}
+
+BENCHMARK(PointerSet_InsertStdUnorderedSet_100000) {
+  RunInsertStd(state, 100000);
+}
+
+BENCHMARK(PointerSet_Lookup_16) {
+  RunLookup(state, 16);
+}
+
+BENCHMARK(PointerSet_Lookup_1000) {
+  RunLookup(state, 1000);
+}
+
+BENCHMARK(PointerSet_Lookup_100000) {
+  RunLookup(state, 100000);
+}
+
+BENCHMARK(PointerSet_Iterate_1000) {
+  RunIterate(state, 1000);
+}
+
+BENCHMARK(PointerSet_Iterate_100000) {
+  RunIterate(state, 100000);
+}
@@ -0,0 +1,356 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/profiler.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "gn/input_file.h"
+#include "gn/location.h"
+#include "gn/parse_tree.h"
+#include "gn/source_file.h"
+#include "util/ticks.h"
+
+namespace {
+
+// The location of a call. This is copied out of the parse tree, which may be
+// freed before the profile is reported.
+struct CallSite {
+  SourceFile file;
+  int line = -1;
+  int column = -1;
+
+  bool operator==(const CallSite& other) const {
+    return file == other.file && line == other.line && column == other.column;
+  }
+};
+
+// A node in a thread's call tree. Node 0 is the root, which is not a call.
+struct ProfileNode {
+  uint32_t parent = 0;
+  CallSite call;
+  ScopedProfile::Kind kind = ScopedProfile::FUNCTION;
+  std::string name;
+  std::string location;  // Description of |call| for the report.
+
+  uint64_t calls = 0;
+  Ticks total = 0;     // Including children.
+  Ticks children = 0;  // Total of the children.
+};
+
+}  // namespace
+
+// The call tree for the script run on one thread. Only the owning thread
+// modifies it so no locking is needed.
+class ProfileThread {
+ public:
+  ProfileThread() : nodes_(1) {}
+
+  void Enter(ScopedProfile::Kind kind,
+             const FunctionCallNode* call,
+             std::string_view name) {
+    uint32_t parent = stack_.empty() ? 0 : stack_.back().node;
+    const Location& location = call->function().location();
+    CallSite site;
+    if (location.file())
+      site.file = location.file()->name();
+    site.line = location.line_number();
+    site.column = location.column_number();
+
+    auto inserted = children_.emplace(std::make_pair(parent, site), 0);
+    if (inserted.second) {
+      inserted.first->second = static_cast<uint32_t>(nodes_.size());
+      ProfileNode& node = nodes_.emplace_back();
+      node.parent = parent;
+      node.call = site;
+      node.kind = kind;
+      node.name.assign(name);
+      node.location = location.Describe(true);
+    }
+    stack_.push_back({inserted.first->second, TicksNow()});
+  }
+
+  void Leave() {
+    Frame frame = stack_.back();
+    stack_.pop_back();
+    Ticks duration = TicksDelta(TicksNow(), frame.begin).raw();
+
+    ProfileNode& node = nodes_[frame.node];
+    node.calls++;
+    node.total += duration;
+    nodes_[node.parent].children += duration;
+  }
+
+  // Parents always precede their children.
+  const std::vector<ProfileNode>& nodes() const { return nodes_; }
+
+  void Clear() {
+    DCHECK(stack_.empty());
+    nodes_.assign(1, ProfileNode());
+    children_.clear();
+  }
+
+ private:
+  struct Frame {
+    uint32_t node;
+    Ticks begin;
+  };
+
+  struct ChildHash {
+    size_t operator()(const std::pair<uint32_t, CallSite>& key) const {
+      size_t hash = SourceFile::PtrHash()(key.second.file);
+      hash = hash * 31 + static_cast<size_t>(key.second.line);
+      hash = hash * 31 + static_cast<size_t>(key.second.column);
+      return hash * 31 + key.first;
+    }
+  };
+
+  std::vector<ProfileNode> nodes_;
+
+  // Maps a parent node and call site to the child node.
+  std::unordered_map<std::pair<uint32_t, CallSite>, uint32_t, ChildHash>
+      children_;
+
+  std::vector<Frame> stack_;
+};
+
+namespace {
+
+class Profiler {
+ public:
+  Profiler() = default;
+  // Threads leaked intentionally.
+
+  // Returns the call tree for the current thread, creating it the first time
+  // the thread runs a profiled call.
+  ProfileThread* GetThread();
+
+  // Returns a copy of the list of threads for threadsafety.
+  std::vector<const ProfileThread*> threads() const {
+    std::lock_guard<std::mutex> lock(lock_);
+    return std::vector<const ProfileThread*>(threads_.begin(), threads_.end());
+  }
+
+  // Clears the call trees of all threads. The threads are kept since each
+  // one stays attached to its thread.
+  void Clear() {
+    std::lock_guard<std::mutex> lock(lock_);
+    for (ProfileThread* thread : threads_)
+      thread->Clear();
+  }
+
+ private:
+  mutable std::mutex lock_;
+
+  std::vector<ProfileThread*> threads_;
+
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+};
+
+// Kept when profiling is reset for testing, see Profiler::Clear().
+Profiler* profiler = nullptr;
+bool profiling_enabled = false;
+
+#if !defined(OS_ZOS)
+thread_local ProfileThread* g_profile_thread;
+#else
+// TODO(gabylb) - zos: thread_local not yet supported, use zoslib's impl'n:
+__tlssim<ProfileThread*> __g_profile_thread_impl(nullptr);
+#define g_profile_thread (*__g_profile_thread_impl.access())
+#endif
+
+ProfileThread* Profiler::GetThread() {
+  if (!g_profile_thread) {
+    g_profile_thread = new ProfileThread;
+    std::lock_guard<std::mutex> lock(lock_);
+    threads_.push_back(g_profile_thread);
+  }
+  return g_profile_thread;
+}
+
+// Merged statistics for one template, function or call site.
+struct ProfileEntry {
+  std::string name;
+  uint64_t calls = 0;
+  Ticks self = 0;
+  Ticks inclusive = 0;
+};
+
+const char* KindName(ScopedProfile::Kind kind) {
+  return kind == ScopedProfile::TEMPLATE ? "template" : "function";
+}
+
+// Returns true if |index| has an ancestor for which |same| returns true.
+// Used to avoid counting the inclusive time of recursive calls twice.
+template <typename Predicate>
+bool HasAncestor(const std::vector<ProfileNode>& nodes,
+                 uint32_t index,
+                 Predicate same) {
+  for (uint32_t i = nodes[index].parent; i != 0; i = nodes[i].parent) {
+    if (same(nodes[i]))
+      return true;
+  }
+  return false;
+}
+
+void AddToEntry(const ProfileNode& node,
+                bool recursive,
+                const std::string& name,
+                std::map<std::string, ProfileEntry>* entries) {
+  ProfileEntry& entry = (*entries)[name];
+  if (entry.name.empty())
+    entry.name = name;
+  entry.calls += node.calls;
+  entry.self += node.total - node.children;
+  if (!recursive)
+    entry.inclusive += node.total;
+}
+
+void SummarizeEntries(const std::map<std::string, ProfileEntry>& entries,
+                      std::ostream& out) {
+  std::vector<const ProfileEntry*> sorted;
+  for (const auto& pair : entries)
+    sorted.push_back(&pair.second);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const ProfileEntry* a, const ProfileEntry* b) {
+              return a->self > b->self;
+            });
+
+  for (const ProfileEntry* entry : sorted) {
+    out << base::StringPrintf(" %9.2f  %9.2f  %8llu  ",
+                              TickDelta(entry->self).InMillisecondsF(),
+                              TickDelta(entry->inclusive).InMillisecondsF(),
+                              static_cast<unsigned long long>(entry->calls));
+    out << entry->name << std::endl;
+  }
+}
+
+}  // namespace
+
+ScopedProfile::ScopedProfile(Kind kind,
+                             const FunctionCallNode* call,
+                             std::string_view name)
+    : thread_(nullptr) {
+  if (profiling_enabled) {
+    thread_ = profiler->GetThread();
+    thread_->Enter(kind, call, name);
+  }
+}
+
+ScopedProfile::~ScopedProfile() {
+  if (thread_)
+    thread_->Leave();
+}
+
+void EnableProfiling() {
+  if (!profiler)
+    profiler = new Profiler;
+  profiling_enabled = true;
+}
+
+bool ProfilingEnabled() {
+  return profiling_enabled;
+}
+
+void ResetProfilingForTesting() {
+  profiling_enabled = false;
+  if (profiler)
+    profiler->Clear();
+}
+
+std::string SummarizeProfile() {
+  if (!profiling_enabled)
+    return std::string();
+
+  std::map<std::string, ProfileEntry> functions;
+  std::map<std::string, ProfileEntry> call_sites;
+  for (const ProfileThread* thread : profiler->threads()) {
+    const std::vector<ProfileNode>& nodes = thread->nodes();
+    for (uint32_t i = 1; i < nodes.size(); i++) {
+      const ProfileNode& node = nodes[i];
+
+      bool recursive_function =
+          HasAncestor(nodes, i, [&node](const ProfileNode& ancestor) {
+            return ancestor.kind == node.kind && ancestor.name == node.name;
+          });
+      AddToEntry(node, recursive_function,
+                 std::string(KindName(node.kind)) + " " + node.name,
+                 &functions);
+
+      bool recursive_call_site =
+          HasAncestor(nodes, i, [&node](const ProfileNode& ancestor) {
+            return ancestor.call == node.call;
+          });
+      AddToEntry(node, recursive_call_site,
+                 node.location + "  " + node.name, &call_sites);
+    }
+  }
+
+  std::ostringstream out;
+  out << "Template and function times: "
+         "(self ms, inclusive ms, calls, name)\n";
+  SummarizeEntries(functions, out);
+  out << std::endl;
+  out << "Call site times: (self ms, inclusive ms, calls, location, name)\n";
+  SummarizeEntries(call_sites, out);
+  return out.str();
+}
+
+std::string GetCollapsedStacks() {
+  if (!profiling_enabled)
+    return std::string();
+
+  // Sum the self time of identical stacks across threads.
+  std::map<std::string, Ticks> stacks;
+  for (const ProfileThread* thread : profiler->threads()) {
+    const std::vector<ProfileNode>& nodes = thread->nodes();
+    std::vector<std::string> paths(nodes.size());
+    for (uint32_t i = 1; i < nodes.size(); i++) {
+      const ProfileNode& node = nodes[i];
+      if (node.parent != 0)
+        paths[i] = paths[node.parent] + ";";
+      paths[i] += node.name;
+      stacks[paths[i]] += node.total - node.children;
+    }
+  }
+
+  std::string result;
+  for (const auto& [stack, self] : stacks) {
+    uint64_t microseconds = TickDelta(self).InMicroseconds();
+    if (microseconds == 0)
+      continue;
+    result += stack;
+    result += " ";
+    result += std::to_string(microseconds);
+    result += "\n";
+  }
+  return result;
+}
+
+bool SaveProfile(const base::FilePath& file_name) {
+  std::string report = SummarizeProfile();
+  if (base::WriteFile(file_name, report.data(),
+                      static_cast<int>(report.size())) < 0)
+    return false;
+
+  std::string stacks = GetCollapsedStacks();
+  base::FilePath stacks_name =
+      file_name.AddExtension(FILE_PATH_LITERAL("folded"));
+  return base::WriteFile(stacks_name, stacks.data(),
+                         static_cast<int>(stacks.size())) >= 0;
+}
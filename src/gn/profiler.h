@@ -0,0 +1,73 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_PROFILER_H_
+#define TOOLS_GN_PROFILER_H_
+
+#include <string>
+#include <string_view>
+
+class FunctionCallNode;
+class ProfileThread;
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+// Profiler for the execution of GN script.
+//
+// Tracing attributes time to whole files and templates. The profiler instead
+// records every template invocation and builtin function call in a per-thread
+// call tree keyed by call site, so the time can be attributed to the
+// templates, functions and .gni helpers responsible. The call trees of all
+// threads are merged when the profile is reported.
+
+// Records a call to a template or builtin function for the lifetime of the
+// object. Does nothing when profiling is not enabled.
+class ScopedProfile {
+ public:
+  enum Kind {
+    TEMPLATE,
+    FUNCTION,
+  };
+
+  ScopedProfile(Kind kind, const FunctionCallNode* call, std::string_view name);
+  ~ScopedProfile();
+
+ private:
+  ProfileThread* thread_;
+
+  ScopedProfile(const ScopedProfile&) = delete;
+  ScopedProfile& operator=(const ScopedProfile&) = delete;
+};
+
+// Call to turn profiling on. It's off by default.
+void EnableProfiling();
+
+// Returns whether profiling is enabled.
+bool ProfilingEnabled();
+
+// Turns profiling off and clears the recorded calls. Must not be called while
+// other threads may be running script.
+void ResetProfilingForTesting();
+
+// Returns a report of the self time, inclusive time and number of calls of
+// each template and function, and of each call site, sorted by self time.
+// Times are summed over all threads. Returns the empty string if profiling is
+// not enabled.
+//
+// This and the functions below merge the call trees of all threads, so they
+// must not be called while other threads may still be running script.
+std::string SummarizeProfile();
+
+// Returns the profile as collapsed stacks, one line per distinct call stack
+// of the form "outer;inner;innermost <self microseconds>". This is the input
+// format of flame graph tools such as flamegraph.pl.
+std::string GetCollapsedStacks();
+
+// Writes the report to the given file, and the collapsed stacks to the same
+// name with ".folded" appended. Returns true on success.
+bool SaveProfile(const base::FilePath& file_name);
+
+#endif  // TOOLS_GN_PROFILER_H_
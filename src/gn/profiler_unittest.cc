@@ -0,0 +1,71 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/profiler.h"
+
+#include "gn/test_with_scope.h"
+#include "util/test/test.h"
+
+namespace {
+
+class ProfilerTest : public testing::Test {
+ public:
+  void SetUp() override { EnableProfiling(); }
+  void TearDown() override { ResetProfilingForTesting(); }
+};
+
+}  // namespace
+
+TEST_F(ProfilerTest, CountsTemplatesAndFunctions) {
+  TestWithScope setup;
+  {
+    TestParseInput input(
+        "template(\"profiler_test\") {\n"
+        "  print(target_name)\n"
+        "  print(invoker.bar)\n"
+        "}\n"
+        "profiler_test(\"a\") {\n"
+        "  bar = 1\n"
+        "}\n"
+        "profiler_test(\"b\") {\n"
+        "  bar = 2\n"
+        "}\n");
+    ASSERT_FALSE(input.has_error());
+
+    Err err;
+    input.parsed()->Execute(setup.scope(), &err);
+    ASSERT_FALSE(err.has_error()) << err.message();
+    EXPECT_EQ("a\n1\nb\n2\n", setup.print_output());
+  }
+
+  // Both invocations are counted against the template and its call sites.
+  // The parse tree is gone by now, so this also checks that the profile
+  // doesn't refer to it.
+  std::string summary = SummarizeProfile();
+  EXPECT_NE(std::string::npos,
+            summary.find("       2  template profiler_test\n"))
+      << summary;
+  EXPECT_NE(std::string::npos, summary.find(":5:1  profiler_test\n"))
+      << summary;
+  EXPECT_NE(std::string::npos, summary.find(":8:1  profiler_test\n"))
+      << summary;
+}
+
+TEST_F(ProfilerTest, Reset) {
+  TestWithScope setup;
+  TestParseInput input("print(1)\n");
+  ASSERT_FALSE(input.has_error());
+  Err err;
+  input.parsed()->Execute(setup.scope(), &err);
+  ASSERT_FALSE(err.has_error()) << err.message();
+  EXPECT_NE(std::string::npos, SummarizeProfile().find("function print\n"));
+
+  ResetProfilingForTesting();
+  EXPECT_FALSE(ProfilingEnabled());
+  EXPECT_EQ(std::string(), SummarizeProfile());
+
+  // Calls recorded before the reset are gone once profiling is back on.
+  EnableProfiling();
+  EXPECT_EQ(std::string::npos, SummarizeProfile().find("function print\n"));
+}
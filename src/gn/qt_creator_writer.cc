@@ -16,6 +16,7 @@
 #include "gn/builder.h"
 #include "gn/config_values_extractors.h"
 #include "gn/deps_iterator.h"
+#include "gn/dry_run.h"
 #include "gn/filesystem_utils.h"
 #include "gn/label.h"
 #include "gn/loader.h"
@@ -40,7 +41,7 @@ bool QtCreatorWriter::RunAndWriteFile(const BuildSettings* build_settings,
   base::FilePath project_dir =
       build_settings->GetFullPath(build_settings->build_dir())
           .Append(kProjectDirName);
-  if (!base::DirectoryExists(project_dir)) {
+  if (!DryRunEnabled() && !base::DirectoryExists(project_dir)) {
     base::File::Error error;
     if (!base::CreateDirectoryAndGetError(project_dir, &error)) {
       *err =
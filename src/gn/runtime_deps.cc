@@ -4,16 +4,22 @@
 
 #include "gn/runtime_deps.h"
 
-#include <map>
-#include <set>
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
 
+#include "base/atomic_ref_count.h"
 #include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/strings/string_split.h"
 #include "gn/build_settings.h"
 #include "gn/builder.h"
-#include "gn/deps_iterator.h"
+#include "gn/dependency_graph.h"
 #include "gn/filesystem_utils.h"
 #include "gn/loader.h"
 #include "gn/output_file.h"
@@ -23,56 +29,265 @@
 #include "gn/switches.h"
 #include "gn/target.h"
 #include "gn/trace.h"
+#include "util/worker_pool.h"
 
 namespace {
 
 using RuntimeDepsVector = std::vector<std::pair<OutputFile, const Target*>>;
 
-// Adds the given file to the deps list if it hasn't already been listed in
-// the found_files list. Updates the list.
-void AddIfNew(const OutputFile& output_file,
-              const Target* source,
-              RuntimeDepsVector* deps,
-              std::set<OutputFile>* found_file) {
-  if (found_file->find(output_file) != found_file->end())
-    return;  // Already there.
-  deps->push_back(std::make_pair(output_file, source));
-}
-
-// Automatically converts a string that looks like a source to an OutputFile.
-void AddIfNew(const std::string& str,
-              const Target* source,
-              RuntimeDepsVector* deps,
-              std::set<OutputFile>* found_file) {
-  OutputFile output_file(
+// Converts a string that looks like a source to an OutputFile.
+OutputFile AsOutputFile(const std::string& str, const Target* source) {
+  return OutputFile(
       RebasePath(str, source->settings()->build_settings()->build_dir(),
                  source->settings()->build_settings()->root_path_utf8()));
-  AddIfNew(output_file, source, deps, found_file);
 }
 
-// To avoid duplicate traversals of targets, or duplicating output files that
-// might be listed by more than one target, the set of targets and output files
-// that have been found so far is passed. The "value" of the seen_targets map
-// is a boolean indicating if the seen dep was a data dep (true = data_dep).
-// data deps add more stuff, so we will want to revisit a target if it's a
-// data dependency and we've previously only seen it as a regular dep.
-void RecursiveCollectRuntimeDeps(const Target* target,
-                                 bool is_target_data_dep,
-                                 RuntimeDepsVector* deps,
-                                 std::map<const Target*, bool>* seen_targets,
-                                 std::set<OutputFile>* found_files) {
-  const auto& found_seen_target = seen_targets->find(target);
-  if (found_seen_target != seen_targets->end()) {
-    // Already visited.
-    if (found_seen_target->second || !is_target_data_dep) {
-      // Already visited as a data dep, or the current dep is not a data
-      // dep so visiting again will be a no-op.
-      return;
+// Computes the runtime deps of a set of targets.
+//
+// The runtime deps of a target are found by walking its dependencies, and the
+// closures of the targets whose runtime deps are written usually overlap a
+// lot. The walk happens on a DependencyGraph of the targets, and the files
+// each target contributes (its runtime outputs, data files and, when it's a
+// data dep, action outputs) only depend on the target, so they are computed
+// once for all the walks. A walk then only copies the contributions of the
+// targets it reaches.
+//
+// Collect() is thread-safe once ComputeFiles() is done.
+class RuntimeDepsCollector {
+ public:
+  explicit RuntimeDepsCollector(const std::vector<const Target*>& targets);
+
+  // Computes the contributions of the targets reachable from the given ones,
+  // on the pool if given or on this thread otherwise. Returns once they're
+  // all computed, so the pool can then be used for more work.
+  void ComputeFiles(WorkerPool* pool);
+
+  // Returns the runtime deps of one of the targets given to the constructor.
+  RuntimeDepsVector Collect(const Target* target) const;
+
+ private:
+  using Node = DependencyGraph::Node;
+
+  // How a node was reached by a walk.
+  enum Seen : uint8_t {
+    NOT_SEEN,
+    SEEN_AS_DEP,
+    SEEN_AS_DATA_DEP,
+  };
+
+  // How each node was reached by the current walk of a thread. The nodes are
+  // stamped with a number per walk, so the state can be reused by the next
+  // walk without clearing it, and a walk only costs the nodes it reaches.
+  class WalkState {
+   public:
+    explicit WalkState(size_t size) : stamps_(size, 0) {}
+
+    // Starts a new walk where no node is seen.
+    void NextWalk();
+
+    Seen Get(Node node) const;
+    void Set(Node node, Seen seen);
+
+   private:
+    // A node is SEEN_AS_DEP by the current walk if its stamp is |base_|, and
+    // SEEN_AS_DATA_DEP if it's |base_| + 1. Stamps of previous walks are lower.
+    std::vector<uint32_t> stamps_;
+    uint32_t base_ = 0;
+  };
+
+  struct NodeFiles {
+    // The runtime outputs of linked binaries, and the data files.
+    std::vector<OutputFile> files;
+
+    // Added when the target is a data dep: the outputs of actions and copies.
+    std::vector<OutputFile> data_dep_files;
+
+    // The bundle directory of a bundle, added after the data deps.
+    OutputFile bundle_root;
+  };
+
+  // Updates the seen state of the node for a visit, and returns true if it
+  // needs to be visited: if it wasn't seen, or was only seen as a regular dep
+  // and is now a data dep, which adds more stuff.
+  static bool Visit(Seen* seen, bool is_data_dep);
+
+  // Returns true if the walk follows the linked dependency of |from| on |to|.
+  bool FollowsLinkedDep(Node from, Node to) const;
+
+  void ComputeNodeFiles(Node node);
+
+  // Called by the tasks of ComputeFiles() when they're done.
+  void OnTaskDone();
+
+  // Walks the dependencies of the node, in the same order as the recursive
+  // walk of gn did, so the output is unchanged.
+  void CollectNode(Node node,
+                   bool is_data_dep,
+                   WalkState* state,
+                   RuntimeDepsVector* deps) const;
+
+  DependencyGraph graph_;
+  std::vector<Target::OutputType> output_types_;
+
+  // The nodes reachable from the given targets, and how they were reached.
+  std::vector<Node> reachable_;
+  std::vector<Seen> reached_as_;
+
+  std::vector<NodeFiles> files_;
+
+  // Counts the tasks posted by ComputeFiles() that aren't done yet.
+  base::AtomicRefCount task_count_;
+  std::mutex task_count_lock_;
+
+  // Signaled when |task_count_| becomes zero.
+  std::condition_variable task_count_cv_;
+
+  // The states of the walks that aren't running. Each Collect() takes one, so
+  // there are at most as many as there are threads collecting at once.
+  mutable std::mutex walk_states_lock_;
+  mutable std::vector<std::unique_ptr<WalkState>> walk_states_;
+};
+
+RuntimeDepsCollector::RuntimeDepsCollector(
+    const std::vector<const Target*>& targets)
+    : graph_(targets),
+      reached_as_(graph_.size(), NOT_SEEN),
+      files_(graph_.size()) {
+  output_types_.reserve(graph_.size());
+  for (size_t i = 0; i < graph_.size(); i++)
+    output_types_.push_back(graph_.target(i)->output_type());
+
+  // Find the nodes the walks will reach, ahead of time, so their files can be
+  // computed in parallel.
+  std::vector<std::pair<Node, bool>> stack;
+  for (const Target* target : targets)
+    stack.emplace_back(graph_.GetNode(target), false);
+  while (!stack.empty()) {
+    auto [node, is_data_dep] = stack.back();
+    stack.pop_back();
+    Seen before = reached_as_[node];
+    if (!Visit(&reached_as_[node], is_data_dep))
+      continue;
+    if (before == NOT_SEEN)
+      reachable_.push_back(node);
+
+    for (Node dep : graph_.data_deps(node))
+      stack.emplace_back(dep, true);
+    if (output_types_[node] != Target::CREATE_BUNDLE) {
+      for (Node dep : graph_.linked_deps(node)) {
+        if (FollowsLinkedDep(node, dep))
+          stack.emplace_back(dep, false);
+      }
+    }
+  }
+}
+
+void RuntimeDepsCollector::ComputeFiles(WorkerPool* pool) {
+  if (!pool) {
+    for (Node node : reachable_)
+      ComputeNodeFiles(node);
+    return;
+  }
+
+  // The contributions of most targets are tiny, so batch them.
+  constexpr size_t kNodesPerTask = 64;
+  for (size_t begin = 0; begin < reachable_.size(); begin += kNodesPerTask) {
+    size_t end = std::min(begin + kNodesPerTask, reachable_.size());
+    task_count_.Increment();
+    pool->PostTask([this, begin, end]() {
+      for (size_t i = begin; i < end; i++)
+        ComputeNodeFiles(reachable_[i]);
+      OnTaskDone();
+    });
+  }
+
+  // Wait for all tasks posted by this method to complete.
+  std::unique_lock<std::mutex> auto_lock(task_count_lock_);
+  while (!task_count_.IsZero())
+    task_count_cv_.wait(auto_lock);
+}
+
+void RuntimeDepsCollector::OnTaskDone() {
+  if (!task_count_.Decrement()) {
+    // Signal |task_count_cv_| when |task_count_| becomes zero.
+    std::unique_lock<std::mutex> auto_lock(task_count_lock_);
+    task_count_cv_.notify_one();
+  }
+}
+
+RuntimeDepsVector RuntimeDepsCollector::Collect(const Target* target) const {
+  std::unique_ptr<WalkState> state;
+  {
+    std::lock_guard<std::mutex> lock(walk_states_lock_);
+    if (!walk_states_.empty()) {
+      state = std::move(walk_states_.back());
+      walk_states_.pop_back();
     }
-    // In the else case, the previously seen target was a regular dependency
-    // and we'll now process it as a data dependency.
   }
-  (*seen_targets)[target] = is_target_data_dep;
+  if (!state)
+    state = std::make_unique<WalkState>(graph_.size());
+  state->NextWalk();
+
+  // The initial target is not considered a data dependency so that actions's
+  // outputs (if the current target is an action) are not automatically
+  // considered data deps.
+  RuntimeDepsVector result;
+  CollectNode(graph_.GetNode(target), false, state.get(), &result);
+
+  std::lock_guard<std::mutex> lock(walk_states_lock_);
+  walk_states_.push_back(std::move(state));
+  return result;
+}
+
+void RuntimeDepsCollector::WalkState::NextWalk() {
+  if (base_ >= std::numeric_limits<uint32_t>::max() - 3) {
+    // Out of stamps: forget the previous walks.
+    std::fill(stamps_.begin(), stamps_.end(), 0);
+    base_ = 0;
+  }
+  base_ += 2;
+}
+
+RuntimeDepsCollector::Seen RuntimeDepsCollector::WalkState::Get(
+    Node node) const {
+  uint32_t stamp = stamps_[node];
+  if (stamp < base_)
+    return NOT_SEEN;
+  return stamp == base_ ? SEEN_AS_DEP : SEEN_AS_DATA_DEP;
+}
+
+void RuntimeDepsCollector::WalkState::Set(Node node, Seen seen) {
+  DCHECK(seen != NOT_SEEN);
+  stamps_[node] = seen == SEEN_AS_DEP ? base_ : base_ + 1;
+}
+
+// static
+bool RuntimeDepsCollector::Visit(Seen* seen, bool is_data_dep) {
+  if (*seen == SEEN_AS_DATA_DEP || (*seen == SEEN_AS_DEP && !is_data_dep)) {
+    // Already visited as a data dep, or the current dep is not a data dep so
+    // visiting again will be a no-op.
+    return false;
+  }
+  *seen = is_data_dep ? SEEN_AS_DATA_DEP : SEEN_AS_DEP;
+  return true;
+}
+
+bool RuntimeDepsCollector::FollowsLinkedDep(Node from, Node to) const {
+  if (output_types_[to] == Target::EXECUTABLE)
+    return false;  // Skip executables that aren't data deps.
+  if (output_types_[to] == Target::SHARED_LIBRARY &&
+      (output_types_[from] == Target::ACTION ||
+       output_types_[from] == Target::ACTION_FOREACH)) {
+    // Skip shared libraries that action depends on,
+    // unless it were listed in data deps.
+    return false;
+  }
+  return true;
+}
+
+void RuntimeDepsCollector::ComputeNodeFiles(Node node) {
+  const Target* target = graph_.target(node);
+  NodeFiles& node_files = files_[node];
 
   // Add the main output file for executables, shared libraries, and
   // loadable modules.
@@ -80,51 +295,65 @@ void RecursiveCollectRuntimeDeps(const Target* target,
       target->output_type() == Target::LOADABLE_MODULE ||
       target->output_type() == Target::SHARED_LIBRARY) {
     for (const auto& runtime_output : target->runtime_outputs())
-      AddIfNew(runtime_output, target, deps, found_files);
+      node_files.files.push_back(runtime_output);
   }
 
   // Add all data files.
   for (const auto& file : target->data())
-    AddIfNew(file, target, deps, found_files);
+    node_files.files.push_back(AsOutputFile(file, target));
 
   // Actions/copy have all outputs considered when the're a data dep.
-  if (is_target_data_dep && (target->output_type() == Target::ACTION ||
-                             target->output_type() == Target::ACTION_FOREACH ||
-                             target->output_type() == Target::COPY_FILES)) {
+  if (reached_as_[node] == SEEN_AS_DATA_DEP &&
+      (target->output_type() == Target::ACTION ||
+       target->output_type() == Target::ACTION_FOREACH ||
+       target->output_type() == Target::COPY_FILES)) {
     std::vector<SourceFile> outputs;
     target->action_values().GetOutputsAsSourceFiles(target, &outputs);
     for (const auto& output_file : outputs)
-      AddIfNew(output_file.value(), target, deps, found_files);
+      node_files.data_dep_files.push_back(
+          AsOutputFile(output_file.value(), target));
   }
 
-  // Data dependencies.
-  for (const auto& dep_pair : target->data_deps()) {
-    RecursiveCollectRuntimeDeps(dep_pair.ptr, true, deps, seen_targets,
-                                found_files);
+  if (target->output_type() == Target::CREATE_BUNDLE) {
+    SourceDir bundle_root_dir =
+        target->bundle_data().GetBundleRootDirOutputAsDir(target->settings());
+    node_files.bundle_root = AsOutputFile(bundle_root_dir.value(), target);
   }
+}
+
+void RuntimeDepsCollector::CollectNode(Node node,
+                                       bool is_data_dep,
+                                       WalkState* state,
+                                       RuntimeDepsVector* deps) const {
+  Seen seen = state->Get(node);
+  if (!Visit(&seen, is_data_dep))
+    return;
+  state->Set(node, seen);
+
+  const Target* target = graph_.target(node);
+  const NodeFiles& node_files = files_[node];
+  for (const auto& file : node_files.files)
+    deps->emplace_back(file, target);
+  if (is_data_dep) {
+    for (const auto& file : node_files.data_dep_files)
+      deps->emplace_back(file, target);
+  }
+
+  // Data dependencies.
+  for (Node dep : graph_.data_deps(node))
+    CollectNode(dep, true, state, deps);
 
   // Do not recurse into bundle targets. A bundle's dependencies should be
   // copied into the bundle itself for run-time access.
-  if (target->output_type() == Target::CREATE_BUNDLE) {
-    SourceDir bundle_root_dir =
-        target->bundle_data().GetBundleRootDirOutputAsDir(target->settings());
-    AddIfNew(bundle_root_dir.value(), target, deps, found_files);
+  if (output_types_[node] == Target::CREATE_BUNDLE) {
+    deps->emplace_back(node_files.bundle_root, target);
     return;
   }
 
   // Non-data dependencies (both public and private).
-  for (const auto& dep_pair : target->GetDeps(Target::DEPS_LINKED)) {
-    if (dep_pair.ptr->output_type() == Target::EXECUTABLE)
-      continue;  // Skip executables that aren't data deps.
-    if (dep_pair.ptr->output_type() == Target::SHARED_LIBRARY &&
-        (target->output_type() == Target::ACTION ||
-         target->output_type() == Target::ACTION_FOREACH)) {
-      // Skip shared libraries that action depends on,
-      // unless it were listed in data deps.
-      continue;
-    }
-    RecursiveCollectRuntimeDeps(dep_pair.ptr, false, deps, seen_targets,
-                                found_files);
+  for (Node dep : graph_.linked_deps(node)) {
+    if (FollowsLinkedDep(node, dep))
+      CollectNode(dep, false, state, deps);
   }
 }
 
@@ -206,6 +435,7 @@ bool CollectRuntimeDepsFromFlag(const BuildSettings* build_settings,
 
 bool WriteRuntimeDepsFile(const OutputFile& output_file,
                           const Target* target,
+                          const RuntimeDepsCollector& collector,
                           Err* err) {
   SourceFile output_as_source =
       output_file.AsSourceFile(target->settings()->build_settings());
@@ -214,7 +444,7 @@ bool WriteRuntimeDepsFile(const OutputFile& output_file,
 
   StringOutputBuffer storage;
   std::ostream contents(&storage);
-  for (const auto& pair : ComputeRuntimeDeps(target))
+  for (const auto& pair : collector.Collect(target))
     contents << pair.first.value() << std::endl;
 
   ScopedTrace trace(TraceItem::TRACE_FILE_WRITE, output_as_source.value());
@@ -293,16 +523,9 @@ Multiple outputs
 )";
 
 RuntimeDepsVector ComputeRuntimeDeps(const Target* target) {
-  RuntimeDepsVector result;
-  std::map<const Target*, bool> seen_targets;
-  std::set<OutputFile> found_files;
-
-  // The initial target is not considered a data dependency so that actions's
-  // outputs (if the current target is an action) are not automatically
-  // considered data deps.
-  RecursiveCollectRuntimeDeps(target, false, &result, &seen_targets,
-                              &found_files);
-  return result;
+  RuntimeDepsCollector collector({target});
+  collector.ComputeFiles(nullptr);
+  return collector.Collect(target);
 }
 
 bool WriteRuntimeDepsFilesIfNecessary(const BuildSettings* build_settings,
@@ -319,12 +542,44 @@ bool WriteRuntimeDepsFilesIfNecessary(const BuildSettings* build_settings,
         std::make_pair(target->write_runtime_deps_output(), target));
   }
 
-  for (const auto& entry : files_to_write) {
-    // Currently this writes all runtime deps files sequentially. We generally
-    // expect few of these. We can run this on the worker pool if it looks
-    // like it's talking a long time.
-    if (!WriteRuntimeDepsFile(entry.first, entry.second, err))
+  if (files_to_write.empty())
+    return true;
+
+  std::vector<const Target*> targets;
+  targets.reserve(files_to_write.size());
+  for (const auto& entry : files_to_write)
+    targets.push_back(entry.second);
+  RuntimeDepsCollector collector(targets);
+
+  // A file listed more than once used to be written with the contents of its
+  // last entry. Only write that one, so no two tasks write the same file.
+  std::unordered_map<std::string_view, size_t> last_entries;
+  for (size_t i = 0; i < files_to_write.size(); i++)
+    last_entries[files_to_write[i].first.value()] = i;
+
+  // There can be many thousands of files, so compute and write them in
+  // parallel. Each task only touches its own error slot.
+  std::vector<Err> errors(files_to_write.size());
+  {
+    WorkerPool pool;
+    collector.ComputeFiles(&pool);
+    for (size_t i = 0; i < files_to_write.size(); i++) {
+      if (last_entries[files_to_write[i].first.value()] != i)
+        continue;
+      pool.PostTask([&files_to_write, &collector, &errors, i]() {
+        WriteRuntimeDepsFile(files_to_write[i].first, files_to_write[i].second,
+                             collector, &errors[i]);
+      });
+    }
+    // The pool destructor waits for all posted tasks to complete.
+  }
+
+  // Report the first error in order so the failure is deterministic.
+  for (const Err& file_err : errors) {
+    if (file_err.has_error()) {
+      *err = file_err;
       return false;
+    }
   }
   return true;
 }
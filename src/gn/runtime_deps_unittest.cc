@@ -4,7 +4,10 @@
 
 #include <stddef.h>
 
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/stl_util.h"
+#include "gn/builder.h"
 #include "gn/runtime_deps.h"
 #include "gn/scheduler.h"
 #include "gn/target.h"
@@ -419,6 +422,49 @@ TEST_F(RuntimeDeps, Dupe) {
       << GetVectorDescription(result);
 }
 
+// An action reached as a regular dep before it is reached as a data dep
+// should still have its outputs listed.
+TEST_F(RuntimeDeps, DepThenDataDep) {
+  TestWithScope setup;
+  Err err;
+
+  // Dependency hierarchy: main(exe) -> [data] group -> action
+  //                                 -> [data] action
+  Target action(setup.settings(), Label(SourceDir("//"), "action"));
+  InitTargetWithType(setup, &action, Target::ACTION);
+  action.data().push_back("//action.data");
+  action.action_values().outputs() =
+      SubstitutionList::MakeForTest("//action.output");
+  ASSERT_TRUE(action.OnResolved(&err));
+
+  Target group(setup.settings(), Label(SourceDir("//"), "group"));
+  InitTargetWithType(setup, &group, Target::GROUP);
+  group.private_deps().push_back(LabelTargetPair(&action));
+  ASSERT_TRUE(group.OnResolved(&err));
+
+  Target main(setup.settings(), Label(SourceDir("//"), "main"));
+  InitTargetWithType(setup, &main, Target::EXECUTABLE);
+  main.data_deps().push_back(LabelTargetPair(&group));
+  main.data_deps().push_back(LabelTargetPair(&action));
+  ASSERT_TRUE(main.OnResolved(&err));
+
+  std::vector<std::pair<OutputFile, const Target*>> result =
+      ComputeRuntimeDeps(&main);
+  EXPECT_TRUE(MakePair("./main", &main) == result[0]);
+  EXPECT_TRUE(
+      base::ContainsValue(result, MakePair("../../action.data", &action)))
+      << GetVectorDescription(result);
+  EXPECT_TRUE(
+      base::ContainsValue(result, MakePair("../../action.output", &action)))
+      << GetVectorDescription(result);
+
+  // The group only has the action as a regular dep.
+  result = ComputeRuntimeDeps(&group);
+  EXPECT_FALSE(
+      base::ContainsValue(result, MakePair("../../action.output", &action)))
+      << GetVectorDescription(result);
+}
+
 // Tests that actions can't have output substitutions.
 TEST_F(RuntimeDeps, WriteRuntimeDepsVariable) {
   TestWithScope setup;
@@ -446,3 +492,60 @@ TEST_F(RuntimeDeps, WriteRuntimeDepsVariable) {
   EXPECT_EQ(1U, setup.items().size());
   EXPECT_EQ(1U, scheduler().GetWriteRuntimeDepsTargets().size());
 }
+
+// Tests writing the runtime deps files: a file listed twice gets the runtime
+// deps of its last entry, and the first error in order is reported.
+TEST_F(RuntimeDeps, WriteFiles) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  TestWithScope setup;
+  setup.build_settings()->SetRootPath(temp_dir.GetPath());
+  base::FilePath build_dir =
+      temp_dir.GetPath().AppendASCII("out").AppendASCII("Debug");
+  ASSERT_TRUE(base::CreateDirectory(build_dir));
+  Err err;
+
+  Target first(setup.settings(), Label(SourceDir("//"), "first"));
+  InitTargetWithType(setup, &first, Target::GROUP);
+  first.data().push_back("//first.dat");
+  first.set_write_runtime_deps_output(OutputFile("dupe.runtime_deps"));
+  ASSERT_TRUE(first.OnResolved(&err));
+
+  Target last(setup.settings(), Label(SourceDir("//"), "last"));
+  InitTargetWithType(setup, &last, Target::GROUP);
+  last.data().push_back("//last.dat");
+  last.set_write_runtime_deps_output(OutputFile("dupe.runtime_deps"));
+  ASSERT_TRUE(last.OnResolved(&err));
+
+  scheduler().AddWriteRuntimeDepsTarget(&first);
+  scheduler().AddWriteRuntimeDepsTarget(&last);
+  Builder builder(nullptr);
+  ASSERT_TRUE(WriteRuntimeDepsFilesIfNecessary(setup.build_settings(),
+                                               builder, &err))
+      << err.message();
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(build_dir.AppendASCII("dupe.runtime_deps"),
+                                     &contents));
+  EXPECT_EQ("../../last.dat\n", contents);
+
+  // Files can't be written in directories that are files. Both fail, and the
+  // error of the first one is reported.
+  for (const char* blocker : {"a_file", "b_file"})
+    ASSERT_EQ(0, base::WriteFile(build_dir.AppendASCII(blocker), "", 0));
+  Target b(setup.settings(), Label(SourceDir("//"), "b"));
+  InitTargetWithType(setup, &b, Target::GROUP);
+  b.set_write_runtime_deps_output(OutputFile("b_file/b.runtime_deps"));
+  ASSERT_TRUE(b.OnResolved(&err));
+  Target a(setup.settings(), Label(SourceDir("//"), "a"));
+  InitTargetWithType(setup, &a, Target::GROUP);
+  a.set_write_runtime_deps_output(OutputFile("a_file/a.runtime_deps"));
+  ASSERT_TRUE(a.OnResolved(&err));
+
+  scheduler().AddWriteRuntimeDepsTarget(&b);
+  scheduler().AddWriteRuntimeDepsTarget(&a);
+  EXPECT_FALSE(WriteRuntimeDepsFilesIfNecessary(setup.build_settings(),
+                                                builder, &err));
+  EXPECT_TRUE(err.has_error());
+  EXPECT_NE(std::string::npos, err.help_text().find("b_file"))
+      << err.help_text();
+}
@@ -12,8 +12,10 @@
 
 #include "base/atomic_ref_count.h"
 #include "base/files/file_path.h"
+#include "gn/exec_script_cache.h"
 #include "gn/input_file_manager.h"
 #include "gn/label.h"
+#include "gn/load_timings.h"
 #include "gn/source_file.h"
 #include "gn/token.h"
 #include "util/msg_loop.h"
@@ -36,6 +38,10 @@ class Scheduler {
 
   InputFileManager* input_file_manager() { return input_file_manager_.get(); }
 
+  ExecScriptCache* exec_script_cache() { return &exec_script_cache_; }
+
+  LoadTimings* load_timings() { return &load_timings_; }
+
   bool verbose_logging() const { return verbose_logging_; }
   void set_verbose_logging(bool v) { verbose_logging_ = v; }
 
@@ -45,7 +51,9 @@ class Scheduler {
   void Log(const std::string& verb, const std::string& msg);
   void FailWithError(const Err& err);
 
-  void ScheduleWork(std::function<void()> work);
+  // Runs |work| on the worker pool. Pending work with a higher |priority| is
+  // run first.
+  void ScheduleWork(std::function<void()> work, int64_t priority = 0);
 
   void Shutdown();
 
@@ -114,6 +122,10 @@ class Scheduler {
 
   scoped_refptr<InputFileManager> input_file_manager_;
 
+  ExecScriptCache exec_script_cache_;
+
+  LoadTimings load_timings_;
+
   bool verbose_logging_ = false;
 
   base::AtomicRefCount work_count_;
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "base/logging.h"
+#include "gn/memory_stats.h"
 #include "gn/parse_tree.h"
 #include "gn/source_file.h"
 #include "gn/template.h"
@@ -51,23 +52,37 @@ Scope::Scope(const Settings* settings)
       mutable_containing_(nullptr),
       settings_(settings),
       mode_flags_(0),
-      item_collector_(nullptr) {}
+      item_collector_(nullptr) {
+  CountMemory(MemoryCounter::SCOPES, 1, sizeof(Scope));
+}
 
 Scope::Scope(Scope* parent)
     : const_containing_(nullptr),
       mutable_containing_(parent),
       settings_(parent->settings()),
       mode_flags_(0),
-      item_collector_(nullptr) {}
+      item_collector_(nullptr) {
+  CountMemory(MemoryCounter::SCOPES, 1, sizeof(Scope));
+}
 
 Scope::Scope(const Scope* parent)
     : const_containing_(parent),
       mutable_containing_(nullptr),
       settings_(parent->settings()),
       mode_flags_(0),
-      item_collector_(nullptr) {}
+      item_collector_(nullptr) {
+  CountMemory(MemoryCounter::SCOPES, 1, sizeof(Scope));
+}
 
-Scope::~Scope() = default;
+Scope::~Scope() {
+  CountMemory(MemoryCounter::SCOPES, -1, -static_cast<int64_t>(sizeof(Scope)));
+  CountValues(-static_cast<int64_t>(values_.size()));
+}
+
+void Scope::CountValues(int64_t delta) {
+  CountMemory(MemoryCounter::SCOPE_VALUES, delta,
+              delta * static_cast<int64_t>(sizeof(RecordMap::value_type)));
+}
 
 void Scope::DetachFromContaining() {
   const_containing_ = nullptr;
@@ -165,7 +180,9 @@ const Value* Scope::GetValueWithScope(std::string_view ident,
 Value* Scope::SetValue(std::string_view ident,
                        Value v,
                        const ParseNode* set_node) {
+  size_t old_size = values_.size();
   Record& r = values_[ident];  // Clears any existing value.
+  CountValues(values_.size() - old_size);
   r.value = std::move(v);
   r.value.set_origin(set_node);
   return &r.value;
@@ -173,8 +190,10 @@ Value* Scope::SetValue(std::string_view ident,
 
 void Scope::RemoveIdentifier(std::string_view ident) {
   RecordMap::iterator found = values_.find(ident);
-  if (found != values_.end())
+  if (found != values_.end()) {
     values_.erase(found);
+    CountValues(-1);
+  }
 }
 
 void Scope::RemovePrivateIdentifiers() {
@@ -190,6 +209,7 @@ void Scope::RemovePrivateIdentifiers() {
 
   for (const auto& cur : to_remove)
     values_.erase(cur);
+  CountValues(-static_cast<int64_t>(to_remove.size()));
 }
 
 bool Scope::AddTemplate(const std::string& name, const Template* templ) {
@@ -364,7 +384,9 @@ bool Scope::NonRecursiveMergeTo(Scope* dest,
         return false;
       }
     }
+    size_t old_size = dest->values_.size();
     dest->values_[current_name] = pair.second;
+    dest->CountValues(dest->values_.size() - old_size);
 
     if (options.mark_dest_used)
       dest->MarkUsed(current_name);
@@ -5,6 +5,8 @@
 #ifndef TOOLS_GN_SCOPE_H_
 #define TOOLS_GN_SCOPE_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <set>
@@ -365,6 +367,10 @@ class Scope {
   // of the values may be different).
   static bool RecordMapValuesEqual(const RecordMap& a, const RecordMap& b);
 
+  // Counts values added to (positive) or removed from (negative) values_ for
+  // memory stats.
+  void CountValues(int64_t delta);
+
   // Walk up the containing scopes and any "invoker" Value scopes to gather any
   // previous template invocations.
   void AppendTemplateInvocationEntries(
@@ -4,6 +4,7 @@
 
 #include "gn/setup.h"
 
+#include <inttypes.h>
 #include <stdlib.h>
 
 #include <algorithm>
@@ -17,15 +18,18 @@
 #include "base/memory/ref_counted.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "gn/command_format.h"
 #include "gn/commands.h"
+#include "gn/dry_run.h"
 #include "gn/exec_process.h"
 #include "gn/filesystem_utils.h"
 #include "gn/input_file.h"
 #include "gn/label_pattern.h"
 #include "gn/parse_tree.h"
 #include "gn/parser.h"
+#include "gn/profiler.h"
 #include "gn/source_dir.h"
 #include "gn/source_file.h"
 #include "gn/standard_out.h"
@@ -35,6 +39,7 @@
 #include "gn/value.h"
 #include "gn/value_extractors.h"
 #include "util/build_config.h"
+#include "util/msg_loop.h"
 
 #if defined(OS_WIN)
 #include <windows.h>
@@ -208,6 +213,20 @@ Variables
       rules instead of stamp files whenever possible. This results in smaller
       Ninja build plans, but requires at least Ninja 1.11.
 
+  ninja_shared_flags [optional]
+      A boolean flag that can be set to write the compiler flags (defines,
+      include_dirs, cflags...) shared by many targets only once, as variables
+      of the toolchain's Ninja file that the target Ninja files refer to. This
+      makes the Ninja files smaller and faster to load.
+
+  ninja_target_shards [optional]
+      When set to a positive integer, the rules of the binary targets of each
+      toolchain are written to at most that many Ninja files, with the targets
+      of a directory in the same file, instead of one Ninja file per target.
+      This makes for much fewer files to write and for Ninja to load. The
+      variables a target sets for its compiler flags are repeated for each of
+      its build steps, so this works best with ninja_shared_flags.
+
 Example .gn file contents
 
   buildconfig = "//build/config/BUILDCONFIG.gn"
@@ -385,6 +404,34 @@ base::FilePath FindWindowsPython(const base::FilePath& python_exe_name,
 }
 #endif
 
+// Returns the unescaped input files of the ninja depfile |contents|, which
+// lists a single output.
+std::vector<std::string> GetDepfileInputs(std::string_view contents) {
+  std::vector<std::string> inputs;
+  size_t colon = contents.find(": ");
+  if (colon == std::string_view::npos)
+    return inputs;
+
+  std::string current;
+  for (size_t i = colon + 2; i < contents.size(); i++) {
+    char c = contents[i];
+    if (c == '\\' && i + 1 < contents.size() && contents[i + 1] != '\n') {
+      current.push_back(contents[++i]);
+    } else if (c == '$' && i + 1 < contents.size() && contents[i + 1] == '$') {
+      current.push_back(contents[++i]);
+    } else if (c == ' ' || c == '\n' || c == '\r' || c == '\\') {
+      if (!current.empty())
+        inputs.push_back(std::move(current));
+      current.clear();
+    } else {
+      current.push_back(c);
+    }
+  }
+  if (!current.empty())
+    inputs.push_back(std::move(current));
+  return inputs;
+}
+
 }  // namespace
 
 const char Setup::kBuildArgFileName[] = "args.gn";
@@ -396,6 +443,7 @@ Setup::Setup()
       dotfile_settings_(&build_settings_, std::string()),
       dotfile_scope_(&dotfile_settings_) {
   dotfile_settings_.set_toolchain_label(Label());
+  builder_.set_resolve_in_parallel(true);
 
   build_settings_.set_item_defined_callback(
       [task_runner = scheduler_.task_runner(),
@@ -434,6 +482,8 @@ bool Setup::DoSetupWithErr(const std::string& build_dir,
   if (cmdline.HasSwitch(switches::kTime) ||
       cmdline.HasSwitch(switches::kTracelog))
     EnableTracing();
+  if (cmdline.HasSwitch(switches::kProfile))
+    EnableProfiling();
 
   ScopedTrace setup_trace(TraceItem::TRACE_SETUP, "DoSetup");
 
@@ -448,6 +498,10 @@ bool Setup::DoSetupWithErr(const std::string& build_dir,
   if (!FillBuildDir(build_dir, !force_create, err))
     return false;
 
+  // Must be before any loads are scheduled so they get their priorities.
+  scheduler_.load_timings()->Read(build_settings_.GetFullPath(SourceFile(
+      build_settings_.build_dir().value() + LoadTimings::kFileName)));
+
   // Apply project-specific default (if specified).
   // Must happen before FillArguments().
   if (default_args_) {
@@ -491,7 +545,37 @@ void Setup::RunPreMessageLoop() {
   g_scheduler->IncrementWorkCount();
 
   // Load the root build file.
-  loader_->Load(root_build_file_, LocationRange(), Label());
+  loader_->Load(root_build_file_, LocationRange(), Label(), SourceFile());
+
+  // Keep the worker pool busy while the first files run and discover the rest.
+  PrefetchPreviousBuildFiles();
+}
+
+void Setup::PrefetchPreviousBuildFiles() {
+  std::string contents;
+  if (!base::ReadFileToString(
+          build_settings_.GetFullPath(SourceFile(
+              build_settings_.build_dir().value() + "build.ninja.d")),
+          &contents))
+    return;
+
+  const std::string& build_dir = build_settings_.build_dir().value();
+  for (const std::string& input : GetDepfileInputs(contents)) {
+    // The depfile lists paths relative to the build directory.
+    std::string name = ResolveRelative(input, build_dir, true,
+                                       build_settings_.root_path_utf8());
+
+    // Only build files in the source tree go through the InputFileManager.
+    // The dotfile and args.gn are read directly.
+    if (!name.starts_with("//") || name.starts_with(build_dir) ||
+        name == GetDotFile().value())
+      continue;
+    if (!name.ends_with(".gn") && !name.ends_with(".gni"))
+      continue;
+
+    g_scheduler->input_file_manager()->PrefetchFile(&build_settings_,
+                                                    SourceFile(name));
+  }
 }
 
 bool Setup::RunPostMessageLoop(const base::CommandLine& cmdline) {
@@ -533,10 +617,34 @@ bool Setup::RunPostMessageLoop(const base::CommandLine& cmdline) {
   }
 
   // Write out tracing and timing if requested.
-  if (cmdline.HasSwitch(switches::kTime))
+  if (cmdline.HasSwitch(switches::kTime)) {
     PrintLongHelp(SummarizeTraces());
+
+    // Everything resolving the build graph runs on the main thread, so this
+    // shows how close it is to being the bottleneck.
+    MsgLoop::Stats loop_stats = MsgLoop::Current()->GetStats();
+    uint64_t run_ms = loop_stats.run_time.InMilliseconds();
+    uint64_t busy_ms =
+        TickDelta(loop_stats.run_time.raw() - loop_stats.idle_time.raw())
+            .InMilliseconds();
+    OutputString(base::StringPrintf(
+        "Main thread busy for %" PRIu64 "ms of %" PRIu64 "ms (%d%%), running "
+        "%" PRIu64 " tasks in %" PRIu64 " batches.\n",
+        busy_ms, run_ms, run_ms ? static_cast<int>(busy_ms * 100 / run_ms) : 0,
+        loop_stats.tasks, loop_stats.batches));
+  }
   if (cmdline.HasSwitch(switches::kTracelog))
     SaveTraces(cmdline.GetSwitchValuePath(switches::kTracelog));
+  if (cmdline.HasSwitch(switches::kProfile)) {
+    base::FilePath profile_file =
+        cmdline.GetSwitchValuePath(switches::kProfile);
+    if (!SaveProfile(profile_file)) {
+      Err(Location(), "Unable to write profile.",
+          "Couldn't write \"" + FilePathToUTF8(profile_file) + "\".")
+          .PrintToStdout();
+      return false;
+    }
+  }
 
   return true;
 }
@@ -556,7 +664,8 @@ bool Setup::FillArguments(const base::CommandLine& cmdline, Err* err) {
             switch_value.empty() ? kDefaultArgsGn : switch_value, err)) {
       return false;
     }
-    SaveArgsToFile();
+    if (!DryRunEnabled())
+      SaveArgsToFile();
     return true;
   }
 
@@ -739,6 +848,12 @@ bool Setup::FillBuildDir(const std::string& build_dir,
   }
 
   base::FilePath build_dir_path = build_settings_.GetFullPath(resolved);
+  if (DryRunEnabled() && !require_exists &&
+      !base::DirectoryExists(build_dir_path)) {
+    // A dry run doesn't create the build dir, so use it as given.
+    build_settings_.SetBuildDir(resolved);
+    return true;
+  }
   if (!base::CreateDirectory(build_dir_path)) {
     *err = Err(Location(), "Can't create the build dir.",
                "I could not create the build dir \"" +
@@ -1141,6 +1256,33 @@ bool Setup::FillOtherConfig(const base::CommandLine& cmdline, Err* err) {
     build_settings_.set_no_stamp_files(no_stamp_files_value->boolean_value());
   }
 
+  // Shared compiler flags.
+  const Value* ninja_shared_flags_value =
+      dotfile_scope_.GetValue("ninja_shared_flags", true);
+  if (ninja_shared_flags_value) {
+    if (!ninja_shared_flags_value->VerifyTypeIs(Value::BOOLEAN, err)) {
+      return false;
+    }
+    build_settings_.set_ninja_shared_flags(
+        ninja_shared_flags_value->boolean_value());
+  }
+
+  // Target shards.
+  const Value* ninja_target_shards_value =
+      dotfile_scope_.GetValue("ninja_target_shards", true);
+  if (ninja_target_shards_value) {
+    if (!ninja_target_shards_value->VerifyTypeIs(Value::INTEGER, err)) {
+      return false;
+    }
+    if (ninja_target_shards_value->int_value() < 0) {
+      *err = Err(*ninja_target_shards_value,
+                 "ninja_target_shards can't be negative.");
+      return false;
+    }
+    build_settings_.set_ninja_target_shards(
+        static_cast<size_t>(ninja_target_shards_value->int_value()));
+  }
+
   // Export compile commands.
   const Value* export_cc_value =
       dotfile_scope_.GetValue("export_compile_commands", true);
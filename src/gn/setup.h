@@ -135,6 +135,10 @@ class Setup {
   void RunPreMessageLoop();
   bool RunPostMessageLoop(const base::CommandLine& cmdline);
 
+  // Starts loading the build files the previous gen in the build directory
+  // read, as listed in its build.ninja.d, ahead of them being requested.
+  void PrefetchPreviousBuildFiles();
+
   // Fills build arguments. Returns true on success.
   bool FillArguments(const base::CommandLine& cmdline, Err* err);
 
@@ -4,12 +4,16 @@
 
 #include "gn/setup.h"
 
+#include <map>
+
+
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "gn/builder_record.h"
 #include "gn/filesystem_utils.h"
+#include "gn/load_timings.h"
 #include "gn/switches.h"
 #include "gn/test_with_scheduler.h"
 #include "util/build_config.h"
@@ -228,7 +232,7 @@ root_patterns = [ "//:*" ]
                                    true, cmdline, &err));
 
   const std::vector<LabelPattern>& root_patterns =
-      setup.build_settings().root_patterns();
+      setup.build_settings().root_patterns().patterns();
   ASSERT_EQ(1u, root_patterns.size());
   EXPECT_EQ("//.:*", root_patterns[0].Describe());
 }
@@ -267,7 +271,7 @@ root_patterns = [ "//:foo" ]
                                    true, cmdline, &err));
 
   const std::vector<LabelPattern>& root_patterns =
-      setup.build_settings().root_patterns();
+      setup.build_settings().root_patterns().patterns();
   ASSERT_EQ(2u, root_patterns.size());
   EXPECT_EQ("//.:bar", root_patterns[0].Describe());
   EXPECT_EQ("//.:qux", root_patterns[1].Describe());
@@ -330,7 +334,7 @@ toolchain("toolchain") {
                                    true, cmdline, &err));
 
   const std::vector<LabelPattern>& root_patterns =
-      setup.build_settings().root_patterns();
+      setup.build_settings().root_patterns().patterns();
   ASSERT_EQ(1u, root_patterns.size());
   EXPECT_EQ("//.:foo", root_patterns[0].Describe());
 
@@ -360,3 +364,174 @@ toolchain("toolchain") {
   EXPECT_FALSE(qux_record->should_generate());
   EXPECT_FALSE(zoo_record->should_generate());
 }
+
+TEST_F(SetupTest, PrefetchPreviousBuildFiles) {
+  base::CommandLine cmdline(base::CommandLine::NO_PROGRAM);
+
+  const char kBuildConfigContents[] = R"(
+set_default_toolchain("//:toolchain")
+)";
+
+  const char kBuildGnContents[] = R"(
+import("//used.gni")
+
+toolchain("toolchain") {
+  tool("stamp") {
+    command = "stamp"
+  }
+}
+)";
+
+  base::ScopedTempDir in_temp_dir;
+  ASSERT_TRUE(in_temp_dir.CreateUniqueTempDir());
+  base::FilePath in_path = in_temp_dir.GetPath();
+  WriteFile(in_path.Append(FILE_PATH_LITERAL(".gn")),
+            "buildconfig = \"//BUILDCONFIG.gn\"\n");
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("BUILDCONFIG.gn")),
+            kBuildConfigContents);
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("BUILD.gn")), kBuildGnContents);
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("used.gni")), "");
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("unused.gni")), "");
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("broken.gni")), "}");
+  cmdline.AppendSwitch(switches::kRoot, FilePathToUTF8(in_path));
+
+  // The previous run read files that are now unused, broken or missing, none
+  // of which should matter to this run.
+  base::FilePath build_path = in_path.Append(FILE_PATH_LITERAL("out"));
+  ASSERT_TRUE(base::CreateDirectory(build_path));
+  WriteFile(build_path.Append(FILE_PATH_LITERAL("build.ninja.d")),
+            "build.ninja.stamp: ../.gn ../BUILD.gn ../BUILDCONFIG.gn "
+            "../broken.gni ../missing.gni ../unused.gni ../used.gni "
+            "./args.gn\n");
+
+  Setup setup;
+  Err err;
+  EXPECT_TRUE(setup.DoSetupWithErr("//out/", true, cmdline, &err));
+  ASSERT_TRUE(setup.Run(cmdline));
+
+  // Only the files actually used are inputs.
+  EXPECT_EQ(3, g_scheduler->input_file_manager()->GetInputFileCount());
+}
+
+// With a single worker thread, a file that imports a queued prefetch can't
+// wait for the prefetch to run since it's queued behind the importing file.
+TEST_F(SetupTest, PrefetchWithOneThread) {
+  base::CommandLine cmdline(base::CommandLine::NO_PROGRAM);
+
+  const char kBuildConfigContents[] = R"(
+import("//config.gni")
+set_default_toolchain("//:toolchain")
+)";
+
+  const char kBuildGnContents[] = R"(
+import("//build.gni")
+
+group("all") {
+  deps = [ "//sub" ]
+}
+
+toolchain("toolchain") {
+  tool("stamp") {
+    command = "stamp"
+  }
+}
+)";
+
+  base::ScopedTempDir in_temp_dir;
+  ASSERT_TRUE(in_temp_dir.CreateUniqueTempDir());
+  base::FilePath in_path = in_temp_dir.GetPath();
+  WriteFile(in_path.Append(FILE_PATH_LITERAL(".gn")),
+            "buildconfig = \"//BUILDCONFIG.gn\"\n");
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("BUILDCONFIG.gn")),
+            kBuildConfigContents);
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("BUILD.gn")), kBuildGnContents);
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("config.gni")), "");
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("build.gni")), "");
+  base::FilePath sub_path = in_path.Append(FILE_PATH_LITERAL("sub"));
+  ASSERT_TRUE(base::CreateDirectory(sub_path));
+  WriteFile(sub_path.Append(FILE_PATH_LITERAL("BUILD.gn")),
+            "group(\"sub\") {}");
+  cmdline.AppendSwitch(switches::kRoot, FilePathToUTF8(in_path));
+
+  // All the files were used by the previous run, so they're all prefetched.
+  base::FilePath build_path = in_path.Append(FILE_PATH_LITERAL("out"));
+  ASSERT_TRUE(base::CreateDirectory(build_path));
+  WriteFile(build_path.Append(FILE_PATH_LITERAL("build.ninja.d")),
+            "build.ninja.stamp: ../.gn ../BUILD.gn ../BUILDCONFIG.gn "
+            "../build.gni ../config.gni ../sub/BUILD.gn\n");
+
+  // The worker pool of the setup's scheduler reads --threads when it's made.
+  base::CommandLine saved_cmdline = *base::CommandLine::ForCurrentProcess();
+  base::CommandLine::ForCurrentProcess()->AppendSwitch(switches::kThreads, "1");
+  Setup setup;
+  *base::CommandLine::ForCurrentProcess() = saved_cmdline;
+
+  Err err;
+  EXPECT_TRUE(setup.DoSetupWithErr("//out/", true, cmdline, &err));
+  ASSERT_TRUE(setup.Run(cmdline));
+  EXPECT_EQ(5, g_scheduler->input_file_manager()->GetInputFileCount());
+  EXPECT_TRUE(setup.builder().GetRecord(
+      Label(SourceDir("//sub/"), "sub", SourceDir("//"), "toolchain")));
+}
+
+TEST_F(SetupTest, LoadTimingsOfTemplateDep) {
+  base::CommandLine cmdline(base::CommandLine::NO_PROGRAM);
+
+  const char kBuildGnContents[] = R"(
+import("//templates.gni")
+
+sub_group("all") {
+  testonly = false
+}
+
+toolchain("toolchain") {
+  tool("stamp") {
+    command = "stamp"
+  }
+}
+)";
+
+  // The dependency on //sub is written in the imported file, but it's the
+  // root build file which causes its load.
+  const char kTemplatesContents[] = R"(
+template("sub_group") {
+  group(target_name) {
+    forward_variables_from(invoker, [ "testonly" ])
+    deps = [ "//sub" ]
+  }
+}
+)";
+
+  base::ScopedTempDir in_temp_dir;
+  ASSERT_TRUE(in_temp_dir.CreateUniqueTempDir());
+  base::FilePath in_path = in_temp_dir.GetPath();
+  WriteFile(in_path.Append(FILE_PATH_LITERAL(".gn")),
+            "buildconfig = \"//BUILDCONFIG.gn\"\n");
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("BUILDCONFIG.gn")),
+            "set_default_toolchain(\"//:toolchain\")\n");
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("BUILD.gn")), kBuildGnContents);
+  WriteFile(in_path.Append(FILE_PATH_LITERAL("templates.gni")),
+            kTemplatesContents);
+  base::FilePath sub_path = in_path.Append(FILE_PATH_LITERAL("sub"));
+  ASSERT_TRUE(base::CreateDirectory(sub_path));
+  WriteFile(sub_path.Append(FILE_PATH_LITERAL("BUILD.gn")),
+            "group(\"sub\") {}");
+  cmdline.AppendSwitch(switches::kRoot, FilePathToUTF8(in_path));
+
+  Setup setup;
+  Err err;
+  EXPECT_TRUE(setup.DoSetupWithErr("//out/", true, cmdline, &err));
+  ASSERT_TRUE(setup.Run(cmdline));
+
+  // The chain of the root build file includes //sub, and the imported file
+  // isn't recorded as a load.
+  std::map<SourceFile, int64_t> priorities;
+  for (const auto& [file, priority] :
+       g_scheduler->load_timings()->GetPriorities())
+    priorities[file] = priority;
+  ASSERT_EQ(1u, priorities.count(SourceFile("//BUILD.gn")));
+  ASSERT_EQ(1u, priorities.count(SourceFile("//sub/BUILD.gn")));
+  EXPECT_EQ(0u, priorities.count(SourceFile("//templates.gni")));
+  EXPECT_GE(priorities[SourceFile("//BUILD.gn")],
+            priorities[SourceFile("//sub/BUILD.gn")]);
+}
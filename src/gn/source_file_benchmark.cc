@@ -0,0 +1,76 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gn/source_file.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+const size_t kCount = 10000;
+
+// Files of a few directories with long common prefixes, so ordered
+// comparisons have to look at most of the string.
+std::vector<SourceFile> MakeFiles() {
+  std::vector<SourceFile> files;
+  for (size_t i = 0; i < kCount; i++) {
+    files.emplace_back("//third_party/some_library/src/module" +
+                       std::to_string(i / 100) + "/file" +
+                       std::to_string(i % 100) + ".cc");
+  }
+  return files;
+}
+
+}  // namespace
+
+// Equality compares the interned string pointers.
+BENCHMARK(SourceFile_Equal) {
+  std::vector<SourceFile> files = MakeFiles();
+  std::vector<SourceFile> others = files;
+  std::rotate(others.begin(), others.begin() + 1, others.end());
+  while (state.KeepRunning()) {
+    size_t equal = 0;
+    for (size_t i = 0; i < kCount; i++)
+      equal += files[i] == others[i];
+    benchmark::DoNotOptimize(equal);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+// Ordering compares the strings.
+BENCHMARK(SourceFile_Less) {
+  std::vector<SourceFile> files = MakeFiles();
+  std::vector<SourceFile> others = files;
+  std::rotate(others.begin(), others.begin() + 1, others.end());
+  while (state.KeepRunning()) {
+    size_t less = 0;
+    for (size_t i = 0; i < kCount; i++)
+      less += files[i] < others[i];
+    benchmark::DoNotOptimize(less);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+BENCHMARK(SourceFile_SetInsert) {
+  std::vector<SourceFile> files = MakeFiles();
+  while (state.KeepRunning()) {
+    std::set<SourceFile> set(files.begin(), files.end());
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+BENCHMARK(SourceFile_SetInsertPtrCompare) {
+  std::vector<SourceFile> files = MakeFiles();
+  while (state.KeepRunning()) {
+    std::set<SourceFile, SourceFile::PtrCompare> set(files.begin(),
+                                                     files.end());
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
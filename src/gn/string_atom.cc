@@ -120,6 +120,24 @@ class StringAtomSet {
     set_.Insert(node, hash, &kEmptyString);
   }
 
+  void GetStats(size_t* count, size_t* bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *count = set_.size();
+    *bytes = slabs_.size() * sizeof(Slab) +
+             set_.bucket_count() * sizeof(KeySet::Node);
+    // An empty string has the capacity of the inline buffer.
+    const size_t inline_capacity = std::string().capacity();
+    for (size_t i = 0; i < slabs_.size(); i++) {
+      size_t used = i + 1 < slabs_.size() ? kStringsPerSlab : slab_index_;
+      for (size_t j = 0; j < used; j++) {
+        // Strings too long for the inline buffer own a heap allocation.
+        const std::string& str = slabs_[i]->at(j);
+        if (str.capacity() > inline_capacity)
+          *bytes += str.capacity() + 1;
+      }
+    }
+  }
+
   // Find the unique constant string pointer for |key|.
   const std::string* find(std::string_view key) {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -168,6 +186,9 @@ class StringAtomSet {
       return result;
     }
 
+    // Return the n-th string, which must have been initialized.
+    const std::string& at(size_t index) const { return items_[index].str; }
+
    private:
     StringStorage items_[kStringsPerSlab];
   };
@@ -217,6 +238,11 @@ __tlssim<ThreadLocalCache*> __g_s_local_cache_impl(&s_tlc);
 
 StringAtom::StringAtom() : value_(kEmptyString) {}
 
+// static
+void StringAtom::GetTableStats(size_t* count, size_t* bytes) {
+  GetStringAtomSet().GetStats(count, bytes);
+}
+
 StringAtom::StringAtom(std::string_view str) noexcept
 #ifndef OS_ZOS
     : value_(*s_local_cache.find(str)){}
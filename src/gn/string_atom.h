@@ -119,6 +119,10 @@ class StringAtom {
 
   size_t hash() const { return std::hash<std::string>()(value_); }
 
+  // Returns the number of strings in the global table and an estimate of the
+  // bytes they use, for memory stats.
+  static void GetTableStats(size_t* count, size_t* bytes);
+
   // Use the following method and structs to implement containers that
   // use StringAtom values as keys, but only compare/hash the pointer
   // values for speed.
@@ -0,0 +1,78 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gn/string_atom.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+// Strings in the shape of source paths. They are interned once up front, so
+// the benchmarks measure lookups of existing atoms, which is what almost all
+// StringAtom constructions are.
+std::vector<std::string> MakeStrings(size_t count) {
+  std::vector<std::string> strings;
+  for (size_t i = 0; i < count; i++) {
+    strings.push_back("//components/module" + std::to_string(i / 40) +
+                      "/file" + std::to_string(i % 40) + ".cc");
+    StringAtom atom(strings.back());
+  }
+  return strings;
+}
+
+// Interns strings on the current thread, whose cache is warm after the first
+// iteration.
+void RunIntern(benchmark::State& state, size_t count) {
+  std::vector<std::string> strings = MakeStrings(count);
+  while (state.KeepRunning()) {
+    for (const std::string& str : strings)
+      benchmark::DoNotOptimize(StringAtom(str).ptr_hash());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Interns the same strings from |thread_count| new threads. Their caches are
+// empty so every lookup goes to the global table, as happens when the
+// scheduler's workers start loading files.
+void RunInternThreads(benchmark::State& state, size_t thread_count) {
+  const size_t kCount = 20000;
+  std::vector<std::string> strings = MakeStrings(kCount);
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; i++) {
+      threads.emplace_back([&strings]() {
+        for (const std::string& str : strings)
+          benchmark::DoNotOptimize(StringAtom(str).ptr_hash());
+      });
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  state.SetItemsProcessed(state.iterations() * thread_count * kCount);
+}
+
+}  // namespace
+
+BENCHMARK(StringAtom_Intern_1000) {
+  RunIntern(state, 1000);
+}
+
+BENCHMARK(StringAtom_Intern_100000) {
+  RunIntern(state, 100000);
+}
+
+BENCHMARK(StringAtom_InternColdCache_1Thread) {
+  RunInternThreads(state, 1);
+}
+
+BENCHMARK(StringAtom_InternColdCache_4Threads) {
+  RunInternThreads(state, 4);
+}
+
+BENCHMARK(StringAtom_InternColdCache_16Threads) {
+  RunInternThreads(state, 16);
+}
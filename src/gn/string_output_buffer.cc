@@ -6,12 +6,20 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "gn/dry_run.h"
 #include "gn/err.h"
 #include "gn/file_writer.h"
 #include "gn/filesystem_utils.h"
+#include "gn/memory_stats.h"
 
 #include <fstream>
 
+StringOutputBuffer::~StringOutputBuffer() {
+  int64_t pages = static_cast<int64_t>(pages_.size());
+  CountMemory(MemoryCounter::WRITER_BUFFERS, -pages,
+              -pages * static_cast<int64_t>(kPageSize));
+}
+
 std::string StringOutputBuffer::str() const {
   std::string result;
   size_t data_size = size();
@@ -32,6 +40,7 @@ void StringOutputBuffer::Append(std::string_view str) {
     if (page_free_size() == 0) {
       // Allocate a new page.
       pages_.push_back(std::make_unique<Page>());
+      CountMemory(MemoryCounter::WRITER_BUFFERS, 1, kPageSize);
       pos_ = 0;
     }
     size_t size = std::min(page_free_size(), str.size());
@@ -45,6 +54,7 @@ void StringOutputBuffer::Append(char c) {
   if (page_free_size() == 0) {
     // Allocate a new page.
     pages_.push_back(std::make_unique<Page>());
+    CountMemory(MemoryCounter::WRITER_BUFFERS, 1, kPageSize);
     pos_ = 0;
   }
   pages_.back()->data()[pos_] = c;
@@ -83,6 +93,11 @@ bool StringOutputBuffer::ContentsEqual(const base::FilePath& file_path) const {
 // Write the contents of this instance to a file at |file_path|.
 bool StringOutputBuffer::WriteToFile(const base::FilePath& file_path,
                                      Err* err) const {
+  if (DryRunEnabled()) {
+    RecordDryRunWrite(size(), !ContentsEqual(file_path));
+    return true;
+  }
+
   // Create the directory if necessary.
   if (!base::CreateDirectory(file_path.DirName())) {
     if (err) {
@@ -118,7 +133,12 @@ bool StringOutputBuffer::WriteToFile(const base::FilePath& file_path,
 
 bool StringOutputBuffer::WriteToFileIfChanged(const base::FilePath& file_path,
                                               Err* err) const {
-  if (ContentsEqual(file_path))
+  bool equal = ContentsEqual(file_path);
+  if (DryRunEnabled()) {
+    RecordDryRunWrite(size(), !equal);
+    return true;
+  }
+  if (equal)
     return true;
 
   return WriteToFile(file_path, err);
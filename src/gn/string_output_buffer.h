@@ -43,6 +43,8 @@ class Err;
 class StringOutputBuffer : public std::streambuf {
  public:
   StringOutputBuffer() = default;
+  StringOutputBuffer(StringOutputBuffer&& other) = default;
+  ~StringOutputBuffer() override;
 
   // Convert content to single std::string instance. Useful for unit-testing.
   std::string str() const;
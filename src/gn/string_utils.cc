@@ -351,3 +351,13 @@ std::string ReadStdin() {
   // TODO(thakis): Check ferror(stdin)?
   return result;
 }
+
+uint64_t StableHash(std::string_view str) {
+  // FNV-1a.
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
@@ -5,6 +5,8 @@
 #ifndef TOOLS_GN_STRING_UTILS_H_
 #define TOOLS_GN_STRING_UTILS_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <string_view>
 #include <vector>
@@ -53,4 +55,9 @@ std::string_view SpellcheckString(std::string_view text,
 // Reads stdin until end-of-data and returns what it read.
 std::string ReadStdin();
 
+// Returns a hash of the string that doesn't depend on the platform or the
+// standard library, for names and layouts of the generated files that must
+// be the same from one run to the next.
+uint64_t StableHash(std::string_view str);
+
 #endif  // TOOLS_GN_STRING_UTILS_H_
@@ -157,3 +157,9 @@ TEST(StringUtils, SpellcheckString) {
   // barbados has an edit distance of 4 from bravado, so there's no suggestion.
   EXPECT_TRUE(SpellcheckString("barbados", words).empty());
 }
+
+TEST(StringUtils, StableHash) {
+  EXPECT_EQ(0xcbf29ce484222325ull, StableHash(""));
+  EXPECT_EQ(0xaf63dc4c8601ec8cull, StableHash("a"));
+  EXPECT_NE(StableHash("ab"), StableHash("ba"));
+}
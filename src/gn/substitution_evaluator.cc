@@ -0,0 +1,206 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/substitution_evaluator.h"
+
+#include <ostream>
+#include <utility>
+
+#include "base/logging.h"
+#include "gn/build_settings.h"
+#include "gn/escape.h"
+#include "gn/output_file.h"
+#include "gn/settings.h"
+#include "gn/source_file.h"
+#include "gn/substitution_list.h"
+#include "gn/substitution_pattern.h"
+
+SubstitutionEvaluator::Program::Program() = default;
+
+SubstitutionEvaluator::Program::Program(Program&&) = default;
+
+SubstitutionEvaluator::Program::~Program() = default;
+
+SubstitutionEvaluator::Program& SubstitutionEvaluator::Program::operator=(
+    Program&&) = default;
+
+SubstitutionEvaluator::SubstitutionEvaluator(
+    const Target* target,
+    const Settings* settings,
+    SubstitutionWriter::OutputStyle output_style,
+    const SourceDir& relative_to)
+    : target_(target),
+      settings_(settings),
+      output_style_(output_style),
+      relative_to_(relative_to) {}
+
+SubstitutionEvaluator::~SubstitutionEvaluator() = default;
+
+SubstitutionEvaluator::Program SubstitutionEvaluator::Compile(
+    const SubstitutionPattern& pattern) const {
+  Program program;
+  program.pattern_ = &pattern;
+
+  // Appends a literal, merging it with the previous one if possible.
+  auto append_literal = [&program](const std::string& literal) {
+    if (literal.empty())
+      return;
+    if (program.instructions_.empty() ||
+        program.instructions_.back().type != nullptr)
+      program.instructions_.emplace_back();
+    program.instructions_.back().literal.append(literal);
+  };
+
+  for (const auto& range : pattern.ranges()) {
+    std::string target_value;
+    if (range.type == &SubstitutionLiteral) {
+      append_literal(range.literal);
+    } else if (target_ && SubstitutionWriter::GetTargetSubstitution(
+                              target_, range.type, &target_value)) {
+      // The target substitutions (which can be used in the outputs of the
+      // compiler tools) are the same for all sources. They're relative to the
+      // build directory, so like in SubstitutionWriter they can't be used for
+      // absolute output.
+      DCHECK(output_style_ == SubstitutionWriter::OUTPUT_RELATIVE &&
+             relative_to_ == settings_->build_settings()->build_dir())
+          << "Cannot use substitution " << range.type->name
+          << " for output that isn't relative to the build directory";
+      append_literal(target_value);
+    } else {
+      program.instructions_.emplace_back();
+      program.instructions_.back().type = range.type;
+    }
+  }
+  return program;
+}
+
+std::vector<SubstitutionEvaluator::Program> SubstitutionEvaluator::Compile(
+    const SubstitutionList& list) const {
+  std::vector<Program> programs;
+  programs.reserve(list.list().size());
+  for (const auto& pattern : list.list())
+    programs.push_back(Compile(pattern));
+  return programs;
+}
+
+std::string SubstitutionEvaluator::ApplyToSourceAsString(
+    const Program& program,
+    const SourceFile& source) {
+  std::string result;
+  for (const auto& instruction : program.instructions_) {
+    if (!instruction.type)
+      result.append(instruction.literal);
+    else
+      AppendSourceSubstitution(source, instruction.type, &result);
+  }
+  return result;
+}
+
+SourceFile SubstitutionEvaluator::ApplyToSource(const Program& program,
+                                                const SourceFile& source) {
+  std::string result = ApplyToSourceAsString(program, source);
+  CHECK(!result.empty() && result[0] == '/')
+      << "The result of the pattern \"" << program.pattern_->AsString()
+      << "\" was not a path beginning in \"/\" or \"//\".";
+  return SourceFile(std::move(result));
+}
+
+OutputFile SubstitutionEvaluator::ApplyToSourceAsOutputFile(
+    const Program& program,
+    const SourceFile& source) {
+  return OutputFile(settings_->build_settings(),
+                    ApplyToSource(program, source));
+}
+
+void SubstitutionEvaluator::ApplyToSourceAsString(
+    const std::vector<Program>& programs,
+    const SourceFile& source,
+    std::vector<std::string>* output) {
+  for (const auto& program : programs)
+    output->push_back(ApplyToSourceAsString(program, source));
+}
+
+void SubstitutionEvaluator::ApplyToSource(const std::vector<Program>& programs,
+                                          const SourceFile& source,
+                                          std::vector<SourceFile>* output) {
+  for (const auto& program : programs)
+    output->push_back(ApplyToSource(program, source));
+}
+
+void SubstitutionEvaluator::ApplyToSourceAsOutputFile(
+    const std::vector<Program>& programs,
+    const SourceFile& source,
+    std::vector<OutputFile>* output) {
+  for (const auto& program : programs)
+    output->push_back(ApplyToSourceAsOutputFile(program, source));
+}
+
+void SubstitutionEvaluator::WriteNinjaVariablesForSource(
+    const SourceFile& source,
+    const std::vector<const Substitution*>& types,
+    const EscapeOptions& escape_options,
+    std::ostream& out) {
+  for (const auto& type : types) {
+    // See SubstitutionWriter::WriteNinjaVariablesForSource.
+    if (type != &SubstitutionSource && type != &SubstitutionRspFileName) {
+      out << "  " << type->ninja_name << " = ";
+      EscapeStringToStream(out, GetSourceSubstitution(source, type),
+                           escape_options);
+      out << std::endl;
+    }
+  }
+}
+
+std::string SubstitutionEvaluator::GetSourceSubstitution(
+    const SourceFile& source,
+    const Substitution* type) {
+  std::string result;
+  AppendSourceSubstitution(source, type, &result);
+  return result;
+}
+
+// static
+SubstitutionEvaluator::DirPart SubstitutionEvaluator::GetDirPart(
+    const Substitution* type) {
+  if (type == &SubstitutionSourceDir)
+    return DIR_PART_SOURCE_DIR;
+  if (type == &SubstitutionSourceRootRelativeDir)
+    return DIR_PART_ROOT_RELATIVE_DIR;
+  if (type == &SubstitutionSourceGenDir)
+    return DIR_PART_GEN_DIR;
+  if (type == &SubstitutionSourceOutDir)
+    return DIR_PART_OUT_DIR;
+  return DIR_PART_COUNT;
+}
+
+void SubstitutionEvaluator::AppendSourceSubstitution(const SourceFile& source,
+                                                     const Substitution* type,
+                                                     std::string* result) {
+  DirPart part = GetDirPart(type);
+  if (part == DIR_PART_COUNT) {
+    // Depends on the file name, nothing worth memoizing.
+    result->append(SubstitutionWriter::GetSourceSubstitution(
+        target_, settings_, source, type, output_style_, relative_to_));
+    return;
+  }
+
+  const std::string& value = source.value();
+  std::string_view dir(value.data(), value.rfind('/') + 1);
+  if (!last_dir_parts_ || dir != last_dir_) {
+    auto found = dir_parts_.find(dir);
+    if (found == dir_parts_.end())
+      found = dir_parts_.emplace(std::string(dir), DirParts()).first;
+    last_dir_ = found->first;
+    last_dir_parts_ = &found->second;
+  }
+
+  if (!last_dir_parts_->computed[part]) {
+    // These only depend on the directory, so any source of the directory
+    // gives the same result.
+    last_dir_parts_->values[part] = SubstitutionWriter::GetSourceSubstitution(
+        target_, settings_, source, type, output_style_, relative_to_);
+    last_dir_parts_->computed[part] = true;
+  }
+  result->append(last_dir_parts_->values[part]);
+}
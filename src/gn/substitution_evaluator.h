@@ -0,0 +1,153 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_SUBSTITUTION_EVALUATOR_H_
+#define TOOLS_GN_SUBSTITUTION_EVALUATOR_H_
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gn/source_dir.h"
+#include "gn/substitution_writer.h"
+
+struct EscapeOptions;
+class OutputFile;
+class Settings;
+class SourceFile;
+class SubstitutionList;
+class SubstitutionPattern;
+class Target;
+
+// Applies source substitution patterns to many sources of the same target.
+//
+// SubstitutionWriter::ApplyPatternToSource interprets the pattern for each
+// source: it switches over the substitution types of every range and
+// recomputes the directories of the source for each of them. This instead
+// compiles the patterns once into a list of instructions where the adjacent
+// literals are merged and the target substitutions are resolved, and
+// memoizes the directory-derived substitutions ({{source_dir}},
+// {{source_gen_dir}}...) per source directory, since the sources of a target
+// usually live in a handful of directories.
+//
+// The results are the same as the corresponding SubstitutionWriter functions.
+//
+// Not thread-safe, an evaluator is meant to be used by one writer.
+class SubstitutionEvaluator {
+ public:
+  // A compiled SubstitutionPattern.
+  class Program {
+   public:
+    Program();
+    Program(Program&&);
+    ~Program();
+
+    Program& operator=(Program&&);
+
+   private:
+    friend class SubstitutionEvaluator;
+
+    struct Instruction {
+      // Null for literals.
+      const Substitution* type = nullptr;
+      std::string literal;
+    };
+
+    std::vector<Instruction> instructions_;
+
+    // The pattern the program was compiled from, for error messages.
+    const SubstitutionPattern* pattern_ = nullptr;
+  };
+
+  // The target can be null (see SubstitutionWriter), in which case the
+  // evaluator only handles source substitutions. The directories are written
+  // according to the output style, like
+  // SubstitutionWriter::GetSourceSubstitution.
+  SubstitutionEvaluator(const Target* target,
+                        const Settings* settings,
+                        SubstitutionWriter::OutputStyle output_style,
+                        const SourceDir& relative_to);
+  ~SubstitutionEvaluator();
+
+  // Compiles the pattern. The pattern must outlive the returned program.
+  Program Compile(const SubstitutionPattern& pattern) const;
+  std::vector<Program> Compile(const SubstitutionList& list) const;
+
+  // Applies a compiled pattern to a source, like the corresponding
+  // SubstitutionWriter::ApplyPatternToSource* functions.
+  std::string ApplyToSourceAsString(const Program& program,
+                                    const SourceFile& source);
+  SourceFile ApplyToSource(const Program& program, const SourceFile& source);
+  OutputFile ApplyToSourceAsOutputFile(const Program& program,
+                                       const SourceFile& source);
+
+  // Applies compiled lists to a source, APPENDING the result to the output
+  // vector like SubstitutionWriter::ApplyListToSource*.
+  void ApplyToSourceAsString(const std::vector<Program>& programs,
+                             const SourceFile& source,
+                             std::vector<std::string>* output);
+  void ApplyToSource(const std::vector<Program>& programs,
+                     const SourceFile& source,
+                     std::vector<SourceFile>* output);
+  void ApplyToSourceAsOutputFile(const std::vector<Program>& programs,
+                                 const SourceFile& source,
+                                 std::vector<OutputFile>* output);
+
+  // Like SubstitutionWriter::WriteNinjaVariablesForSource. The evaluator
+  // should write its directories relative to the build directory.
+  void WriteNinjaVariablesForSource(
+      const SourceFile& source,
+      const std::vector<const Substitution*>& types,
+      const EscapeOptions& escape_options,
+      std::ostream& out);
+
+  // Like SubstitutionWriter::GetSourceSubstitution, with the directories
+  // memoized.
+  std::string GetSourceSubstitution(const SourceFile& source,
+                                    const Substitution* type);
+
+ private:
+  // The substitutions that only depend on the directory of the source.
+  enum DirPart {
+    DIR_PART_SOURCE_DIR,
+    DIR_PART_ROOT_RELATIVE_DIR,
+    DIR_PART_GEN_DIR,
+    DIR_PART_OUT_DIR,
+
+    DIR_PART_COUNT,
+  };
+
+  struct DirParts {
+    bool computed[DIR_PART_COUNT] = {};
+    std::string values[DIR_PART_COUNT];
+  };
+
+  // Returns the index of the directory part for the type, or DIR_PART_COUNT
+  // if it doesn't only depend on the directory.
+  static DirPart GetDirPart(const Substitution* type);
+
+  // Appends the value of the substitution for the source to |result|.
+  void AppendSourceSubstitution(const SourceFile& source,
+                                const Substitution* type,
+                                std::string* result);
+
+  const Target* target_;
+  const Settings* settings_;
+  SubstitutionWriter::OutputStyle output_style_;
+  SourceDir relative_to_;
+
+  // Maps the directories of the sources (with a trailing slash) to their
+  // directory parts. The last one is remembered since sources are usually
+  // grouped by directory.
+  std::map<std::string, DirParts, std::less<>> dir_parts_;
+  std::string_view last_dir_;
+  DirParts* last_dir_parts_ = nullptr;
+
+  SubstitutionEvaluator(const SubstitutionEvaluator&) = delete;
+  SubstitutionEvaluator& operator=(const SubstitutionEvaluator&) = delete;
+};
+
+#endif  // TOOLS_GN_SUBSTITUTION_EVALUATOR_H_
@@ -0,0 +1,139 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+
+#include "gn/escape.h"
+#include "gn/substitution_evaluator.h"
+#include "gn/substitution_list.h"
+#include "gn/substitution_pattern.h"
+#include "gn/substitution_type.h"
+#include "gn/target.h"
+#include "gn/test_with_scope.h"
+#include "util/test/test.h"
+
+// Compiled patterns must give the same results as the interpreted ones.
+TEST(SubstitutionEvaluator, ApplyToSource) {
+  TestWithScope setup;
+  Err err;
+
+  Target target(setup.settings(), Label(SourceDir("//foo/"), "bar"));
+  target.set_output_type(Target::ACTION_FOREACH);
+  target.SetToolchain(setup.toolchain());
+  ASSERT_TRUE(target.OnResolved(&err));
+
+  SubstitutionList list = SubstitutionList::MakeForTest(
+      "{{source_gen_dir}}/{{source_name_part}}.h",
+      "{{source_out_dir}}/{{source_root_relative_dir}}/{{source_file_part}}",
+      "{{source_dir}}/{{source_target_relative}}.stamp");
+  std::vector<SourceFile> sources = {
+      SourceFile("//foo/a.txt"), SourceFile("//foo/sub/b.txt"),
+      SourceFile("//foo/c.txt"), SourceFile("//out/Debug/gen/d.txt")};
+
+  SubstitutionEvaluator evaluator(&target, setup.settings(),
+                                  SubstitutionWriter::OUTPUT_ABSOLUTE,
+                                  SourceDir());
+  std::vector<SubstitutionEvaluator::Program> programs =
+      evaluator.Compile(list);
+  for (const SourceFile& source : sources) {
+    std::vector<std::string> expected;
+    SubstitutionWriter::ApplyListToSourceAsString(&target, setup.settings(),
+                                                  list, source, &expected);
+    std::vector<std::string> result;
+    evaluator.ApplyToSourceAsString(programs, source, &result);
+    EXPECT_EQ(expected, result);
+  }
+
+  std::vector<OutputFile> outputs;
+  evaluator.ApplyToSourceAsOutputFile(programs, sources[1], &outputs);
+  ASSERT_EQ(3u, outputs.size());
+  EXPECT_EQ("gen/foo/sub/b.h", outputs[0].value());
+  EXPECT_EQ("obj/foo/sub/foo/sub/b.txt", outputs[1].value());
+  EXPECT_EQ("../../foo/sub/sub/b.txt.stamp", outputs[2].value());
+}
+
+// Target substitutions are resolved when compiling.
+TEST(SubstitutionEvaluator, TargetSubstitutions) {
+  TestWithScope setup;
+  Err err;
+
+  Target target(setup.settings(), Label(SourceDir("//foo/"), "bar"));
+  target.set_output_type(Target::SOURCE_SET);
+  target.SetToolchain(setup.toolchain());
+  ASSERT_TRUE(target.OnResolved(&err));
+
+  SubstitutionEvaluator evaluator(
+      &target, setup.settings(), SubstitutionWriter::OUTPUT_RELATIVE,
+      setup.settings()->build_settings()->build_dir());
+  SubstitutionPattern pattern = SubstitutionPattern::MakeForTest(
+      "{{target_out_dir}}/{{label_name}}.{{source_name_part}}.o");
+  SubstitutionEvaluator::Program program = evaluator.Compile(pattern);
+
+  SourceFile source("//foo/input.cc");
+  EXPECT_EQ(SubstitutionWriter::ApplyPatternToCompilerAsOutputFile(
+                &target, source, pattern)
+                .value(),
+            evaluator.ApplyToSourceAsString(program, source));
+  EXPECT_EQ("obj/foo/bar.input.o",
+            evaluator.ApplyToSourceAsString(program, source));
+}
+
+// Copy outputs are absolute, so only source substitutions can be used in them:
+// the target substitutions are relative to the build directory, and compiling
+// them for absolute output is rejected.
+TEST(SubstitutionEvaluator, CopyOutputs) {
+  TestWithScope setup;
+  Err err;
+
+  Target target(setup.settings(), Label(SourceDir("//foo/"), "copy"));
+  target.set_output_type(Target::COPY_FILES);
+  target.SetToolchain(setup.toolchain());
+  ASSERT_TRUE(target.OnResolved(&err));
+
+  SubstitutionList list = SubstitutionList::MakeForTest(
+      "{{source_gen_dir}}/{{source_file_part}}",
+      "{{source_root_relative_dir}}/{{source_target_relative}}");
+  ASSERT_FALSE(list.required_types().empty());
+  for (const Substitution* type : list.required_types())
+    EXPECT_TRUE(IsValidSourceSubstitution(type)) << type->name;
+
+  SubstitutionEvaluator evaluator(&target, setup.settings(),
+                                  SubstitutionWriter::OUTPUT_ABSOLUTE,
+                                  SourceDir());
+  std::vector<SubstitutionEvaluator::Program> programs =
+      evaluator.Compile(list);
+  SourceFile source("//foo/sub/a.txt");
+  std::vector<std::string> expected;
+  SubstitutionWriter::ApplyListToSourceAsString(&target, setup.settings(),
+                                                list, source, &expected);
+  std::vector<std::string> result;
+  evaluator.ApplyToSourceAsString(programs, source, &result);
+  EXPECT_EQ(expected, result);
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ("//out/Debug/gen/foo/sub/a.txt", result[0]);
+  EXPECT_EQ("foo/sub/sub/a.txt", result[1]);
+}
+
+TEST(SubstitutionEvaluator, WriteNinjaVariablesForSource) {
+  TestWithScope setup;
+
+  std::vector<const Substitution*> types = {
+      &SubstitutionSource, &SubstitutionSourceNamePart, &SubstitutionSourceDir,
+      &SubstitutionSourceGenDir};
+  EscapeOptions options;
+  options.mode = ESCAPE_NONE;
+
+  SubstitutionEvaluator evaluator(
+      nullptr, setup.settings(), SubstitutionWriter::OUTPUT_RELATIVE,
+      setup.settings()->build_settings()->build_dir());
+  for (const char* file : {"//foo/bar/a.txt", "//foo/bar/b.txt", "//baz.txt"}) {
+    SourceFile source(file);
+    std::ostringstream expected;
+    SubstitutionWriter::WriteNinjaVariablesForSource(
+        nullptr, setup.settings(), source, types, options, expected);
+    std::ostringstream out;
+    evaluator.WriteNinjaVariablesForSource(source, types, options, out);
+    EXPECT_EQ(expected.str(), out.str());
+  }
+}
@@ -14,6 +14,7 @@
 #include "gn/settings.h"
 #include "gn/source_file.h"
 #include "gn/string_utils.h"
+#include "gn/substitution_evaluator.h"
 #include "gn/substitution_list.h"
 #include "gn/substitution_pattern.h"
 #include "gn/target.h"
@@ -287,8 +288,12 @@ void SubstitutionWriter::ApplyListToSources(
     const std::vector<SourceFile>& sources,
     std::vector<SourceFile>* output) {
   output->clear();
+  SubstitutionEvaluator evaluator(target, settings, OUTPUT_ABSOLUTE,
+                                  SourceDir());
+  std::vector<SubstitutionEvaluator::Program> programs =
+      evaluator.Compile(list);
   for (const auto& source : sources)
-    ApplyListToSource(target, settings, list, source, output);
+    evaluator.ApplyToSource(programs, source, output);
 }
 
 // static
@@ -299,8 +304,12 @@ void SubstitutionWriter::ApplyListToSourcesAsString(
     const std::vector<SourceFile>& sources,
     std::vector<std::string>* output) {
   output->clear();
+  SubstitutionEvaluator evaluator(target, settings, OUTPUT_ABSOLUTE,
+                                  SourceDir());
+  std::vector<SubstitutionEvaluator::Program> programs =
+      evaluator.Compile(list);
   for (const auto& source : sources)
-    ApplyListToSourceAsString(target, settings, list, source, output);
+    evaluator.ApplyToSourceAsString(programs, source, output);
 }
 
 // static
@@ -311,8 +320,12 @@ void SubstitutionWriter::ApplyListToSourcesAsOutputFile(
     const std::vector<SourceFile>& sources,
     std::vector<OutputFile>* output) {
   output->clear();
+  SubstitutionEvaluator evaluator(target, settings, OUTPUT_ABSOLUTE,
+                                  SourceDir());
+  std::vector<SubstitutionEvaluator::Program> programs =
+      evaluator.Compile(list);
   for (const auto& source : sources)
-    ApplyListToSourceAsOutputFile(target, settings, list, source, output);
+    evaluator.ApplyToSourceAsOutputFile(programs, source, output);
 }
 
 // static
@@ -99,6 +99,29 @@ const char kNoColor[] = "nocolor";
 const char kNoColor_HelpShort[] = "--nocolor: Force non-colored output.";
 const char kNoColor_Help[] = COLOR_HELP_LONG;
 
+const char kMemstats[] = "memstats";
+const char kMemstats_HelpShort[] =
+    "--memstats: Outputs a summary of memory use for each phase of gen.";
+const char kMemstats_Help[] =
+    R"(--memstats: Outputs a summary of memory use for each phase of gen.
+
+  At the end of setup, of loading (which includes executing the build files,
+  resolving targets and writing their ninja files, as these overlap) and of
+  writing the remaining output files, records the peak RSS of the process and
+  the number of objects and bytes held by the major owners of memory: input
+  files and their tokens, parse nodes, the StringAtom table, scopes and their
+  values, builder records, targets, configs and the buffers used to write
+  files.
+
+  Byte counts are estimates of the memory held directly by each owner. For
+  owners that come and go, such as writer buffers, the peak during the phase
+  is also shown.
+
+Examples
+
+  gn gen out/Default --memstats
+)";
+
 const char kNinjaExecutable[] = "ninja-executable";
 const char kNinjaExecutable_HelpShort[] =
     "--ninja-executable: Set the Ninja executable.";
@@ -123,6 +146,28 @@ const char kScriptExecutable_Help[] =
   targets and exec_script calls will be executed directly.
 )";
 
+const char kProfile[] = "profile";
+const char kProfile_HelpShort[] =
+    "--profile: Writes a profile of GN script execution to the given file.";
+const char kProfile_Help[] =
+    R"(--profile: Writes a profile of GN script execution to the given file.
+
+  Records every template invocation and builtin function call, and writes a
+  report of the self time, inclusive time and number of calls of each
+  template, function and call site, sorted by self time. Times are summed over
+  all threads, and the inclusive time of recursive calls is only counted once.
+
+  The call stacks are also written in the collapsed format used by flame graph
+  tools to the same file name with ".folded" appended. For example, with
+  flamegraph.pl:
+
+    flamegraph.pl myprofile.txt.folded > myprofile.svg
+
+Examples
+
+  gn gen out/Default --profile=myprofile.txt
+)";
+
 const char kQuiet[] = "q";
 const char kQuiet_HelpShort[] =
     "-q: Quiet mode. Don't print output on success.";
@@ -246,6 +291,25 @@ Runtime deps output file
   "bar.so").
 )";
 
+const char kScriptJobs[] = "script-jobs";
+const char kScriptJobs_HelpShort[] =
+    "--script-jobs: Limit the number of concurrent exec_script processes.";
+const char kScriptJobs_Help[] =
+    R"(--script-jobs: Limit the number of concurrent exec_script processes.
+
+  Build files are executed on many threads, so several exec_script() calls can
+  run at the same time. This switch bounds how many script processes may run
+  concurrently. The default is the number of logical CPUs.
+
+  Identical exec_script() calls (same script, arguments and working directory)
+  are only run once per GN invocation regardless of this setting: concurrent
+  callers wait for the first one and share its result.
+
+Examples
+
+  gn gen out/Default --script-jobs=4
+)";
+
 const char kThreads[] = "threads";
 const char kThreads_HelpShort[] =
     "--threads: Specify number of worker threads.";
@@ -335,13 +399,16 @@ const SwitchInfoMap& GetSwitches() {
     INSERT_VARIABLE(Dotfile)
     INSERT_VARIABLE(FailOnUnusedArgs)
     INSERT_VARIABLE(Markdown)
+    INSERT_VARIABLE(Memstats)
     INSERT_VARIABLE(NinjaExecutable)
     INSERT_VARIABLE(NoColor)
+    INSERT_VARIABLE(Profile)
     INSERT_VARIABLE(Root)
     INSERT_VARIABLE(RootTarget)
     INSERT_VARIABLE(Quiet)
     INSERT_VARIABLE(RuntimeDepsListFile)
     INSERT_VARIABLE(ScriptExecutable)
+    INSERT_VARIABLE(ScriptJobs)
     INSERT_VARIABLE(Threads)
     INSERT_VARIABLE(Time)
     INSERT_VARIABLE(Tracelog)
@@ -46,6 +46,10 @@ extern const char kMarkdown[];
 extern const char kMarkdown_HelpShort[];
 extern const char kMarkdown_Help[];
 
+extern const char kMemstats[];
+extern const char kMemstats_HelpShort[];
+extern const char kMemstats_Help[];
+
 extern const char kNinjaExecutable[];
 extern const char kNinjaExecutable_HelpShort[];
 extern const char kNinjaExecutable_Help[];
@@ -58,6 +62,10 @@ extern const char kScriptExecutable[];
 extern const char kScriptExecutable_HelpShort[];
 extern const char kScriptExecutable_Help[];
 
+extern const char kProfile[];
+extern const char kProfile_HelpShort[];
+extern const char kProfile_Help[];
+
 extern const char kQuiet[];
 extern const char kQuiet_HelpShort[];
 extern const char kQuiet_Help[];
@@ -78,6 +86,10 @@ extern const char kRuntimeDepsListFile[];
 extern const char kRuntimeDepsListFile_HelpShort[];
 extern const char kRuntimeDepsListFile_Help[];
 
+extern const char kScriptJobs[];
+extern const char kScriptJobs_HelpShort[];
+extern const char kScriptJobs_Help[];
+
 extern const char kThreads[];
 extern const char kThreads_HelpShort[];
 extern const char kThreads_Help[];
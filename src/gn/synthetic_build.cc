@@ -0,0 +1,221 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/synthetic_build.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "gn/filesystem_utils.h"
+
+namespace {
+
+bool WriteBuildFile(const base::FilePath& root,
+                    const std::string& relative_path,
+                    const std::string& contents) {
+  base::FilePath path =
+      root.Append(UTF8ToFilePath(relative_path)).NormalizePathSeparators();
+  if (!base::CreateDirectory(path.DirName()))
+    return false;
+  return base::WriteFile(path, contents.data(),
+                         static_cast<int>(contents.size())) ==
+         static_cast<int>(contents.size());
+}
+
+// Returns the source-absolute directory of the given directory index, without
+// a trailing slash. Directories are grouped ten to a parent to give the tree
+// some depth.
+std::string DirName(int dir) {
+  return "//src/g" + std::to_string(dir / 10) + "/d" + std::to_string(dir);
+}
+
+std::string ToolchainLabel(int toolchain) {
+  return "//build/toolchain:tc" + std::to_string(toolchain);
+}
+
+std::string LibraryName(int target) {
+  return "lib_" + std::to_string(target);
+}
+
+std::string GetToolchainFile(const SyntheticBuildOptions& options) {
+  std::string out;
+  for (int i = 0; i < options.toolchains; i++) {
+    if (i != 0)
+      out += "\n";
+    out += "toolchain(\"tc" + std::to_string(i) + "\") {\n";
+    for (const char* tool : {"cc", "cxx"}) {
+      out += "  tool(\"" + std::string(tool) + "\") {\n";
+      out +=
+          "    command = \"cc -MMD -MF {{output}}.d {{defines}} "
+          "{{include_dirs}} {{cflags}} -c {{source}} -o {{output}}\"\n";
+      out += "    depfile = \"{{output}}.d\"\n";
+      out += "    depsformat = \"gcc\"\n";
+      out += "    description = \"CC {{output}}\"\n";
+      out += "    outputs = [ \"{{source_out_dir}}/"
+             "{{target_output_name}}.{{source_name_part}}.o\" ]\n";
+      out += "  }\n";
+    }
+    out += "  tool(\"link\") {\n";
+    out +=
+        "    command = \"cc {{ldflags}} -o {{output}} {{inputs}} {{libs}}\"\n";
+    out += "    description = \"LINK {{output}}\"\n";
+    out += "    outputs = [ \"{{root_out_dir}}/{{target_output_name}}\" ]\n";
+    out += "  }\n";
+    out += "  tool(\"stamp\") {\n";
+    out += "    command = \"touch {{output}}\"\n";
+    out += "    description = \"STAMP {{output}}\"\n";
+    out += "  }\n";
+    out += "  tool(\"copy\") {\n";
+    out += "    command = \"cp {{source}} {{output}}\"\n";
+    out += "    description = \"COPY {{source}} {{output}}\"\n";
+    out += "  }\n";
+    out += "}\n";
+  }
+  return out;
+}
+
+std::string GetTemplatesFile(const SyntheticBuildOptions& options) {
+  std::string out;
+  for (int level = 1; level <= options.template_depth; level++) {
+    std::string inner = level == 1
+                            ? std::string("source_set")
+                            : "synthetic_library_" + std::to_string(level - 1);
+    out += "template(\"synthetic_library_" + std::to_string(level) + "\") {\n";
+    out += "  " + inner + "(target_name) {\n";
+    out += "    forward_variables_from(invoker, \"*\")\n";
+    out += "    if (!defined(defines)) {\n";
+    out += "      defines = []\n";
+    out += "    }\n";
+    out += "    defines += [ \"SYNTHETIC_LEVEL_" + std::to_string(level) +
+           "\" ]\n";
+    out += "  }\n";
+    out += "}\n\n";
+  }
+  return out;
+}
+
+std::string GetDirectoryBuildFile(const SyntheticBuildOptions& options,
+                                  int dir) {
+  std::string dir_suffix = std::to_string(dir);
+  std::string out;
+  if (options.template_depth > 0)
+    out += "import(\"//build/templates.gni\")\n\n";
+
+  out += "config(\"d" + dir_suffix + "_config\") {\n";
+  out += "  defines = [ \"SYNTHETIC_DIR_" + dir_suffix + "\" ]\n";
+  out += "  include_dirs = [ \"include\" ]\n";
+  out += "}\n";
+
+  std::string target_type =
+      options.template_depth > 0
+          ? "synthetic_library_" + std::to_string(options.template_depth)
+          : std::string("source_set");
+  for (int target = 0; target < options.targets_per_file; target++) {
+    std::string name = LibraryName(target);
+    out += "\n" + target_type + "(\"" + name + "\") {\n";
+    out += "  sources = [\n";
+    for (int source = 0; source < options.sources_per_target; source++) {
+      out += "    \"" + name + "_" + std::to_string(source / 2) +
+             (source % 2 == 0 ? ".cc" : ".h") + "\",\n";
+    }
+    out += "  ]\n";
+    out += "  public_configs = [ \":d" + dir_suffix + "_config\" ]\n";
+
+    // Depend on the previous directory and on one about halfway back, so
+    // there are both long chains and wide fan-in.
+    out += "  deps = [\n";
+    if (dir > 0)
+      out += "    \"" + DirName(dir - 1) + ":" + name + "\",\n";
+    if (dir > 2)
+      out += "    \"" + DirName(dir / 2) + ":" + LibraryName(0) + "\",\n";
+    if (target > 0)
+      out += "    \":" + LibraryName(target - 1) + "\",\n";
+    out += "  ]\n";
+    out += "}\n";
+  }
+
+  out += "\nexecutable(\"exe\") {\n";
+  out += "  output_name = \"exe_" + dir_suffix + "\"\n";
+  out += "  sources = [ \"main.cc\" ]\n";
+  out += "  deps = [\n";
+  for (int target = 0; target < options.targets_per_file; target++)
+    out += "    \":" + LibraryName(target) + "\",\n";
+  out += "  ]\n";
+  out += "}\n";
+  return out;
+}
+
+std::string GetRootBuildFile(const SyntheticBuildOptions& options) {
+  std::string out = "group(\"all\") {\n";
+  out += "  deps = [\n";
+  for (int toolchain = 0; toolchain < options.toolchains; toolchain++) {
+    for (int dir = 0; dir < options.directories; dir++) {
+      out += "    \"" + DirName(dir) + ":exe";
+      if (toolchain != 0)
+        out += "(" + ToolchainLabel(toolchain) + ")";
+      out += "\",\n";
+    }
+  }
+  out += "  ]\n";
+  out += "}\n";
+  return out;
+}
+
+}  // namespace
+
+bool WriteSyntheticBuild(const base::FilePath& root,
+                         const SyntheticBuildOptions& options) {
+  const char kDotfile[] = "buildconfig = \"//build/BUILDCONFIG.gn\"\n";
+  const char kBuildConfig[] =
+      R"(set_default_toolchain("//build/toolchain:tc0")
+
+_default_configs = [
+  "//build:compiler",
+  "//build:warnings",
+]
+set_defaults("source_set") {
+  configs = _default_configs
+}
+set_defaults("executable") {
+  configs = _default_configs
+}
+)";
+  const char kBuildBuildFile[] = R"(config("compiler") {
+  cflags = [
+    "-O2",
+    "-fno-exceptions",
+  ]
+  defines = [ "SYNTHETIC_BUILD" ]
+  include_dirs = [ "//" ]
+}
+
+config("warnings") {
+  cflags = [
+    "-Wall",
+    "-Wextra",
+  ]
+}
+)";
+
+  if (!WriteBuildFile(root, ".gn", kDotfile) ||
+      !WriteBuildFile(root, "build/BUILDCONFIG.gn", kBuildConfig) ||
+      !WriteBuildFile(root, "build/BUILD.gn", kBuildBuildFile) ||
+      !WriteBuildFile(root, "build/toolchain/BUILD.gn",
+                      GetToolchainFile(options)) ||
+      !WriteBuildFile(root, "BUILD.gn", GetRootBuildFile(options)))
+    return false;
+
+  if (options.template_depth > 0 &&
+      !WriteBuildFile(root, "build/templates.gni", GetTemplatesFile(options)))
+    return false;
+
+  for (int dir = 0; dir < options.directories; dir++) {
+    // Strip the leading "//" to get the path relative to the root.
+    if (!WriteBuildFile(root, DirName(dir).substr(2) + "/BUILD.gn",
+                        GetDirectoryBuildFile(options, dir)))
+      return false;
+  }
+  return true;
+}
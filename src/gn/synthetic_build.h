@@ -0,0 +1,44 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_SYNTHETIC_BUILD_H_
+#define TOOLS_GN_SYNTHETIC_BUILD_H_
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+// Parameters of a synthetic build generated by WriteSyntheticBuild().
+struct SyntheticBuildOptions {
+  // Number of directories with a BUILD.gn file.
+  int directories = 100;
+
+  // Number of library targets defined in each BUILD.gn file. Each directory
+  // also has an executable depending on all of them.
+  int targets_per_file = 5;
+
+  // Number of nested templates each library target goes through before
+  // reaching a source_set. 0 defines the source_sets directly.
+  int template_depth = 2;
+
+  // Number of toolchains the whole build is loaded in.
+  int toolchains = 1;
+
+  // Number of source files listed in each library target.
+  int sources_per_target = 10;
+};
+
+// Writes the .gn file and the build files of a synthetic build to |root|,
+// which must exist. The generated files only depend on |options|, and don't
+// use exec_script() or read any other files, so loading them measures GN
+// itself.
+//
+// The root BUILD.gn file has an "all" group depending on the executables of
+// every directory in every toolchain. Library targets depend on targets in
+// other directories so the build graph is connected. Returns false if a file
+// couldn't be written.
+bool WriteSyntheticBuild(const base::FilePath& root,
+                         const SyntheticBuildOptions& options);
+
+#endif  // TOOLS_GN_SYNTHETIC_BUILD_H_
@@ -0,0 +1,51 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/synthetic_build.h"
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "gn/builder.h"
+#include "gn/filesystem_utils.h"
+#include "gn/setup.h"
+#include "gn/switches.h"
+#include "gn/target.h"
+#include "gn/test_with_scheduler.h"
+
+using SyntheticBuildTest = TestWithScheduler;
+
+TEST_F(SyntheticBuildTest, Loads) {
+  base::ScopedTempDir in_temp_dir;
+  ASSERT_TRUE(in_temp_dir.CreateUniqueTempDir());
+  base::FilePath in_path = in_temp_dir.GetPath();
+
+  SyntheticBuildOptions options;
+  options.directories = 4;
+  options.targets_per_file = 3;
+  options.template_depth = 2;
+  options.toolchains = 2;
+  options.sources_per_target = 4;
+  ASSERT_TRUE(WriteSyntheticBuild(in_path, options));
+
+  base::ScopedTempDir build_temp_dir;
+  ASSERT_TRUE(build_temp_dir.CreateUniqueTempDir());
+
+  base::CommandLine cmdline(base::CommandLine::NO_PROGRAM);
+  cmdline.AppendSwitchPath(switches::kRoot, in_path);
+
+  Setup setup;
+  ASSERT_TRUE(
+      setup.DoSetup(FilePathToUTF8(build_temp_dir.GetPath()), true, cmdline));
+  ASSERT_TRUE(setup.Run(cmdline));
+
+  // Each directory has its libraries and an executable in every toolchain,
+  // plus the "all" group in the default one.
+  std::vector<const Target*> targets = setup.builder().GetAllResolvedTargets();
+  EXPECT_EQ(static_cast<size_t>(options.directories *
+                                    (options.targets_per_file + 1) *
+                                    options.toolchains +
+                                1),
+            targets.size());
+}
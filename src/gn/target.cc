@@ -407,6 +407,38 @@ Target::GeneratedFile& Target::generated_file() {
   return *generated_file_;
 }
 
+size_t Target::GetLayoutSize() const {
+  size_t size = sizeof(Target);
+  if (bundle_data_)
+    size += sizeof(BundleData);
+  if (config_values_)
+    size += sizeof(ConfigValues);
+  if (action_values_)
+    size += sizeof(ActionValues);
+  if (rust_values_)
+    size += sizeof(RustValues);
+  if (swift_values_)
+    size += sizeof(SwiftValues);
+  if (metadata_)
+    size += sizeof(Metadata);
+  if (generated_file_)
+    size += sizeof(GeneratedFile);
+  if (rare_values_)
+    size += sizeof(RareValues);
+  return size;
+}
+
+const Target::RareValues& Target::rare_values() const {
+  static const RareValues kEmptyRareValues;
+  return rare_values_ ? *rare_values_ : kEmptyRareValues;
+}
+
+Target::RareValues& Target::mutable_rare_values() {
+  if (!rare_values_)
+    rare_values_ = std::make_unique<RareValues>();
+  return *rare_values_;
+}
+
 // static
 const char* Target::GetStringForOutputType(OutputType type) {
   switch (type) {
@@ -506,7 +538,7 @@ bool Target::OnResolved(Err* err) {
     return false;
   CheckSourcesGenerated();
 
-  if (!write_runtime_deps_output_.value().empty())
+  if (!write_runtime_deps_output().value().empty())
     g_scheduler->AddWriteRuntimeDepsTarget(this);
 
   if (output_type_ == GENERATED_FILE) {
@@ -553,7 +585,7 @@ bool Target::ShouldGenerate() const {
     // By default, generate all targets that belong to the default toolchain.
     return settings()->is_default();
   }
-  return LabelPattern::VectorMatches(root_patterns, label());
+  return root_patterns.Matches(label());
 }
 
 DepsIteratorRange Target::GetDeps(DepsIterationType type) const {
@@ -571,7 +603,7 @@ std::string Target::GetComputedOutputName() const {
       << "Toolchain must be specified before getting the computed output name.";
 
   const std::string& name =
-      output_name_.empty() ? label().name() : output_name_;
+      output_name().empty() ? label().name() : output_name();
 
   std::string result;
   const Tool* tool = toolchain_->GetToolForTargetFinalOutput(this);
@@ -867,10 +899,12 @@ bool Target::FillOutputFiles(Err* err) {
 
       if (tool->runtime_outputs().list().empty()) {
         // Default to the first output for the runtime output.
-        runtime_outputs_.push_back(dependency_output_file_);
+        mutable_rare_values().runtime_outputs.push_back(
+            dependency_output_file_);
       } else {
         SubstitutionWriter::ApplyListToLinkerAsOutputFile(
-            this, tool, tool->runtime_outputs(), &runtime_outputs_);
+            this, tool, tool->runtime_outputs(),
+            &mutable_rare_values().runtime_outputs);
       }
       break;
     case RUST_LIBRARY:
@@ -927,10 +961,11 @@ bool Target::FillOutputFiles(Err* err) {
       }
       if (!runtime_outputs_ptr || runtime_outputs_ptr->list().empty()) {
         // Default to the link output for the runtime output.
-        runtime_outputs_.push_back(link_output_file_);
+        mutable_rare_values().runtime_outputs.push_back(link_output_file_);
       } else {
         SubstitutionWriter::ApplyListToLinkerAsOutputFile(
-            this, tool, *runtime_outputs_ptr, &runtime_outputs_);
+            this, tool, *runtime_outputs_ptr,
+            &mutable_rare_values().runtime_outputs);
       }
       break;
     }
@@ -1092,14 +1127,14 @@ bool Target::CheckTestonly(Err* err) const {
 }
 
 bool Target::CheckAssertNoDeps(Err* err) const {
-  if (assert_no_deps_.empty())
+  if (assert_no_deps().empty())
     return true;
 
   TargetSet visited;
   std::string failure_path_str;
   const LabelPattern* failure_pattern = nullptr;
 
-  if (!RecursiveCheckAssertNoDeps(this, false, assert_no_deps_, &visited,
+  if (!RecursiveCheckAssertNoDeps(this, false, assert_no_deps(), &visited,
                                   &failure_path_str, &failure_pattern)) {
     *err = Err(
         defined_from(), "assert_no_deps failed.",
@@ -1225,7 +1260,7 @@ bool Target::GetMetadata(const std::vector<std::string>& keys_to_extract,
     bool found_next = false;
     for (const auto& dep : all_deps) {
       // Match against the label with the toolchain.
-      if (dep.label.GetUserVisibleName(true) == canonicalize_next_label) {
+      if (dep.label->GetUserVisibleName(true) == canonicalize_next_label) {
         // If we haven't walked this dep yet, go down into it.
         if (targets_walked->add(dep.ptr)) {
           if (!dep.ptr->GetMetadata(keys_to_extract, keys_to_walk, rebase_dir,
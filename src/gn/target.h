@@ -101,10 +101,16 @@ class Target : public Item {
   // Return true if this target should be generated in the final build graph.
   bool ShouldGenerate() const;
 
+  // Returns the size of the target and of the side structures it allocated,
+  // not counting the contents of their containers. Used by the memory stats.
+  size_t GetLayoutSize() const;
+
   // Will be the empty string to use the target label as the output name.
   // See GetComputedOutputName().
-  const std::string& output_name() const { return output_name_; }
-  void set_output_name(const std::string& name) { output_name_ = name; }
+  const std::string& output_name() const { return rare_values().output_name; }
+  void set_output_name(const std::string& name) {
+    mutable_rare_values().output_name = name;
+  }
 
   // Returns the output name for this target, which is the output_name if
   // specified, or the target label if not.
@@ -121,20 +127,26 @@ class Target : public Item {
   // Desired output directory for the final output. This will be used for
   // the {{output_dir}} substitution in the tool if it is specified. If
   // is_null, the tool default will be used.
-  const SourceDir& output_dir() const { return output_dir_; }
-  void set_output_dir(const SourceDir& dir) { output_dir_ = dir; }
+  const SourceDir& output_dir() const { return rare_values().output_dir; }
+  void set_output_dir(const SourceDir& dir) {
+    mutable_rare_values().output_dir = dir;
+  }
 
   // The output extension is really a tri-state: unset (output_extension_set
   // is false and the string is empty, meaning the default extension should be
   // used), the output extension is set but empty (output should have no
   // extension) and the output extension is set but nonempty (use the given
   // extension).
-  const std::string& output_extension() const { return output_extension_; }
+  const std::string& output_extension() const {
+    return rare_values().output_extension;
+  }
   void set_output_extension(const std::string& extension) {
-    output_extension_ = extension;
-    output_extension_set_ = true;
+    mutable_rare_values().output_extension = extension;
+    mutable_rare_values().output_extension_set = true;
+  }
+  bool output_extension_set() const {
+    return rare_values().output_extension_set;
   }
-  bool output_extension_set() const { return output_extension_set_; }
 
   const FileList& sources() const { return sources_; }
   FileList& sources() { return sources_; }
@@ -151,8 +163,10 @@ class Target : public Item {
 
   // When all_headers_public is false, this is the list of public headers. It
   // could be empty which would mean no headers are public.
-  const FileList& public_headers() const { return public_headers_; }
-  FileList& public_headers() { return public_headers_; }
+  const FileList& public_headers() const {
+    return rare_values().public_headers;
+  }
+  FileList& public_headers() { return mutable_rare_values().public_headers; }
 
   // Whether this target's includes should be checked by "gn check".
   bool check_includes() const { return check_includes_; }
@@ -215,18 +229,18 @@ class Target : public Item {
   }
   std::vector<std::string>& walk_keys() { return generated_file().walk_keys_; }
 
-  OutputFile write_runtime_deps_output() const {
-    return write_runtime_deps_output_;
+  const OutputFile& write_runtime_deps_output() const {
+    return rare_values().write_runtime_deps_output;
   }
   void set_write_runtime_deps_output(const OutputFile& value) {
-    write_runtime_deps_output_ = value;
+    mutable_rare_values().write_runtime_deps_output = value;
   }
 
   // Runtime dependencies. These are "file-like things" that can either be
   // directories or files. They do not need to exist, these are just passed as
   // runtime dependencies to external test systems as necessary.
-  const std::vector<std::string>& data() const { return data_; }
-  std::vector<std::string>& data() { return data_; }
+  const std::vector<std::string>& data() const { return rare_values().data; }
+  std::vector<std::string>& data() { return mutable_rare_values().data; }
 
   // Information about the bundle. Only valid for CREATE_BUNDLE target after
   // they have been resolved.
@@ -289,15 +303,17 @@ class Target : public Item {
 
   // Dependencies that can include files from this target.
   const std::set<Label>& allow_circular_includes_from() const {
-    return allow_circular_includes_from_;
+    return rare_values().allow_circular_includes_from;
   }
   std::set<Label>& allow_circular_includes_from() {
-    return allow_circular_includes_from_;
+    return mutable_rare_values().allow_circular_includes_from;
   }
 
   // Pool option
-  const LabelPtrPair<Pool>& pool() const { return pool_; }
-  void set_pool(LabelPtrPair<Pool> pool) { pool_ = std::move(pool); }
+  const LabelPtrPair<Pool>& pool() const { return rare_values().pool; }
+  void set_pool(LabelPtrPair<Pool> pool) {
+    mutable_rare_values().pool = std::move(pool);
+  }
 
   // This config represents the configuration set directly on this target.
   ConfigValues& config_values();
@@ -321,12 +337,18 @@ class Target : public Item {
   const RustValues& rust_values() const;
   bool has_rust_values() const { return rust_values_.get(); }
 
-  std::vector<LabelPattern>& friends() { return friends_; }
-  const std::vector<LabelPattern>& friends() const { return friends_; }
+  std::vector<LabelPattern>& friends() {
+    return mutable_rare_values().friends;
+  }
+  const std::vector<LabelPattern>& friends() const {
+    return rare_values().friends;
+  }
 
-  std::vector<LabelPattern>& assert_no_deps() { return assert_no_deps_; }
+  std::vector<LabelPattern>& assert_no_deps() {
+    return mutable_rare_values().assert_no_deps;
+  }
   const std::vector<LabelPattern>& assert_no_deps() const {
-    return assert_no_deps_;
+    return rare_values().assert_no_deps;
   }
 
   // The toolchain is only known once this target is resolved (all if its
@@ -407,7 +429,7 @@ class Target : public Item {
 
   // The subset of computed_outputs that are considered runtime outputs.
   const std::vector<OutputFile>& runtime_outputs() const {
-    return runtime_outputs_;
+    return rare_values().runtime_outputs;
   }
 
   // Computes and returns the outputs of this target expressed as SourceFiles.
@@ -482,6 +504,25 @@ class Target : public Item {
   // values are in config_values_.
   bool ResolvePrecompiledHeaders(Err* err);
 
+  // The values that most targets don't set. They're allocated on first
+  // modification, see mutable_rare_values().
+  struct RareValues {
+    std::string output_name;
+    SourceDir output_dir;
+    std::string output_extension;
+    bool output_extension_set = false;
+    FileList public_headers;
+    std::vector<std::string> data;
+    OutputFile write_runtime_deps_output;
+    std::set<Label> allow_circular_includes_from;
+    LabelPtrPair<Pool> pool;
+    std::vector<LabelPattern> friends;
+    std::vector<LabelPattern> assert_no_deps;
+    std::vector<OutputFile> runtime_outputs;
+  };
+  const RareValues& rare_values() const;
+  RareValues& mutable_rare_values();
+
   // Validates the given thing when a target is resolved.
   bool CheckVisibility(Err* err) const;
   bool CheckConfigVisibility(Err* err) const;
@@ -492,21 +533,14 @@ class Target : public Item {
   bool CheckSourceSetLanguages(Err* err) const;
 
   OutputType output_type_ = UNKNOWN;
-  std::string output_name_;
   bool output_prefix_override_ = false;
-  SourceDir output_dir_;
-  std::string output_extension_;
-  bool output_extension_set_ = false;
-
-  FileList sources_;
-  SourceFileTypeSet source_types_used_;
   bool all_headers_public_ = true;
-  FileList public_headers_;
   bool check_includes_ = true;
   bool complete_static_lib_ = false;
-  std::vector<std::string> data_;
+  SourceFileTypeSet source_types_used_;
+
+  FileList sources_;
   std::unique_ptr<BundleData> bundle_data_;
-  OutputFile write_runtime_deps_output_;
 
   LabelTargetVector private_deps_;
   LabelTargetVector public_deps_;
@@ -518,13 +552,6 @@ class Target : public Item {
   UniqueVector<LabelConfigPair> all_dependent_configs_;
   UniqueVector<LabelConfigPair> public_configs_;
 
-  std::set<Label> allow_circular_includes_from_;
-
-  LabelPtrPair<Pool> pool_;
-
-  std::vector<LabelPattern> friends_;
-  std::vector<LabelPattern> assert_no_deps_;
-
   // Used for all binary targets, and for inputs in regular targets. The
   // precompiled header values in this struct will be resolved to the ones to
   // use for this target, if precompiled headers are used.
@@ -547,13 +574,15 @@ class Target : public Item {
   OutputFile link_output_file_;
   OutputFile dependency_output_file_;
   OutputFile dependency_output_alias_;
-  std::vector<OutputFile> runtime_outputs_;
 
   std::unique_ptr<Metadata> metadata_;
 
   // GeneratedFile as metadata collection values.
   std::unique_ptr<GeneratedFile> generated_file_;
 
+  // See RareValues.
+  std::unique_ptr<RareValues> rare_values_;
+
   Target(const Target&) = delete;
   Target& operator=(const Target&) = delete;
 };
@@ -1538,3 +1538,27 @@ TEST_F(TargetTest, ModuleMap) {
   ASSERT_EQ(1u, output.size());
   EXPECT_EQ("input.modulemap.pcm", output[0].value()) << output[0].value();
 }
+
+// The values most targets don't set are only allocated when they're set.
+TEST_F(TargetTest, RareValuesLayout) {
+  TestWithScope setup;
+  Err err;
+
+  TestTarget target(setup, "//a:a", Target::SOURCE_SET);
+  target.sources().push_back(SourceFile("//a/a.cc"));
+  ASSERT_TRUE(target.OnResolved(&err));
+  size_t resolved_size = target.GetLayoutSize();
+  EXPECT_TRUE(target.output_name().empty());
+  EXPECT_TRUE(target.runtime_outputs().empty());
+  EXPECT_EQ(resolved_size, target.GetLayoutSize());
+
+  target.set_output_name("b");
+  EXPECT_EQ("b", target.output_name());
+  EXPECT_LT(resolved_size, target.GetLayoutSize());
+
+  // Executables have runtime outputs, so allocate them when resolved.
+  TestTarget exe(setup, "//a:exe", Target::EXECUTABLE);
+  ASSERT_TRUE(exe.OnResolved(&err));
+  ASSERT_EQ(1u, exe.runtime_outputs().size());
+  EXPECT_EQ("./exe", exe.runtime_outputs()[0].value());
+}
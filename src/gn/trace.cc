@@ -7,7 +7,9 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <vector>
@@ -20,41 +22,142 @@
 #include "base/strings/stringprintf.h"
 #include "gn/filesystem_utils.h"
 #include "gn/label.h"
+#include "util/thread_local_pointer.h"
 
 namespace {
 
 constexpr uint64_t kNanosecondsToMicroseconds = 1'000;
 
+// A trace item along with the index of the thread that recorded it.
+struct ThreadTraceItem {
+  TraceItem item;
+  int thread;
+};
+
+// Each thread's trace buffer grows by chunks, so recording never moves the
+// items already recorded.
+constexpr size_t kChunkSize = 4096;
+
+// The trace items recorded by a single thread. Only the owning thread adds
+// items so no locking is needed. The count is published with release
+// semantics so a thread reading the buffer later sees the items and chunks.
+class TraceBuffer {
+ public:
+  explicit TraceBuffer(int thread) : thread_(thread) {}
+
+  int thread() const { return thread_; }
+
+  void Add(const TraceItem& item) {
+    uint64_t count = count_.load(std::memory_order_relaxed);
+    size_t index = count % kChunkSize;
+    if (index == 0) {
+      Chunk* chunk = new Chunk;
+      if (tail_)
+        tail_->next.store(chunk, std::memory_order_relaxed);
+      else
+        head_ = chunk;
+      tail_ = chunk;
+    }
+    tail_->items[index] = item;
+    count_.store(count + 1, std::memory_order_release);
+  }
+
+  // Drops the recorded items. Must not be called while the owning thread may
+  // be adding items.
+  void Clear() {
+    Chunk* chunk = head_;
+    while (chunk) {
+      Chunk* next = chunk->next.load(std::memory_order_relaxed);
+      delete chunk;
+      chunk = next;
+    }
+    head_ = nullptr;
+    tail_ = nullptr;
+    count_.store(0, std::memory_order_release);
+  }
+
+  // Appends the items of the buffer to |out|, oldest first.
+  void CopyTo(std::vector<ThreadTraceItem>* out) const {
+    uint64_t count = count_.load(std::memory_order_acquire);
+    const Chunk* chunk = head_;
+    for (uint64_t i = 0; i < count; i++) {
+      if (i != 0 && i % kChunkSize == 0)
+        chunk = chunk->next.load(std::memory_order_relaxed);
+      out->push_back({chunk->items[i % kChunkSize], thread_});
+    }
+  }
+
+ private:
+  struct Chunk {
+    TraceItem items[kChunkSize];
+    std::atomic<Chunk*> next{nullptr};
+  };
+
+  const int thread_;
+  std::atomic<uint64_t> count_{0};
+
+  // Chunks are leaked along with the buffer. |head_| is set before the first
+  // count is published.
+  Chunk* head_ = nullptr;
+  Chunk* tail_ = nullptr;
+
+  TraceBuffer(const TraceBuffer&) = delete;
+  TraceBuffer& operator=(const TraceBuffer&) = delete;
+};
+
 class TraceLog {
  public:
-  TraceLog() { events_.reserve(16384); }
-  // Trace items leaked intentionally.
+  TraceLog() = default;
+  // Trace buffers leaked intentionally.
+
+  // Returns the buffer for the current thread, creating it the first time
+  // the thread records a trace.
+  TraceBuffer* GetThreadBuffer() {
+    TraceBuffer*& thread_buffer = ThreadLocalPointer<TraceBuffer>();
+    if (!thread_buffer) {
+      std::lock_guard<std::mutex> lock(lock_);
+      buffers_.push_back(
+          std::make_unique<TraceBuffer>(static_cast<int>(buffers_.size())));
+      thread_buffer = buffers_.back().get();
+    }
+    return thread_buffer;
+  }
+
+  void Add(const TraceItem& item) { GetThreadBuffer()->Add(item); }
 
-  void Add(std::unique_ptr<TraceItem> item) {
+  // Clears the buffers of all threads. The buffers are kept since each one
+  // stays attached to its thread.
+  void Clear() {
     std::lock_guard<std::mutex> lock(lock_);
-    events_.push_back(std::move(item));
+    for (const auto& buffer : buffers_)
+      buffer->Clear();
   }
 
-  // Returns a copy for threadsafety.
-  std::vector<TraceItem*> events() const {
-    std::vector<TraceItem*> events;
+  // Merges the buffers of all threads, sorted by begin time.
+  std::vector<ThreadTraceItem> GetEvents() const {
+    std::vector<ThreadTraceItem> events;
     std::lock_guard<std::mutex> lock(lock_);
-    events.reserve(events_.size());
-    for (const auto& e : events_)
-      events.push_back(e.get());
+    for (const auto& buffer : buffers_)
+      buffer->CopyTo(&events);
+    std::stable_sort(events.begin(), events.end(),
+                     [](const ThreadTraceItem& a, const ThreadTraceItem& b) {
+                       return a.item.begin() < b.item.begin();
+                     });
     return events;
   }
 
  private:
   mutable std::mutex lock_;
 
-  std::vector<std::unique_ptr<TraceItem>> events_;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers_;
 
   TraceLog(const TraceLog&) = delete;
   TraceLog& operator=(const TraceLog&) = delete;
 };
 
+// Kept when tracing is reset for testing, see TraceLog::Clear().
 TraceLog* trace_log = nullptr;
+bool tracing_enabled = false;
 
 struct Coalesced {
   Coalesced() : name_ptr(nullptr), total_duration(0.0), count(0) {}
@@ -119,26 +222,24 @@ void SummarizeScriptExecs(std::vector<const TraceItem*>& execs,
 
 }  // namespace
 
-TraceItem::TraceItem(Type type,
-                     const std::string& name,
-                     std::thread::id thread_id)
-    : type_(type), name_(name), thread_id_(thread_id) {}
+TraceItem::TraceItem() = default;
 
-TraceItem::~TraceItem() = default;
+TraceItem::TraceItem(Type type, std::string_view name)
+    : type_(type), name_(name) {}
 
-ScopedTrace::ScopedTrace(TraceItem::Type t, const std::string& name)
-    : done_(false) {
-  if (trace_log) {
-    item_ = std::make_unique<TraceItem>(t, name, std::this_thread::get_id());
-    item_->set_begin(TicksNow());
+ScopedTrace::ScopedTrace(TraceItem::Type t, std::string_view name)
+    : active_(tracing_enabled), done_(false) {
+  if (active_) {
+    item_ = TraceItem(t, name);
+    item_.set_begin(TicksNow());
   }
 }
 
-ScopedTrace::ScopedTrace(TraceItem::Type t, const Label& label) : done_(false) {
-  if (trace_log) {
-    item_ = std::make_unique<TraceItem>(t, label.GetUserVisibleName(false),
-                                        std::this_thread::get_id());
-    item_->set_begin(TicksNow());
+ScopedTrace::ScopedTrace(TraceItem::Type t, const Label& label)
+    : active_(tracing_enabled), done_(false) {
+  if (active_) {
+    item_ = TraceItem(t, label.GetUserVisibleName(false));
+    item_.set_begin(TicksNow());
   }
 }
 
@@ -147,21 +248,21 @@ ScopedTrace::~ScopedTrace() {
 }
 
 void ScopedTrace::SetToolchain(const Label& label) {
-  if (item_)
-    item_->set_toolchain(label.GetUserVisibleName(false));
+  if (active_)
+    item_.set_toolchain(label.GetUserVisibleName(false));
 }
 
 void ScopedTrace::SetCommandLine(const base::CommandLine& cmdline) {
-  if (item_)
-    item_->set_cmdline(FilePathToUTF8(cmdline.GetArgumentsString()));
+  if (active_)
+    item_.set_cmdline(FilePathToUTF8(cmdline.GetArgumentsString()));
 }
 
 void ScopedTrace::Done() {
   if (!done_) {
     done_ = true;
-    if (trace_log) {
-      item_->set_end(TicksNow());
-      AddTrace(std::move(item_));
+    if (active_) {
+      item_.set_end(TicksNow());
+      AddTrace(item_);
     }
   }
 }
@@ -169,21 +270,28 @@ void ScopedTrace::Done() {
 void EnableTracing() {
   if (!trace_log)
     trace_log = new TraceLog;
+  tracing_enabled = true;
 }
 
 bool TracingEnabled() {
-  return !!trace_log;
+  return tracing_enabled;
+}
+
+void ResetTracingForTesting() {
+  tracing_enabled = false;
+  if (trace_log)
+    trace_log->Clear();
 }
 
-void AddTrace(std::unique_ptr<TraceItem> item) {
-  trace_log->Add(std::move(item));
+void AddTrace(const TraceItem& item) {
+  trace_log->Add(item);
 }
 
 std::string SummarizeTraces() {
-  if (!trace_log)
+  if (!tracing_enabled)
     return std::string();
 
-  std::vector<TraceItem*> events = trace_log->events();
+  std::vector<ThreadTraceItem> events = trace_log->GetEvents();
 
   // Classify all events.
   std::vector<const TraceItem*> parses;
@@ -191,7 +299,8 @@ std::string SummarizeTraces() {
   std::vector<const TraceItem*> script_execs;
   std::vector<const TraceItem*> check_headers;
   int headers_checked = 0;
-  for (auto* event : events) {
+  for (const auto& thread_event : events) {
+    const TraceItem* event = &thread_event.item;
     switch (event->type()) {
       case TraceItem::TRACE_FILE_PARSE:
         parses.push_back(event);
@@ -254,27 +363,22 @@ void SaveTraces(const base::FilePath& file_name) {
 
   std::string quote_buffer;  // Allocate outside loop to prevent reallocationg.
 
-  // Trace viewer doesn't handle integer > 2^53 well, so re-numbering them to
-  // small numbers.
-  std::map<std::thread::id, int> tidmap;
-  std::vector<TraceItem*> events = trace_log->events();
-  for (const auto* item : events) {
-    int id = tidmap.size();
-    tidmap.emplace(item->thread_id(), id);
-  }
+  // Threads are identified by the small index of their trace buffer.
+  std::vector<ThreadTraceItem> events = trace_log->GetEvents();
 
   // Write main thread metadata (assume this is being written on the main
   // thread).
-  out << "{\"pid\":0,\"tid\":\"" << tidmap[std::this_thread::get_id()] << "\"";
+  out << "{\"pid\":0,\"tid\":\"" << trace_log->GetThreadBuffer()->thread()
+      << "\"";
   out << ",\"ts\":0,\"ph\":\"M\",";
   out << "\"name\":\"thread_name\",\"args\":{\"name\":\"Main thread\"}},";
 
   for (size_t i = 0; i < events.size(); i++) {
-    const TraceItem& item = *events[i];
+    const TraceItem& item = events[i].item;
 
     if (i != 0)
       out << ",";
-    out << "{\"pid\":0,\"tid\":\"" << tidmap[item.thread_id()] << "\"";
+    out << "{\"pid\":0,\"tid\":\"" << events[i].thread << "\"";
     out << ",\"ts\":" << item.begin() / kNanosecondsToMicroseconds;
     out << ",\"ph\":\"X\"";  // "X" = complete event with begin & duration.
     out << ",\"dur\":" << item.delta().InMicroseconds();
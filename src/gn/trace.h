@@ -5,9 +5,8 @@
 #ifndef TOOLS_GN_TRACE_H_
 #define TOOLS_GN_TRACE_H_
 
-#include <memory>
 #include <string>
-#include <thread>
+#include <string_view>
 
 #include "util/ticks.h"
 
@@ -39,12 +38,12 @@ class TraceItem {
     TRACE_WALK_METADATA,
   };
 
-  TraceItem(Type type, const std::string& name, std::thread::id thread_id);
-  ~TraceItem();
+  // Trace items are stored by value in the per-thread trace buffers.
+  TraceItem();
+  TraceItem(Type type, std::string_view name);
 
   Type type() const { return type_; }
   const std::string& name() const { return name_; }
-  std::thread::id thread_id() const { return thread_id_; }
 
   Ticks begin() const { return begin_; }
   void set_begin(Ticks b) { begin_ = b; }
@@ -55,19 +54,18 @@ class TraceItem {
 
   // Optional toolchain label.
   const std::string& toolchain() const { return toolchain_; }
-  void set_toolchain(const std::string& t) { toolchain_ = t; }
+  void set_toolchain(std::string_view t) { toolchain_ = t; }
 
   // Optional command line.
   const std::string& cmdline() const { return cmdline_; }
-  void set_cmdline(const std::string& c) { cmdline_ = c; }
+  void set_cmdline(std::string_view c) { cmdline_ = c; }
 
  private:
-  Type type_;
+  Type type_ = TRACE_SETUP;
   std::string name_;
-  std::thread::id thread_id_;
 
-  Ticks begin_;
-  Ticks end_;
+  Ticks begin_ = 0;
+  Ticks end_ = 0;
 
   std::string toolchain_;
   std::string cmdline_;
@@ -75,7 +73,7 @@ class TraceItem {
 
 class ScopedTrace {
  public:
-  ScopedTrace(TraceItem::Type t, const std::string& name);
+  ScopedTrace(TraceItem::Type t, std::string_view name);
   ScopedTrace(TraceItem::Type t, const Label& label);
   ~ScopedTrace();
 
@@ -85,7 +83,8 @@ class ScopedTrace {
   void Done();
 
  private:
-  std::unique_ptr<TraceItem> item_;
+  TraceItem item_;
+  bool active_;
   bool done_;
 };
 
@@ -95,11 +94,19 @@ void EnableTracing();
 // Returns whether tracing is enabled.
 bool TracingEnabled();
 
-// Adds a trace event to the log.
-void AddTrace(std::unique_ptr<TraceItem> item);
+// Turns tracing off and clears the recorded traces. Must not be called while
+// other threads may be adding traces.
+void ResetTracingForTesting();
+
+// Adds a trace event to the log. Each thread records into its own buffer
+// without locking.
+void AddTrace(const TraceItem& item);
 
 // Returns a summary of the current traces, or the empty string if tracing is
 // not enabled.
+//
+// This and SaveTraces() merge the buffers of all threads, so they must not be
+// called while other threads may still be adding traces.
 std::string SummarizeTraces();
 
 // Saves the current traces to the given filename in JSON format.
@@ -0,0 +1,104 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/trace.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "util/test/test.h"
+
+namespace {
+
+size_t CountOccurrences(const std::string& str, const std::string& substr) {
+  size_t count = 0;
+  for (size_t pos = str.find(substr); pos != std::string::npos;
+       pos = str.find(substr, pos + substr.size()))
+    count++;
+  return count;
+}
+
+class TraceTest : public testing::Test {
+ public:
+  void SetUp() override { EnableTracing(); }
+  void TearDown() override { ResetTracingForTesting(); }
+};
+
+}  // namespace
+
+TEST_F(TraceTest, MergesThreads) {
+  constexpr int kThreads = 4;
+  constexpr int kItems = 100;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < kItems; i++) {
+        ScopedTrace trace(TraceItem::TRACE_SETUP,
+                          "TraceTest" + std::to_string(t));
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath file_path = temp_dir.GetPath().AppendASCII("trace.json");
+  SaveTraces(file_path);
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(file_path, &contents));
+  for (int t = 0; t < kThreads; t++) {
+    EXPECT_EQ(static_cast<size_t>(kItems),
+              CountOccurrences(contents, "\"name\":\"TraceTest" +
+                                             std::to_string(t) + "\""));
+  }
+}
+
+// A thread recording many events keeps all of them.
+TEST_F(TraceTest, KeepsAllEvents) {
+  constexpr int kItems = 70000;
+  std::thread thread([]() {
+    TraceItem item(TraceItem::TRACE_SETUP, "TraceTestMany");
+    for (int i = 0; i < kItems; i++)
+      AddTrace(item);
+  });
+  thread.join();
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath file_path = temp_dir.GetPath().AppendASCII("trace.json");
+  SaveTraces(file_path);
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(file_path, &contents));
+  EXPECT_EQ(static_cast<size_t>(kItems),
+            CountOccurrences(contents, "\"name\":\"TraceTestMany\""));
+}
+
+TEST_F(TraceTest, Reset) {
+  AddTrace(TraceItem(TraceItem::TRACE_SETUP, "TraceTestReset"));
+  ResetTracingForTesting();
+  EXPECT_FALSE(TracingEnabled());
+  EXPECT_EQ(std::string(), SummarizeTraces());
+
+  // Traces recorded before the reset are gone once tracing is back on.
+  EnableTracing();
+  { ScopedTrace trace(TraceItem::TRACE_SETUP, "TraceTestAfterReset"); }
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath file_path = temp_dir.GetPath().AppendASCII("trace.json");
+  SaveTraces(file_path);
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(file_path, &contents));
+  EXPECT_EQ(0u, CountOccurrences(contents, "\"name\":\"TraceTestReset\""));
+  EXPECT_EQ(1u,
+            CountOccurrences(contents, "\"name\":\"TraceTestAfterReset\""));
+}
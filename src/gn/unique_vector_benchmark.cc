@@ -0,0 +1,94 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "gn/label.h"
+#include "gn/source_dir.h"
+#include "gn/unique_vector.h"
+#include "util/test/benchmark.h"
+
+namespace {
+
+// Labels of |count| targets spread over directories of ten.
+std::vector<Label> MakeLabels(size_t count) {
+  std::vector<Label> labels;
+  for (size_t i = 0; i < count; i++) {
+    labels.emplace_back(
+        SourceDir("//components/module" + std::to_string(i / 10) + "/"),
+        "target" + std::to_string(i % 10));
+  }
+  return labels;
+}
+
+// Appends every label twice, as happens when the configs or dependencies of
+// several targets are merged and most are shared.
+void RunPushBack(benchmark::State& state, size_t count) {
+  std::vector<Label> labels = MakeLabels(count);
+  while (state.KeepRunning()) {
+    UniqueVector<Label> vector;
+    for (const Label& label : labels)
+      vector.push_back(label);
+    for (const Label& label : labels)
+      vector.push_back(label);
+    benchmark::DoNotOptimize(vector.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+
+void RunIndexOf(benchmark::State& state, size_t count) {
+  std::vector<Label> labels = MakeLabels(count * 2);
+  UniqueVector<Label> vector;
+  vector.Append(labels.begin(), labels.begin() + count);
+  while (state.KeepRunning()) {
+    size_t found = 0;
+    for (const Label& label : labels)
+      found += vector.IndexOf(label) != UniqueVector<Label>::kIndexNone;
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+
+void RunIterate(benchmark::State& state, size_t count) {
+  UniqueVector<Label> vector;
+  vector.Append(MakeLabels(count));
+  while (state.KeepRunning()) {
+    size_t hash = 0;
+    for (const Label& label : vector)
+      hash += label.hash();
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+}  // namespace
+
+BENCHMARK(UniqueVector_PushBack_16) {
+  RunPushBack(state, 16);
+}
+
+BENCHMARK(UniqueVector_PushBack_1000) {
+  RunPushBack(state, 1000);
+}
+
+BENCHMARK(UniqueVector_PushBack_100000) {
+  RunPushBack(state, 100000);
+}
+
+BENCHMARK(UniqueVector_IndexOf_16) {
+  RunIndexOf(state, 16);
+}
+
+BENCHMARK(UniqueVector_IndexOf_1000) {
+  RunIndexOf(state, 1000);
+}
+
+BENCHMARK(UniqueVector_IndexOf_100000) {
+  RunIndexOf(state, 100000);
+}
+
+BENCHMARK(UniqueVector_Iterate_100000) {
+  RunIterate(state, 100000);
+}
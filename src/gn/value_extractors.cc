@@ -183,8 +183,9 @@ struct LabelPtrResolver {
   bool operator()(const Value& v, LabelPtrPair<T>* out, Err* err) const {
     if (!v.VerifyTypeIs(Value::STRING, err))
       return false;
-    out->label = Label::Resolve(current_dir, build_settings->root_path_utf8(),
-                                current_toolchain, v, err);
+    out->label =
+        LabelId(Label::Resolve(current_dir, build_settings->root_path_utf8(),
+                               current_toolchain, v, err));
     out->origin = v.origin();
     return !err->has_error();
   }
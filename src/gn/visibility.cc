@@ -25,7 +25,7 @@ bool Visibility::Set(const SourceDir& current_dir,
                      std::string_view source_root,
                      const Value& value,
                      Err* err) {
-  patterns_.clear();
+  patterns_.Clear();
 
   if (!value.VerifyTypeIs(Value::LIST, err)) {
     CHECK(err->has_error());
@@ -33,7 +33,7 @@ bool Visibility::Set(const SourceDir& current_dir,
   }
 
   for (const auto& item : value.list_value()) {
-    patterns_.push_back(
+    patterns_.Add(
         LabelPattern::GetPattern(current_dir, source_root, item, err));
     if (err->has_error())
       return false;
@@ -42,19 +42,19 @@ bool Visibility::Set(const SourceDir& current_dir,
 }
 
 void Visibility::SetPublic() {
-  patterns_.clear();
-  patterns_.push_back(LabelPattern(LabelPattern::RECURSIVE_DIRECTORY,
-                                   SourceDir(), std::string(), Label()));
+  patterns_.Clear();
+  patterns_.Add(LabelPattern(LabelPattern::RECURSIVE_DIRECTORY, SourceDir(),
+                             std::string(), Label()));
 }
 
 void Visibility::SetPrivate(const SourceDir& current_dir) {
-  patterns_.clear();
-  patterns_.push_back(LabelPattern(LabelPattern::DIRECTORY, current_dir,
-                                   std::string(), Label()));
+  patterns_.Clear();
+  patterns_.Add(LabelPattern(LabelPattern::DIRECTORY, current_dir,
+                             std::string(), Label()));
 }
 
 bool Visibility::CanSeeMe(const Label& label) const {
-  return LabelPattern::VectorMatches(patterns_, label);
+  return patterns_.Matches(label);
 }
 
 std::string Visibility::Describe(int indent, bool include_brackets) const {
@@ -72,7 +72,7 @@ std::string Visibility::Describe(int indent, bool include_brackets) const {
     inner_indent_string += "  ";
   }
 
-  for (const auto& pattern : patterns_)
+  for (const auto& pattern : patterns_.patterns())
     result += inner_indent_string + pattern.Describe() + "\n";
 
   if (include_brackets)
@@ -82,7 +82,7 @@ std::string Visibility::Describe(int indent, bool include_brackets) const {
 
 std::unique_ptr<base::Value> Visibility::AsValue() const {
   auto res = std::make_unique<base::ListValue>();
-  for (const auto& pattern : patterns_)
+  for (const auto& pattern : patterns_.patterns())
     res->AppendString(pattern.Describe());
   return res;
 }
@@ -9,7 +9,7 @@
 #include <string_view>
 #include <vector>
 
-#include "gn/label_pattern.h"
+#include "gn/label_pattern_set.h"
 #include "gn/source_dir.h"
 
 namespace base {
@@ -63,7 +63,7 @@ class Visibility {
   static bool FillItemVisibility(Item* item, Scope* scope, Err* err);
 
  private:
-  std::vector<LabelPattern> patterns_;
+  LabelPatternSet patterns_;
 
   Visibility(const Visibility&) = delete;
   Visibility& operator=(const Visibility&) = delete;
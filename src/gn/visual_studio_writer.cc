@@ -30,6 +30,7 @@
 #include "gn/variables.h"
 #include "gn/visual_studio_utils.h"
 #include "gn/xml_element_writer.h"
+#include "util/worker_pool.h"
 
 #if defined(OS_WIN)
 #include "base/win/registry.h"
@@ -363,6 +364,7 @@ bool VisualStudioWriter::RunAndWriteFiles(const BuildSettings* build_settings,
   writer.projects_.reserve(targets.size());
   writer.folders_.reserve(targets.size());
 
+  std::vector<const Target*> project_targets;
   for (const Target* target : targets) {
     // Skip actions and bundle targets.
     if (target->output_type() == Target::ACTION ||
@@ -374,9 +376,34 @@ bool VisualStudioWriter::RunAndWriteFiles(const BuildSettings* build_settings,
       continue;
     }
 
-    if (!writer.WriteProjectFiles(target, ninja_extra_args, ninja_executable,
-                                  err))
+    if (!writer.AddProject(target, err))
       return false;
+    project_targets.push_back(target);
+  }
+
+  // Generating and writing the project files of each target is independent,
+  // so do it in parallel. Each task only touches its own project and error
+  // slot.
+  std::vector<Err> errors(project_targets.size());
+  {
+    WorkerPool pool;
+    for (size_t i = 0; i < project_targets.size(); ++i) {
+      pool.PostTask([&writer, &project_targets, &errors, &ninja_extra_args,
+                     &ninja_executable, i]() {
+        writer.WriteProjectFiles(project_targets[i], writer.projects_[i].get(),
+                                 ninja_extra_args, ninja_executable,
+                                 &errors[i]);
+      });
+    }
+    // The pool destructor waits for all posted tasks to complete.
+  }
+
+  // Report the first error in target order so the failure is deterministic.
+  for (const Err& project_err : errors) {
+    if (project_err.has_error()) {
+      *err = project_err;
+      return false;
+    }
   }
 
   if (writer.projects_.empty()) {
@@ -396,10 +423,7 @@ bool VisualStudioWriter::RunAndWriteFiles(const BuildSettings* build_settings,
   return writer.WriteSolutionFile(sln_name, err);
 }
 
-bool VisualStudioWriter::WriteProjectFiles(const Target* target,
-                                           const std::string& ninja_extra_args,
-                                           const std::string& ninja_executable,
-                                           Err* err) {
+bool VisualStudioWriter::AddProject(const Target* target, Err* err) {
   std::string project_name = target->label().name();
   const char* project_config_platform = config_platform_;
   if (!target->settings()->is_default()) {
@@ -418,32 +442,41 @@ bool VisualStudioWriter::WriteProjectFiles(const Target* target,
   if (target_file.is_null())
     return false;
 
-  base::FilePath vcxproj_path = build_settings_->GetFullPath(target_file);
-  std::string vcxproj_path_str = FilePathToUTF8(vcxproj_path);
-
+  // The GUID is filled in by WriteProjectFiles() since it's comparatively
+  // expensive to compute.
   projects_.push_back(std::make_unique<SolutionProject>(
-      project_name, vcxproj_path_str,
-      MakeGuid(vcxproj_path_str, kGuidSeedProject),
+      project_name, FilePathToUTF8(build_settings_->GetFullPath(target_file)),
+      std::string(),
       FilePathToUTF8(build_settings_->GetFullPath(target->label().dir())),
       project_config_platform));
+  return true;
+}
+
+bool VisualStudioWriter::WriteProjectFiles(const Target* target,
+                                           SolutionProject* solution_project,
+                                           const std::string& ninja_extra_args,
+                                           const std::string& ninja_executable,
+                                           Err* err) const {
+  solution_project->guid = MakeGuid(solution_project->path, kGuidSeedProject);
 
   StringOutputBuffer vcxproj_storage;
   std::ostream vcxproj_string_out(&vcxproj_storage);
   SourceFileCompileTypePairs source_types;
-  if (!WriteProjectFileContents(vcxproj_string_out, *projects_.back(), target,
+  if (!WriteProjectFileContents(vcxproj_string_out, *solution_project, target,
                                 ninja_extra_args, ninja_executable,
                                 &source_types, err)) {
-    projects_.pop_back();
     return false;
   }
 
   // Only write the content to the file if it's different. That is
   // both a performance optimization and more importantly, prevents
   // Visual Studio from reloading the projects.
+  base::FilePath vcxproj_path = UTF8ToFilePath(solution_project->path);
   if (!vcxproj_storage.WriteToFileIfChanged(vcxproj_path, err))
     return false;
 
-  base::FilePath filters_path = UTF8ToFilePath(vcxproj_path_str + ".filters");
+  base::FilePath filters_path =
+      UTF8ToFilePath(solution_project->path + ".filters");
 
   StringOutputBuffer filters_storage;
   std::ostream filters_string_out(&filters_storage);
@@ -458,7 +491,7 @@ bool VisualStudioWriter::WriteProjectFileContents(
     const std::string& ninja_extra_args,
     const std::string& ninja_executable,
     SourceFileCompileTypePairs* source_types,
-    Err* err) {
+    Err* err) const {
   PathOutput path_output(
       GetBuildDirForTargetAsSourceDir(target, BuildDirType::OBJ),
       build_settings_->root_path_utf8(), EscapingMode::ESCAPE_NONE);
@@ -687,14 +720,15 @@ bool VisualStudioWriter::WriteProjectFileContents(
 void VisualStudioWriter::WriteFiltersFileContents(
     std::ostream& out,
     const Target* target,
-    const SourceFileCompileTypePairs& source_types) {
+    const SourceFileCompileTypePairs& source_types) const {
   out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << std::endl;
   XmlElementWriter project(
       out, "Project",
       XmlAttributes("ToolsVersion", "4.0")
           .add("xmlns", "http://schemas.microsoft.com/developer/msbuild/2003"));
 
-  std::ostringstream files_out;
+  StringOutputBuffer files_storage;
+  std::ostream files_out(&files_storage);
 
   {
     std::unique_ptr<XmlElementWriter> filters_group =
@@ -742,7 +776,7 @@ void VisualStudioWriter::WriteFiltersFileContents(
     }
   }
 
-  project.Text(files_out.str());
+  project.Text(files_storage.str());
 }
 
 bool VisualStudioWriter::WriteSolutionFile(const std::string& sln_name,
@@ -928,7 +962,7 @@ void VisualStudioWriter::ResolveSolutionFolders() {
 }
 
 std::pair<std::string, bool> VisualStudioWriter::GetNinjaTarget(
-    const Target* target) {
+    const Target* target) const {
   std::ostringstream ninja_target_out;
   bool is_phony = false;
   OutputFile output_file;
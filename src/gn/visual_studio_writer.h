@@ -109,20 +109,29 @@ class VisualStudioWriter {
                      const std::string& win_kit);
   ~VisualStudioWriter();
 
+  // Appends the solution project for |target| to |projects_|. The project GUID
+  // is left empty until WriteProjectFiles() is called.
+  bool AddProject(const Target* target, Err* err);
+
+  // Computes the GUID of |solution_project| and writes its .vcxproj and
+  // .filters files. Doesn't touch any other writer state, so it may be called
+  // from several threads at once for different projects.
   bool WriteProjectFiles(const Target* target,
+                         SolutionProject* solution_project,
                          const std::string& ninja_extra_args,
                          const std::string& ninja_executable,
-                         Err* err);
+                         Err* err) const;
   bool WriteProjectFileContents(std::ostream& out,
                                 const SolutionProject& solution_project,
                                 const Target* target,
                                 const std::string& ninja_extra_args,
                                 const std::string& ninja_executable,
                                 SourceFileCompileTypePairs* source_types,
-                                Err* err);
-  void WriteFiltersFileContents(std::ostream& out,
-                                const Target* target,
-                                const SourceFileCompileTypePairs& source_types);
+                                Err* err) const;
+  void WriteFiltersFileContents(
+      std::ostream& out,
+      const Target* target,
+      const SourceFileCompileTypePairs& source_types) const;
   bool WriteSolutionFile(const std::string& sln_name, Err* err);
   void WriteSolutionFileContents(std::ostream& out,
                                  const base::FilePath& solution_dir_path);
@@ -132,7 +141,7 @@ class VisualStudioWriter {
   void ResolveSolutionFolders();
 
   // Returns the ninja target string and whether the target is phony.
-  std::pair<std::string, bool> GetNinjaTarget(const Target* target);
+  std::pair<std::string, bool> GetNinjaTarget(const Target* target) const;
 
   const BuildSettings* build_settings_;
 
@@ -7,10 +7,11 @@
 #include <iomanip>
 #include <iterator>
 #include <memory>
-#include <sstream>
+#include <ostream>
 #include <utility>
 
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "gn/filesystem_utils.h"
 
@@ -34,7 +35,7 @@ bool CharNeedEscaping(char c) {
   return true;
 }
 
-bool StringNeedEscaping(const std::string& string) {
+bool StringNeedEscaping(std::string_view string) {
   if (string.empty())
     return true;
   if (string.find("___") != std::string::npos)
@@ -47,47 +48,50 @@ bool StringNeedEscaping(const std::string& string) {
   return false;
 }
 
-std::string EncodeString(const std::string& string) {
-  if (!StringNeedEscaping(string))
-    return string;
+void WriteEncodedString(std::ostream& out, std::string_view string) {
+  if (!StringNeedEscaping(string)) {
+    out << string;
+    return;
+  }
 
-  std::stringstream buffer;
-  buffer << '"';
+  out << '"';
   for (char c : string) {
     if (c <= 31) {
       switch (c) {
         case '\a':
-          buffer << "\\a";
+          out << "\\a";
           break;
         case '\b':
-          buffer << "\\b";
+          out << "\\b";
           break;
         case '\t':
-          buffer << "\\t";
+          out << "\\t";
           break;
         case '\n':
         case '\r':
-          buffer << "\\n";
+          out << "\\n";
           break;
         case '\v':
-          buffer << "\\v";
+          out << "\\v";
           break;
         case '\f':
-          buffer << "\\f";
+          out << "\\f";
           break;
-        default:
-          buffer << std::hex << std::setw(4) << std::left << "\\U"
-                 << static_cast<unsigned>(c);
+        default: {
+          std::ios_base::fmtflags flags = out.flags();
+          out << std::hex << std::setw(4) << std::left << "\\U"
+              << static_cast<unsigned>(c);
+          out.flags(flags);
           break;
+        }
       }
     } else {
       if (c == '"' || c == '\\')
-        buffer << '\\';
-      buffer << c;
+        out << '\\';
+      out << c;
     }
   }
-  buffer << '"';
-  return buffer.str();
+  out << '"';
 }
 
 struct SourceTypeForExt {
@@ -176,13 +180,13 @@ void PrintValue(std::ostream& out, IndentRules rules, unsigned value) {
 }
 
 void PrintValue(std::ostream& out, IndentRules rules, const char* value) {
-  out << EncodeString(value);
+  WriteEncodedString(out, value);
 }
 
 void PrintValue(std::ostream& out,
                 IndentRules rules,
                 const std::string& value) {
-  out << EncodeString(value);
+  WriteEncodedString(out, value);
 }
 
 void PrintValue(std::ostream& out, IndentRules rules, const NoReference& obj) {
@@ -190,7 +194,7 @@ void PrintValue(std::ostream& out, IndentRules rules, const NoReference& obj) {
 }
 
 void PrintValue(std::ostream& out, IndentRules rules, const PBXObject* value) {
-  out << value->Reference();
+  value->WriteReference(out);
 }
 
 template <typename ObjectClass>
@@ -316,6 +320,85 @@ const char* ToString(PBXObjectClass cls) {
   return nullptr;
 }
 
+// PBXObjectIdGenerator -------------------------------------------------------
+
+namespace {
+
+// FNV-1a offset bases for the two lanes. The second one is the 64-bit FNV
+// offset basis with its halves swapped so the lanes are independent.
+constexpr uint64_t kIdLaneBasis[2] = {0xcbf29ce484222325ull,
+                                      0x84222325cbf29ce4ull};
+constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+
+void HashBytes(uint64_t state[2], std::string_view bytes) {
+  for (unsigned char c : bytes) {
+    state[0] = (state[0] ^ c) * kFnvPrime;
+    state[1] = (state[1] ^ c) * kFnvPrime;
+  }
+}
+
+// Final avalanche step of MurmurHash3, spreads FNV's weak low-bit mixing.
+uint64_t MixBits(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+}  // namespace
+
+PBXObjectIdGenerator::PBXObjectIdGenerator(std::string_view seed)
+    : seed_state_{kIdLaneBasis[0], kIdLaneBasis[1]} {
+  HashBytes(seed_state_, seed);
+}
+
+std::string PBXObjectIdGenerator::Generate(std::string_view name,
+                                           uint64_t counter) const {
+  uint64_t state[2] = {seed_state_[0], seed_state_[1]};
+  HashBytes(state, " ");
+  HashBytes(state, name);
+  HashBytes(state, " ");
+
+  // Hash the counter bytes in a fixed order to be independent of the host
+  // endianness.
+  char counter_bytes[8];
+  for (size_t i = 0; i < sizeof(counter_bytes); ++i)
+    counter_bytes[i] = static_cast<char>(counter >> (8 * i));
+  HashBytes(state, std::string_view(counter_bytes, sizeof(counter_bytes)));
+
+  const uint64_t lanes[2] = {MixBits(state[0]), MixBits(state[1])};
+  uint8_t id[12];
+  for (size_t i = 0; i < 8; ++i)
+    id[i] = static_cast<uint8_t>(lanes[0] >> (56 - 8 * i));
+  for (size_t i = 0; i < 4; ++i)
+    id[8 + i] = static_cast<uint8_t>(lanes[1] >> (56 - 8 * i));
+  return base::HexEncode(id, sizeof(id));
+}
+
+namespace {
+
+class AssignIdsVisitor : public PBXObjectVisitor {
+ public:
+  explicit AssignIdsVisitor(std::string_view seed) : generator_(seed) {}
+
+  void Visit(PBXObject* object) override {
+    object->SetId(generator_.Generate(object->Name(), counter_++));
+  }
+
+ private:
+  PBXObjectIdGenerator generator_;
+  uint64_t counter_ = 0;
+};
+
+}  // namespace
+
+void AssignPBXObjectIds(PBXProject* project) {
+  AssignIdsVisitor visitor(project->Name());
+  project->Visit(visitor);
+}
+
 // PBXObjectVisitor -----------------------------------------------------------
 
 PBXObjectVisitor::PBXObjectVisitor() = default;
@@ -348,6 +431,13 @@ std::string PBXObject::Reference() const {
   return id_ + " /* " + comment + " */";
 }
 
+void PBXObject::WriteReference(std::ostream& out) const {
+  out << id_;
+  std::string comment = Comment();
+  if (!comment.empty())
+    out << " /* " << comment << " */";
+}
+
 std::string PBXObject::Comment() const {
   return Name();
 }
@@ -446,7 +536,9 @@ PBXObjectClass PBXAggregateTarget::Class() const {
 void PBXAggregateTarget::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "buildConfigurationList", configurations_);
   PrintProperty(out, rules, "buildPhases", build_phases_);
@@ -478,7 +570,9 @@ std::string PBXBuildFile::Name() const {
 void PBXBuildFile::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {true, 0};
-  out << indent_str << Reference() << " = {";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "fileRef", file_reference_);
   out << "};\n";
@@ -502,7 +596,9 @@ std::string PBXContainerItemProxy::Name() const {
 void PBXContainerItemProxy::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "containerPortal", project_);
   PrintProperty(out, rules, "proxyType", 1u);
@@ -535,7 +631,9 @@ std::string PBXFileReference::Comment() const {
 void PBXFileReference::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {true, 0};
-  out << indent_str << Reference() << " = {";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {";
   PrintProperty(out, rules, "isa", ToString(Class()));
 
   if (!type_.empty()) {
@@ -575,7 +673,9 @@ std::string PBXFrameworksBuildPhase::Name() const {
 void PBXFrameworksBuildPhase::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "buildActionMask", 0x7fffffffu);
   PrintProperty(out, rules, "files", files_);
@@ -666,7 +766,9 @@ void PBXGroup::Visit(PBXObjectVisitorConst& visitor) const {
 void PBXGroup::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "children", children_);
   if (!name_.empty() && name_ != path_)
@@ -758,7 +860,9 @@ PBXObjectClass PBXNativeTarget::Class() const {
 void PBXNativeTarget::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "buildConfigurationList", configurations_);
   PrintProperty(out, rules, "buildPhases", build_phases_);
@@ -927,7 +1031,9 @@ void PBXProject::Visit(PBXObjectVisitorConst& visitor) const {
 void PBXProject::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "attributes", attributes_);
   PrintProperty(out, rules, "buildConfigurationList", configurations_);
@@ -961,7 +1067,9 @@ std::string PBXResourcesBuildPhase::Name() const {
 void PBXResourcesBuildPhase::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "buildActionMask", 0x7fffffffu);
   PrintProperty(out, rules, "files", files_);
@@ -990,7 +1098,9 @@ std::string PBXShellScriptBuildPhase::Name() const {
 void PBXShellScriptBuildPhase::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "alwaysOutOfDate", 1u);
   PrintProperty(out, rules, "buildActionMask", 0x7fffffffu);
@@ -1022,7 +1132,9 @@ std::string PBXSourcesBuildPhase::Name() const {
 void PBXSourcesBuildPhase::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "buildActionMask", 0x7fffffffu);
   PrintProperty(out, rules, "files", files_);
@@ -1058,7 +1170,9 @@ void PBXTargetDependency::Visit(PBXObjectVisitorConst& visitor) const {
 void PBXTargetDependency::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "target", target_);
   PrintProperty(out, rules, "targetProxy", container_item_proxy_);
@@ -1084,7 +1198,9 @@ std::string XCBuildConfiguration::Name() const {
 void XCBuildConfiguration::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "buildSettings", attributes_);
   PrintProperty(out, rules, "name", name_);
@@ -1112,11 +1228,12 @@ PBXObjectClass XCConfigurationList::Class() const {
 }
 
 std::string XCConfigurationList::Name() const {
-  std::stringstream buffer;
-  buffer << "Build configuration list for "
-         << ToString(owner_reference_->Class()) << " \""
-         << owner_reference_->Name() << "\"";
-  return buffer.str();
+  std::string name = "Build configuration list for ";
+  name.append(ToString(owner_reference_->Class()));
+  name.append(" \"");
+  name.append(owner_reference_->Name());
+  name.append("\"");
+  return name;
 }
 
 void XCConfigurationList::Visit(PBXObjectVisitor& visitor) {
@@ -1136,7 +1253,9 @@ void XCConfigurationList::Visit(PBXObjectVisitorConst& visitor) const {
 void XCConfigurationList::Print(std::ostream& out, unsigned indent) const {
   const std::string indent_str(indent, '\t');
   const IndentRules rules = {false, indent + 1};
-  out << indent_str << Reference() << " = {\n";
+  out << indent_str;
+  WriteReference(out);
+  out << " = {\n";
   PrintProperty(out, rules, "isa", ToString(Class()));
   PrintProperty(out, rules, "buildConfigurations", configurations_);
   PrintProperty(out, rules, "defaultConfigurationIsVisible", 0u);
@@ -5,10 +5,13 @@
 #ifndef TOOLS_GN_XCODE_OBJECT_H_
 #define TOOLS_GN_XCODE_OBJECT_H_
 
+#include <stdint.h>
+
 #include <iosfwd>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Helper classes to generate Xcode project files.
@@ -65,6 +68,27 @@ class XCConfigurationList;
 
 using PBXAttributes = std::map<std::string, std::string>;
 
+// PBXObjectIdGenerator -------------------------------------------------------
+
+// Generates the 96-bit identifiers of PBXObjects, formatted as 24 hexadecimal
+// characters. The identifier only depends on the seed (the project name), the
+// object name and the object position in the graph so that generation of the
+// project is deterministic. This uses a non-cryptographic hash since the ids
+// only need to be stable and unlikely to collide.
+class PBXObjectIdGenerator {
+ public:
+  explicit PBXObjectIdGenerator(std::string_view seed);
+
+  std::string Generate(std::string_view name, uint64_t counter) const;
+
+ private:
+  // Hash state after consuming the seed, one per 64-bit lane.
+  uint64_t seed_state_[2];
+};
+
+// Assigns identifiers to |project| and all objects reachable from it.
+void AssignPBXObjectIds(PBXProject* project);
+
 // PBXObjectVisitor -----------------------------------------------------------
 
 class PBXObjectVisitor {
@@ -103,6 +127,10 @@ class PBXObject {
 
   std::string Reference() const;
 
+  // Writes the same as Reference() to |out| without building a temporary
+  // string.
+  void WriteReference(std::ostream& out) const;
+
   virtual PBXObjectClass Class() const = 0;
   virtual std::string Name() const = 0;
   virtual std::string Comment() const;
@@ -4,6 +4,8 @@
 
 #include "gn/xcode_object.h"
 
+#include <set>
+
 #include "util/test/test.h"
 
 namespace {
@@ -433,3 +435,50 @@ TEST(XcodeObject, XCConfigurationListName) {
   EXPECT_EQ("Build configuration list for PBXNativeTarget \"target_name\"",
             xc_configuration_list->Name());
 }
+
+// Tests that object ids are stable and depend on all their inputs.
+TEST(XcodeObject, PBXObjectIdGenerator) {
+  PBXObjectIdGenerator generator("project");
+  const std::string id = generator.Generate("target_name", 3);
+  EXPECT_EQ(24u, id.size());
+  EXPECT_EQ(std::string::npos, id.find_first_not_of("0123456789ABCDEF"));
+
+  EXPECT_EQ(id, PBXObjectIdGenerator("project").Generate("target_name", 3));
+  EXPECT_NE(id, generator.Generate("target_name", 4));
+  EXPECT_NE(id, generator.Generate("other_name", 3));
+  EXPECT_NE(id, PBXObjectIdGenerator("other").Generate("target_name", 3));
+}
+
+// Tests that all objects of a project get distinct, reproducible ids.
+TEST(XcodeObject, AssignPBXObjectIds) {
+  auto make_project = []() {
+    std::unique_ptr<PBXProject> project = GetPBXProjectObject();
+    project->AddAggregateTarget("All", ".", "ninja -C .");
+    project->AddNativeTarget("target", "compiled.mach-o.executable", "target",
+                             "com.apple.product-type.tool", ".",
+                             "ninja -C . target");
+    project->AddSourceFileToIndexingTarget("foo/bar.cc", "../../foo/bar.cc");
+    project->AddSourceFileToIndexingTarget("foo/bar.h", "../../foo/bar.h");
+    AssignPBXObjectIds(project.get());
+    return project;
+  };
+
+  class CollectIds : public PBXObjectVisitorConst {
+   public:
+    void Visit(const PBXObject* object) override {
+      ids.push_back(object->id());
+    }
+    std::vector<std::string> ids;
+  };
+
+  std::unique_ptr<PBXProject> project = make_project();
+  CollectIds first;
+  project->Visit(first);
+  std::set<std::string> unique_ids(first.ids.begin(), first.ids.end());
+  EXPECT_GT(first.ids.size(), 10u);
+  EXPECT_EQ(first.ids.size(), unique_ids.size());
+
+  CollectIds second;
+  make_project()->Visit(second);
+  EXPECT_EQ(first.ids, second.ids);
+}
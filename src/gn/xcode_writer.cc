@@ -9,7 +9,6 @@
 #include <map>
 #include <memory>
 #include <optional>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -17,7 +16,6 @@
 #include "base/environment.h"
 #include "base/files/file_enumerator.h"
 #include "base/logging.h"
-#include "base/sha1.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
@@ -81,50 +79,56 @@ TargetOsType GetTargetOs(const Args& args) {
   return WRITER_TARGET_OS_MACOS;
 }
 
-std::string GetBuildScript(const std::string& target_name,
-                           const std::string& ninja_executable,
-                           const std::string& build_dir,
-                           base::Environment* environment) {
-  // Launch ninja with a sanitized environment (Xcode sets many environment
-  // variables overridding settings, including the SDK, thus breaking hermetic
-  // build).
-  std::stringstream buffer;
-  buffer << "exec env -i ";
+// Returns the command prefix used by all build scripts to launch ninja with
+// a sanitized environment (Xcode sets many environment variables overridding
+// settings, including the SDK, thus breaking hermetic build). It only depends
+// on the environment so it is computed once per project.
+std::string GetBuildScriptEnvironment(base::Environment* environment) {
+  std::string buffer = "exec env -i ";
 
   // Write environment.
   for (const auto& variable : kSafeEnvironmentVariables) {
-    buffer << variable.name << "=";
+    buffer.append(variable.name);
+    buffer.push_back('=');
     if (variable.capture_at_generation) {
       std::string value;
       environment->GetVar(variable.name, &value);
-      buffer << "'" << value << "'";
+      buffer.append("'" + value + "'");
     } else {
-      buffer << "\"${" << variable.name << "}\"";
+      buffer.append("\"${" + std::string(variable.name) + "}\"");
     }
-    buffer << " ";
+    buffer.push_back(' ');
   }
+  return buffer;
+}
 
+std::string GetBuildScript(const std::string& target_name,
+                           const std::string& ninja_executable,
+                           const std::string& build_dir,
+                           const std::string& script_environment) {
+  std::string buffer = script_environment;
   if (ninja_executable.empty()) {
-    buffer << "ninja";
+    buffer.append("ninja");
   } else {
-    buffer << ninja_executable;
+    buffer.append(ninja_executable);
   }
 
-  buffer << " -C " << build_dir;
+  buffer.append(" -C " + build_dir);
 
   if (!target_name.empty()) {
-    buffer << " '" << target_name << "'";
+    buffer.append(" '" + target_name + "'");
   }
-  return buffer.str();
+  return buffer;
 }
 
 std::string GetBuildScript(const Label& target_label,
                            const std::string& ninja_executable,
                            const std::string& build_dir,
-                           base::Environment* environment) {
+                           const std::string& script_environment) {
   std::string target_name = target_label.GetUserVisibleName(false);
   base::TrimString(target_name, "/", &target_name);
-  return GetBuildScript(target_name, ninja_executable, build_dir, environment);
+  return GetBuildScript(target_name, ninja_executable, build_dir,
+                        script_environment);
 }
 
 bool IsApplicationTarget(const Target* target) {
@@ -341,41 +345,6 @@ CollectPBXObjectsPerClass(const PBXProject* project) {
   return visitor.objects_per_class();
 }
 
-// Helper class to assign unique ids to all PBXObject.
-class RecursivelyAssignIdsHelper : public PBXObjectVisitor {
- public:
-  RecursivelyAssignIdsHelper(const std::string& seed)
-      : seed_(seed), counter_(0) {}
-
-  void Visit(PBXObject* object) override {
-    std::stringstream buffer;
-    buffer << seed_ << " " << object->Name() << " " << counter_;
-    std::string hash = base::SHA1HashString(buffer.str());
-    DCHECK_EQ(hash.size() % 4, 0u);
-
-    uint32_t id[3] = {0, 0, 0};
-    const uint32_t* ptr = reinterpret_cast<const uint32_t*>(hash.data());
-    for (size_t i = 0; i < hash.size() / 4; i++)
-      id[i % 3] ^= ptr[i];
-
-    object->SetId(base::HexEncode(id, sizeof(id)));
-    ++counter_;
-  }
-
- private:
-  std::string seed_;
-  int64_t counter_;
-
-  RecursivelyAssignIdsHelper(const RecursivelyAssignIdsHelper&) = delete;
-  RecursivelyAssignIdsHelper& operator=(const RecursivelyAssignIdsHelper&) =
-      delete;
-};
-
-void RecursivelyAssignIds(PBXProject* project) {
-  RecursivelyAssignIdsHelper visitor(project->Name());
-  project->Visit(visitor);
-}
-
 // Returns a list of configuration names from the options passed to the
 // generator. If no configuration names have been passed, return default
 // value.
@@ -634,12 +603,12 @@ class XcodeProject {
 
   // Adds a target of type EXECUTABLE to the project.
   PBXNativeTarget* AddBinaryTarget(const Target* target,
-                                   base::Environment* env,
+                                   const std::string& script_environment,
                                    Err* err);
 
   // Adds a target of type CREATE_BUNDLE to the project.
   PBXNativeTarget* AddBundleTarget(const Target* target,
-                                   base::Environment* env,
+                                   const std::string& script_environment,
                                    Err* err);
 
   // Adds the XCTest source files for all test xctest or xcuitest module target
@@ -657,7 +626,7 @@ class XcodeProject {
 
   // Tweak `output_dir` to be relative to the configuration specific output
   // directory (see --xcode-config-build-dir=... flag).
-  std::string GetConfigOutputDir(std::string_view output_dir);
+  std::string GetConfigOutputDir(std::string_view output_dir) const;
 
   // Generates the content of the .xcodeproj file into |out|.
   void WriteFileContent(std::ostream& out) const;
@@ -770,11 +739,12 @@ bool XcodeProject::AddSourcesFromBuilder(const Builder& builder, Err* err) {
 
 bool XcodeProject::AddTargetsFromBuilder(const Builder& builder, Err* err) {
   std::unique_ptr<base::Environment> env(base::Environment::Create());
+  const std::string script_environment = GetBuildScriptEnvironment(env.get());
 
   project_.AddAggregateTarget(
       "All", GetConfigOutputDir("."),
       GetBuildScript(options_.root_target_name, options_.ninja_executable,
-                     GetConfigOutputDir("."), env.get()));
+                     GetConfigOutputDir("."), script_environment));
 
   const std::optional<std::vector<const Target*>> targets =
       GetTargetsFromBuilder(builder, err);
@@ -792,7 +762,7 @@ bool XcodeProject::AddTargetsFromBuilder(const Builder& builder, Err* err) {
         if (target_os == WRITER_TARGET_OS_IOS)
           continue;
 
-        native_target = AddBinaryTarget(target, env.get(), err);
+        native_target = AddBinaryTarget(target, script_environment, err);
         if (!native_target)
           return false;
 
@@ -808,7 +778,7 @@ bool XcodeProject::AddTargetsFromBuilder(const Builder& builder, Err* err) {
         if (IsXCUITestRunnerTarget(target))
           continue;
 
-        native_target = AddBundleTarget(target, env.get(), err);
+        native_target = AddBundleTarget(target, script_environment, err);
         if (!native_target)
           return false;
 
@@ -904,7 +874,7 @@ bool XcodeProject::AddDependencyTargetsForTestModuleTargets(
 }
 
 bool XcodeProject::AssignIds(Err* err) {
-  RecursivelyAssignIds(&project_);
+  AssignPBXObjectIds(&project_);
   return true;
 }
 
@@ -980,9 +950,10 @@ std::optional<std::vector<const Target*>> XcodeProject::GetTargetsFromBuilder(
   return sorted_targets;
 }
 
-PBXNativeTarget* XcodeProject::AddBinaryTarget(const Target* target,
-                                               base::Environment* env,
-                                               Err* err) {
+PBXNativeTarget* XcodeProject::AddBinaryTarget(
+    const Target* target,
+    const std::string& script_environment,
+    Err* err) {
   DCHECK_EQ(target->output_type(), Target::EXECUTABLE);
 
   std::string output_dir = target->output_dir().value();
@@ -1011,12 +982,13 @@ PBXNativeTarget* XcodeProject::AddBinaryTarget(const Target* target,
                                     : target->output_name(),
       "com.apple.product-type.tool", GetConfigOutputDir(output_dir),
       GetBuildScript(target->label(), options_.ninja_executable,
-                     GetConfigOutputDir("."), env));
+                     GetConfigOutputDir("."), script_environment));
 }
 
-PBXNativeTarget* XcodeProject::AddBundleTarget(const Target* target,
-                                               base::Environment* env,
-                                               Err* err) {
+PBXNativeTarget* XcodeProject::AddBundleTarget(
+    const Target* target,
+    const std::string& script_environment,
+    Err* err) {
   DCHECK_EQ(target->output_type(), Target::CREATE_BUNDLE);
 
   std::string pbxtarget_name = target->label().name();
@@ -1044,11 +1016,12 @@ PBXNativeTarget* XcodeProject::AddBundleTarget(const Target* target,
       pbxtarget_name, std::string(), target_output_name,
       target->bundle_data().product_type(), GetConfigOutputDir(output_dir),
       GetBuildScript(target->label(), options_.ninja_executable,
-                     GetConfigOutputDir("."), env),
+                     GetConfigOutputDir("."), script_environment),
       xcode_extra_attributes);
 }
 
-std::string XcodeProject::GetConfigOutputDir(std::string_view output_dir) {
+std::string XcodeProject::GetConfigOutputDir(
+    std::string_view output_dir) const {
   if (options_.configuration_build_dir.empty())
     return std::string(output_dir);
 
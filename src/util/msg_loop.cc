@@ -4,6 +4,8 @@
 
 #include "util/msg_loop.h"
 
+#include <memory>
+
 #include "base/logging.h"
 
 namespace {
@@ -25,26 +27,24 @@ MsgLoop::MsgLoop() {
 MsgLoop::~MsgLoop() {
   DCHECK(g_current == this);
   g_current = nullptr;
+
+  // Delete the tasks left when Run() quit.
+  TakePostedTasks(false);
+  while (pending_) {
+    Task* next = pending_->next;
+    delete pending_;
+    pending_ = next;
+  }
 }
 
 void MsgLoop::Run() {
+  ElapsedTimer timer;
   while (!should_quit_) {
-    std::function<void()> task;
-    {
-      std::unique_lock<std::mutex> queue_lock(queue_mutex_);
-      notifier_.wait(queue_lock, [this]() {
-        return (!task_queue_.empty()) || should_quit_;
-      });
-
-      if (should_quit_)
-        return;
-
-      task = std::move(task_queue_.front());
-      task_queue_.pop();
-    }
-
-    task();
+    if (!pending_)
+      TakePostedTasks(true);
+    RunFirstPendingTask();
   }
+  stats_.run_time = TickDelta(stats_.run_time.raw() + timer.Elapsed().raw());
 }
 
 void MsgLoop::PostQuit() {
@@ -52,28 +52,73 @@ void MsgLoop::PostQuit() {
 }
 
 void MsgLoop::PostTask(std::function<void()> work) {
-  {
-    std::unique_lock<std::mutex> queue_lock(queue_mutex_);
-    task_queue_.emplace(std::move(work));
+  Task* task = new Task{std::move(work), nullptr};
+  Task* old_head = posted_.load(std::memory_order_relaxed);
+  do {
+    task->next = old_head;
+  } while (!posted_.compare_exchange_weak(old_head, task,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+
+  // The loop only sleeps once it finds no posted tasks, so only the task
+  // ending that needs to wake it. Taking the lock makes sure the loop is
+  // either still about to check or already waiting.
+  if (!old_head) {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    notifier_.notify_one();
   }
-
-  notifier_.notify_one();
 }
 
 void MsgLoop::RunUntilIdleForTesting() {
   for (bool done = false; !done;) {
-    std::function<void()> task;
-    {
-      std::unique_lock<std::mutex> queue_lock(queue_mutex_);
-      task = std::move(task_queue_.front());
-      task_queue_.pop();
+    if (!pending_)
+      TakePostedTasks(false);
+    done = !pending_->next && !posted_.load(std::memory_order_acquire);
+    RunFirstPendingTask();
+  }
+}
 
-      if (task_queue_.empty())
-        done = true;
-    }
+MsgLoop::Stats MsgLoop::GetStats() const {
+  return stats_;
+}
 
-    task();
+void MsgLoop::TakePostedTasks(bool wait) {
+  Task* posted = posted_.exchange(nullptr, std::memory_order_acquire);
+  if (!posted && wait) {
+    ElapsedTimer timer;
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    notifier_.wait(lock, [this]() {
+      return posted_.load(std::memory_order_acquire) != nullptr;
+    });
+    posted = posted_.exchange(nullptr, std::memory_order_acquire);
+    stats_.idle_time =
+        TickDelta(stats_.idle_time.raw() + timer.Elapsed().raw());
   }
+  if (!posted)
+    return;
+  stats_.batches++;
+
+  // Reverse into posting order and append to the pending tasks.
+  Task* first = nullptr;
+  Task* last = posted;
+  while (posted) {
+    Task* next = posted->next;
+    posted->next = first;
+    first = posted;
+    posted = next;
+  }
+  if (pending_)
+    pending_last_->next = first;
+  else
+    pending_ = first;
+  pending_last_ = last;
+}
+
+void MsgLoop::RunFirstPendingTask() {
+  std::unique_ptr<Task> task(pending_);
+  pending_ = task->next;
+  stats_.tasks++;
+  task->work();
 }
 
 MsgLoop* MsgLoop::Current() {
@@ -5,13 +5,25 @@
 #ifndef UTIL_RUN_LOOP_H_
 #define UTIL_RUN_LOOP_H_
 
+#include <stdint.h>
+
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
-#include <queue>
+
+#include "util/ticks.h"
 
 class MsgLoop {
  public:
+  // How busy the thread running the loop was, see GetStats().
+  struct Stats {
+    uint64_t tasks = 0;      // Number of tasks run.
+    uint64_t batches = 0;    // Number of times posted tasks were taken.
+    TickDelta run_time{0};   // Time spent in Run().
+    TickDelta idle_time{0};  // Time Run() spent waiting for tasks.
+  };
+
   MsgLoop();
   ~MsgLoop();
 
@@ -24,21 +36,52 @@ class MsgLoop {
 
   // Posts a work item to this queue. All items will be run on the thread from
   // which Run() was called. Can be called from any thread.
+  //
+  // This doesn't lock unless the queue was empty, in which case the thread
+  // running the loop may need to be woken up.
   void PostTask(std::function<void()> task);
 
   // Run()s until the queue is empty. Should only be used (carefully) in tests.
   void RunUntilIdleForTesting();
 
+  // Returns the statistics of all calls to Run() so far. Must be called on the
+  // thread running the loop.
+  Stats GetStats() const;
+
   // Gets the MsgLoop for the thread from which it's called, or nullptr if
   // there's no MsgLoop for the current thread.
   static MsgLoop* Current();
 
  private:
-  std::mutex queue_mutex_;
-  std::queue<std::function<void()>> task_queue_;
+  struct Task {
+    std::function<void()> work;
+    Task* next;
+  };
+
+  // Moves the posted tasks to the end of |pending_|. If there are none and
+  // |wait| is set, blocks until one is posted.
+  void TakePostedTasks(bool wait);
+
+  // Removes the first task of |pending_|, which must not be empty, and runs it.
+  void RunFirstPendingTask();
+
+  // Tasks posted since the last TakePostedTasks(), most recent first. Pushed
+  // to by any thread and only emptied by the thread running the loop.
+  std::atomic<Task*> posted_{nullptr};
+
+  // Tasks taken from |posted_| but not run yet, in the order they were posted.
+  // Only used by the thread running the loop.
+  Task* pending_ = nullptr;
+  Task* pending_last_ = nullptr;
+
+  // Used to sleep while there are no tasks.
+  std::mutex wait_mutex_;
   std::condition_variable notifier_;
+
   bool should_quit_ = false;
 
+  Stats stats_;
+
   MsgLoop(const MsgLoop&) = delete;
   MsgLoop& operator=(const MsgLoop&) = delete;
 };
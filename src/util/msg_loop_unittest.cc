@@ -0,0 +1,72 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "util/msg_loop.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "util/test/test.h"
+
+TEST(MsgLoop, RunsTasksInPostingOrderPerThread) {
+  constexpr int kThreads = 4;
+  constexpr int kTasksPerThread = 1000;
+
+  MsgLoop loop;
+  std::vector<std::pair<int, int>> ran;  // Only used on this thread.
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&loop, &ran, t]() {
+      for (int i = 0; i < kTasksPerThread; i++)
+        loop.PostTask([&ran, t, i]() { ran.emplace_back(t, i); });
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  loop.PostQuit();
+  loop.Run();
+
+  ASSERT_EQ(static_cast<size_t>(kThreads * kTasksPerThread), ran.size());
+  std::vector<int> next(kThreads);
+  for (const auto& [t, i] : ran) {
+    EXPECT_EQ(next[t], i);
+    next[t] = i + 1;
+  }
+
+  MsgLoop::Stats stats = loop.GetStats();
+  EXPECT_EQ(static_cast<uint64_t>(kThreads * kTasksPerThread + 1), stats.tasks);
+  EXPECT_LE(1u, stats.batches);
+}
+
+TEST(MsgLoop, WakesUpForTasksPostedWhileWaiting) {
+  MsgLoop loop;
+  bool ran = false;
+
+  // The loop is likely waiting by the time these are posted.
+  std::thread thread([&loop, &ran]() {
+    loop.PostTask([&ran]() { ran = true; });
+    loop.PostQuit();
+  });
+  loop.Run();
+  thread.join();
+
+  EXPECT_TRUE(ran);
+}
+
+TEST(MsgLoop, QuitLeavesLaterTasks) {
+  MsgLoop loop;
+  int ran = 0;
+
+  loop.PostTask([&ran]() { ran++; });
+  loop.PostQuit();
+  loop.PostTask([&ran]() { ran++; });
+  loop.Run();
+  EXPECT_EQ(1, ran);
+
+  // The task after the quit is still there.
+  loop.RunUntilIdleForTesting();
+  EXPECT_EQ(2, ran);
+}
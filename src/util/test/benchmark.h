@@ -0,0 +1,100 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UTIL_TEST_BENCHMARK_H_
+#define UTIL_TEST_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include "util/build_config.h"
+#include "util/ticks.h"
+
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+// This is a minimal microbenchmark framework in the spirit of util/test/test.h.
+// Benchmarks are registered with the BENCHMARK macro and time their loop body
+// with a State:
+//
+//   BENCHMARK(Foo_Lookup) {
+//     Foo foo = MakeFoo();
+//     while (state.KeepRunning())
+//       benchmark::DoNotOptimize(foo.Lookup("bar"));
+//     state.SetItemsProcessed(state.iterations());
+//   }
+//
+// The loop is run in growing batches until it has taken at least the minimum
+// time (see --min_time_ms in gn_benchmark.cc), and the average time per
+// iteration is reported.
+namespace benchmark {
+
+class State {
+ public:
+  explicit State(uint64_t min_time_ns) : min_time_ns_(min_time_ns) {}
+
+  // Returns true while the benchmark loop should run another iteration.
+  bool KeepRunning() {
+    if (batch_remaining_ > 0) {
+      batch_remaining_--;
+      return true;
+    }
+    return NextBatch();
+  }
+
+  // Excludes the time between the calls from the measurement, e.g. to reset
+  // state between iterations.
+  void PauseTiming();
+  void ResumeTiming();
+
+  // Optional count of items (strings matched, entries inserted, ...) processed
+  // by the whole run, used to report a throughput.
+  void SetItemsProcessed(uint64_t items) { items_processed_ = items; }
+
+  uint64_t iterations() const { return iterations_; }
+  uint64_t items_processed() const { return items_processed_; }
+  uint64_t elapsed_ns() const { return elapsed_ns_; }
+
+ private:
+  bool NextBatch();
+
+  const uint64_t min_time_ns_;
+
+  uint64_t iterations_ = 0;
+  uint64_t batch_remaining_ = 0;
+  uint64_t batch_size_ = 0;
+  uint64_t items_processed_ = 0;
+
+  // Time accumulated by finished batches and paused sections.
+  uint64_t elapsed_ns_ = 0;
+  Ticks batch_start_ = 0;
+  bool started_ = false;
+};
+
+// Prevents the compiler from optimizing away the computation of |value|.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(COMPILER_MSVC)
+  _ReadWriteBarrier();
+  (void)value;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+}  // namespace benchmark
+
+void RegisterBenchmark(void (*)(benchmark::State&), const char*);
+
+#define BENCHMARK(name)                                  \
+  static void Benchmark_##name(benchmark::State& state); \
+  struct RegisterBenchmark_##name {                      \
+    RegisterBenchmark_##name() {                         \
+      RegisterBenchmark(Benchmark_##name, #name);        \
+    }                                                    \
+  };                                                     \
+  RegisterBenchmark_##name g_register_benchmark_##name;  \
+  static void Benchmark_##name(benchmark::State& state)
+
+#endif  // UTIL_TEST_BENCHMARK_H_
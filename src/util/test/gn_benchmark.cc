@@ -0,0 +1,113 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base/command_line.h"
+#include "util/test/benchmark.h"
+
+namespace benchmark {
+
+void State::PauseTiming() {
+  elapsed_ns_ += TicksDelta(TicksNow(), batch_start_).InNanoseconds();
+}
+
+void State::ResumeTiming() {
+  batch_start_ = TicksNow();
+}
+
+bool State::NextBatch() {
+  if (!started_) {
+    started_ = true;
+    batch_size_ = 1;
+  } else {
+    elapsed_ns_ += TicksDelta(TicksNow(), batch_start_).InNanoseconds();
+    iterations_ += batch_size_;
+    if (elapsed_ns_ >= min_time_ns_)
+      return false;
+
+    // Grow the batch so the clock is read rarely compared to the loop body,
+    // aiming to finish in one more batch once there is an estimate.
+    uint64_t per_iteration = elapsed_ns_ / iterations_ + 1;
+    uint64_t wanted = (min_time_ns_ - elapsed_ns_) / per_iteration + 1;
+    batch_size_ = wanted < iterations_ * 10 ? wanted : iterations_ * 10;
+  }
+  batch_remaining_ = batch_size_ - 1;
+  batch_start_ = TicksNow();
+  return true;
+}
+
+}  // namespace benchmark
+
+struct RegisteredBenchmark {
+  void (*function)(benchmark::State&);
+  const char* name;
+};
+
+// Fixed-size for the same reason as the test registry in gn_test.cc: the
+// registrations run from static initializers.
+static RegisteredBenchmark benchmarks[1000];
+static int nbenchmarks;
+
+void RegisterBenchmark(void (*function)(benchmark::State&), const char* name) {
+  benchmarks[nbenchmarks].function = function;
+  benchmarks[nbenchmarks++].name = name;
+}
+
+namespace {
+
+// Matches |str| against a pattern where '*' matches any run of characters.
+bool FilterMatches(const char* pattern, const char* str) {
+  switch (*pattern) {
+    case '\0':
+      return *str == '\0';
+    case '*':
+      return (*str != '\0' && FilterMatches(pattern, str + 1)) ||
+             FilterMatches(pattern + 1, str);
+    default:
+      return *pattern == *str && FilterMatches(pattern + 1, str + 1);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine* cmdline = base::CommandLine::ForCurrentProcess();
+
+  std::string filter = "*";
+  if (cmdline->HasSwitch("filter"))
+    filter = cmdline->GetSwitchValueString("filter");
+
+  uint64_t min_time_ms = 500;
+  if (cmdline->HasSwitch("min_time_ms"))
+    min_time_ms = atoi(cmdline->GetSwitchValueString("min_time_ms").c_str());
+
+  setvbuf(stdout, NULL, _IOLBF, BUFSIZ);
+  printf("%-50s %12s %14s %16s\n", "Benchmark", "Iterations", "ns/iter",
+         "items/s");
+
+  for (int i = 0; i < nbenchmarks; i++) {
+    if (!FilterMatches(filter.c_str(), benchmarks[i].name))
+      continue;
+
+    benchmark::State state(min_time_ms * 1000000);
+    benchmarks[i].function(state);
+
+    double ns_per_iteration =
+        state.iterations() ? static_cast<double>(state.elapsed_ns()) /
+                                 state.iterations()
+                           : 0.0;
+    printf("%-50s %12llu %14.1f", benchmarks[i].name,
+           static_cast<unsigned long long>(state.iterations()),
+           ns_per_iteration);
+    if (state.items_processed() && state.elapsed_ns()) {
+      printf(" %16.0f", state.items_processed() * 1e9 / state.elapsed_ns());
+    }
+    printf("\n");
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,29 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UTIL_THREAD_LOCAL_POINTER_H_
+#define UTIL_THREAD_LOCAL_POINTER_H_
+
+#include "util/build_config.h"
+
+// Returns a reference to the calling thread's pointer to a T, which starts
+// out null. There is one such pointer per thread for each type, so T should be
+// private to the caller, typically a type in an anonymous namespace.
+//
+// This is typically used for per-thread caches in front of a global table
+// that is protected by a mutex. Whatever the pointer points to isn't freed
+// when the thread exits.
+template <typename T>
+T*& ThreadLocalPointer() {
+#if !defined(OS_ZOS)
+  thread_local T* pointer = nullptr;
+  return pointer;
+#else
+  // TODO(gabylb) - zos: thread_local not yet supported, use zoslib's impl'n:
+  static __tlssim<T*> pointer(nullptr);
+  return *pointer.access();
+#endif
+}
+
+#endif  // UTIL_THREAD_LOCAL_POINTER_H_
@@ -4,6 +4,8 @@
 
 #include "util/worker_pool.h"
 
+#include <algorithm>
+
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
 #include "gn/switches.h"
@@ -64,11 +66,12 @@ WorkerPool::~WorkerPool() {
   }
 }
 
-void WorkerPool::PostTask(std::function<void()> work) {
+void WorkerPool::PostTask(std::function<void()> work, int64_t priority) {
   {
     std::unique_lock<std::mutex> queue_lock(queue_mutex_);
     CHECK(!should_stop_processing_);
-    task_queue_.emplace(std::move(work));
+    task_queue_.push_back({priority, next_sequence_++, std::move(work)});
+    std::push_heap(task_queue_.begin(), task_queue_.end(), RunsAfter);
   }
 
   pool_notifier_.notify_one();
@@ -88,8 +91,9 @@ void WorkerPool::Worker() {
       if (should_stop_processing_ && task_queue_.empty())
         return;
 
-      task = std::move(task_queue_.front());
-      task_queue_.pop();
+      std::pop_heap(task_queue_.begin(), task_queue_.end(), RunsAfter);
+      task = std::move(task_queue_.back().work);
+      task_queue_.pop_back();
     }
 
     task();
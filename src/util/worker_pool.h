@@ -5,11 +5,13 @@
 #ifndef UTIL_WORKER_POOL_H_
 #define UTIL_WORKER_POOL_H_
 
+#include <stdint.h>
+
 #include <condition_variable>
 #include <functional>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 #include "base/logging.h"
 
@@ -19,13 +21,29 @@ class WorkerPool {
   WorkerPool(size_t thread_count);
   ~WorkerPool();
 
-  void PostTask(std::function<void()> work);
+  // Runs |work| on one of the threads. Pending tasks with a higher |priority|
+  // are run first, and tasks of equal priority in the order they were posted.
+  void PostTask(std::function<void()> work, int64_t priority = 0);
 
  private:
+  struct Task {
+    int64_t priority;
+    uint64_t sequence;
+    std::function<void()> work;
+  };
+
+  // Heap order putting the next task to run at the front.
+  static bool RunsAfter(const Task& a, const Task& b) {
+    if (a.priority != b.priority)
+      return a.priority < b.priority;
+    return a.sequence > b.sequence;
+  }
+
   void Worker();
 
   std::vector<std::thread> threads_;
-  std::queue<std::function<void()>> task_queue_;
+  std::vector<Task> task_queue_;  // Heap ordered by RunsAfter().
+  uint64_t next_sequence_ = 0;
   std::mutex queue_mutex_;
   std::condition_variable_any pool_notifier_;
   bool should_stop_processing_;